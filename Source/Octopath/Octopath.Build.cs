@@ -8,6 +8,8 @@ public class Octopath : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput","UMG", "CommonUI", "Slate", "SlateCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput","UMG", "CommonUI", "Slate", "SlateCore", "DeveloperSettings" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Niagara" });
 	}
 }
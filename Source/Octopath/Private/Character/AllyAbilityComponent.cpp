@@ -1,6 +1,8 @@
 #include "Character/AllyAbilityComponent.h"
 #include "Manager/StatComponent.h"
 #include "Manager/SkillData.h"
+#include "Combat/CombatRandomSubsystem.h"
+#include "Combat/CombatBalance.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
 
@@ -28,6 +30,13 @@ float UAllyAbilityComponent::ExecuteDefaultAttack()
 
 float UAllyAbilityComponent::ExecuteSkill(USkillData* Skill, const TArray<AActor*>& Targets)
 {
+    TArray<FSkillHitResult> Results;
+    return ExecuteSkillWithResults(Skill, Targets, Results);
+}
+
+float UAllyAbilityComponent::ExecuteSkillWithResults(USkillData* Skill, const TArray<AActor*>& Targets, TArray<FSkillHitResult>& OutResults)
+{
+    OutResults.Reset();
     if (!Skill)
     {
         UE_LOG(LogAllyAbilityComponent, Warning, TEXT("Skill is null"));
@@ -48,119 +57,35 @@ float UAllyAbilityComponent::ExecuteSkill(USkillData* Skill, const TArray<AActor
         return 0.f;
     }
 
-    // Check if the caster has enough Technique Points to use the skill.
-    if (StatComp->TechniquePoints < Skill->TechniqueCost)
-    {
-        UE_LOG(LogAllyAbilityComponent, Warning, TEXT("Not enough Technique Points to use %s"), *Skill->SkillName.ToString());
-        return 0.f;
-    }
-
-    // Deduct the TechniquePoints cost.
-    StatComp->UseTechniquePoints(Skill->TechniqueCost);
-
-    float TotalEffect = 0.f;
-
-    if (Skill->AbilityCategory == EAbilityCategory::Offensive)
-    {
-        // Offensive abilities: apply damage calculation to each target.
-        for (AActor* Target : Targets)
-        {
-            if (!IsValid(Target))
-            {
-                continue;
-            }
-            UStatComponent* TargetStat = Target->FindComponentByClass<UStatComponent>();
-            if (!TargetStat)
-            {
-                continue;
-            }
-
-            float AttackValue = 0.f;
-            float DefenceValue = 0.f;
-            if (Skill->AttackType == EAttackType::Physical)
-            {
-                // Attack value = base skill damage + caster's physical attack.
-                AttackValue = Skill->Damage + StatComp->PhysicalAttack;
-                // Defence value = target's physical defense.
-                DefenceValue = TargetStat->PhysicalDefense;
-            }
-            else // Magical attack
-            {
-                // Attack value = base skill damage + caster's magical attack.
-                AttackValue = Skill->Damage + StatComp->MagicalAttack;
-                // Defence value = target's magical defense.
-                DefenceValue = TargetStat->MagicalDefense;
-            }
-
-            // Generate a random multiplier using modifiable min and max values.
-            float RandomMultiplier = FMath::FRandRange(RandomMultiplierMin, RandomMultiplierMax);
-            // Calculate damage using the formula:
-            // Damage = (AttackValue - (DefenceValue * DamageDefenceRatio / DamageDefenceDivisor)) * RandomMultiplier.
-            float DamageDealt = (AttackValue - (DefenceValue * DamageDefenceRatio / DamageDefenceDivisor)) * RandomMultiplier;
-            DamageDealt = FMath::Max(DamageDealt, 1.f); // Ensure at least 1 damage is dealt.
-
-            UE_LOG(LogAllyAbilityComponent, Log, TEXT("Damage Calculation Formula: (%.2f - (%.2f * %.2f / %.2f)) * %.2f = %.2f"),
-                AttackValue, DefenceValue, DamageDefenceRatio, DamageDefenceDivisor, RandomMultiplier, DamageDealt);
-
-            // Apply damage to the target. The second parameter indicates if damage is magical.
-            TargetStat->ApplyDamage(DamageDealt, (Skill->AttackType == EAttackType::Magical));
-            UE_LOG(LogAllyAbilityComponent, Log, TEXT("Applied %f damage to target %s"), DamageDealt, *Target->GetName());
-            TotalEffect += DamageDealt;
-        }
-    }
-    else if (Skill->AbilityCategory == EAbilityCategory::Heal)
-    {
-        // Heal abilities: treat the damage value as the amount to heal.
-        for (AActor* Target : Targets)
-        {
-            if (!IsValid(Target))
-            {
-                continue;
-            }
-            float HealAmount = Skill->Damage;
-            UStatComponent* TargetStat = Target->FindComponentByClass<UStatComponent>();
-            if (TargetStat)
-            {
-                TargetStat->Heal(HealAmount);
-                UE_LOG(LogAllyAbilityComponent, Log, TEXT("Healed target %s for %f"), *Target->GetName(), HealAmount);
-                // Convention: negative result represents healing.
-                TotalEffect -= HealAmount;
-            }
-        }
-    }
-    else if (Skill->AbilityCategory == EAbilityCategory::Buff || Skill->AbilityCategory == EAbilityCategory::Debuff)
+    // Gather the stats of the valid targets.
+    TArray<UStatComponent*, TInlineAllocator<8>> TargetStats;
+    for (AActor* Target : Targets)
     {
-        // If the target type is Self, apply the modifier to the caster's StatComponent.
-        if (Skill->TargetType == ETargetType::Self)
+        if (!IsValid(Target))
         {
-            StatComp->ApplyStatModifier(Skill->AffectedStat, Skill->ModifierValue, Skill->ModifierType, Skill->Duration);
-            UE_LOG(LogAllyAbilityComponent, Log, TEXT("Applied modifier %f to caster's stat"), Skill->ModifierValue);
-            TotalEffect = Skill->ModifierValue;
+            continue;
         }
-        else
+        if (UStatComponent* TargetStat = Target->FindComponentByClass<UStatComponent>())
         {
-            // For skills targeting other entities (Enemy or Ally), iterate over each target.
-            for (AActor* Target : Targets)
-            {
-                if (!IsValid(Target))
-                {
-                    continue;
-                }
-                UStatComponent* TargetStat = Target->FindComponentByClass<UStatComponent>();
-                if (TargetStat)
-                {
-                    TargetStat->ApplyStatModifier(Skill->AffectedStat, Skill->ModifierValue, Skill->ModifierType, Skill->Duration);
-                    UE_LOG(LogAllyAbilityComponent, Log, TEXT("Applied modifier %f to target %s"),
-                        Skill->ModifierValue, *Target->GetName());
-                    // Optionally, accumulate the total effect value.
-                    TotalEffect += Skill->ModifierValue;
-                }
-            }
+            TargetStats.Add(TargetStat);
         }
     }
-    else
-    {
-        UE_LOG(LogTemp, Warning, TEXT("Ability category not implemented"));
-    }
+
+    FSkillExecutionContext Context;
+    Context.Caster = StatComp;
+    Context.Targets = TargetStats;
+    // Rolls come from the combat stream so they can be captured in snapshots.
+    Context.Random = UCombatRandomSubsystem::GetStream(this);
+    Context.Tunables = GetDamageTunables();
+    Context.OutResults = &OutResults;
+
+    // The skill was compiled to a flat list of operations when it (or the cooked skill table) was loaded.
+    const float TotalEffect = Skill->GetProgram().Execute(Context);
+    UE_LOG(LogAllyAbilityComponent, Log, TEXT("%s executed with result: %f"), *Skill->SkillName.ToString(), TotalEffect);
     return TotalEffect;
 }
+
+const FDamageTunables& UAllyAbilityComponent::GetDamageTunables() const
+{
+    return FCombatBalance::Get().AllyDamage;
+}
@@ -0,0 +1,113 @@
+#include "Combat/CombatBalance.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ConfigContext.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatBalance, Log, All);
+
+namespace CombatBalance
+{
+	/** Snapshot returned by FCombatBalance::Get; null until the settings are first published */
+	std::atomic<const FCombatBalance*> GCurrent{ nullptr };
+
+	/** Number of published snapshots kept alive, the current one included */
+	constexpr int32 MaxRetainedSnapshots = 8;
+
+	/** Last published snapshots, kept alive for readers still holding an older one (game thread only) */
+	TArray<TUniquePtr<FCombatBalance>> GPublished;
+
+	/** Version of the last published snapshot */
+	uint32 GLastVersion = 0;
+}
+
+FSimpleMulticastDelegate FCombatBalance::OnReloaded;
+
+FDamageTunables FSkillDamageSettings::ApplyTo(const FDamageTunables& Base) const
+{
+	FDamageTunables Tunables = Base;
+	Tunables.SkillDefenceRatio = DefenceRatio;
+	Tunables.SkillDefenceDivisor = DefenceDivisor;
+	Tunables.VarianceMin = VarianceMin;
+	Tunables.VarianceMax = VarianceMax;
+	return Tunables;
+}
+
+const FCombatBalance& FCombatBalance::Get()
+{
+	if (const FCombatBalance* Current = CombatBalance::GCurrent.load(std::memory_order_acquire))
+	{
+		return *Current;
+	}
+	static const FCombatBalance Defaults;
+	return Defaults;
+}
+
+UCombatBalanceSettings::UCombatBalanceSettings()
+{
+	CategoryName = TEXT("Game");
+
+	DefendingDamageReduction = 0.3f;
+	NonBossMaxHealth = 10000.f;
+	MaxStatValue = 1000.f;
+}
+
+void UCombatBalanceSettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// The class default object holds the config values once its properties are initialized.
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		Publish();
+	}
+}
+
+#if WITH_EDITOR
+void UCombatBalanceSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Publish();
+}
+#endif
+
+void UCombatBalanceSettings::ReloadFromDisk()
+{
+	// Rebuild the Game config from the ini hierarchy so edits made outside the editor are seen.
+	FConfigContext::ForceReloadIntoGConfig().Load(TEXT("Game"));
+	ReloadConfig();
+	Publish();
+}
+
+void UCombatBalanceSettings::Publish() const
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FCombatBalance> Balance = MakeUnique<FCombatBalance>();
+	Balance->Version = ++CombatBalance::GLastVersion;
+	Balance->Damage = Damage;
+	Balance->AllyDamage = AllySkills.ApplyTo(Damage);
+	Balance->EnemyDamage = EnemySkills.ApplyTo(Damage);
+	Balance->DefendingDamageReduction = DefendingDamageReduction;
+	Balance->NonBossMaxHealth = NonBossMaxHealth;
+	Balance->MaxStatValue = MaxStatValue;
+
+	const FCombatBalance* Published = Balance.Get();
+	CombatBalance::GPublished.Add(MoveTemp(Balance));
+	CombatBalance::GCurrent.store(Published, std::memory_order_release);
+	if (CombatBalance::GPublished.Num() > CombatBalance::MaxRetainedSnapshots)
+	{
+		CombatBalance::GPublished.RemoveAt(0, CombatBalance::GPublished.Num() - CombatBalance::MaxRetainedSnapshots);
+	}
+
+	UE_LOG(LogCombatBalance, Log, TEXT("Published combat balance version %u"), Published->Version);
+	FCombatBalance::OnReloaded.Broadcast();
+}
+
+static FAutoConsoleCommand GCombatBalanceReloadCommand(
+	TEXT("Octopath.Balance.Reload"),
+	TEXT("Re-reads the combat balance constants from DefaultGame.ini; the next action uses them. Usage: Octopath.Balance.Reload"),
+	FConsoleCommandDelegate::CreateLambda([]()
+		{
+			GetMutableDefault<UCombatBalanceSettings>()->ReloadFromDisk();
+		}));
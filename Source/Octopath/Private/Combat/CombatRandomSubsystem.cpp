@@ -0,0 +1,27 @@
+#include "Combat/CombatRandomSubsystem.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+
+void UCombatRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Stream.GenerateNewSeed();
+}
+
+void UCombatRandomSubsystem::RestoreState(int32 InitialSeed, int32 CurrentSeed)
+{
+	// FRandomStream::Initialize sets both seeds to one value; the current seed is written through the reflected struct.
+	Stream.Initialize(InitialSeed);
+	static const FIntProperty* SeedProperty = FindFProperty<FIntProperty>(TBaseStructure<FRandomStream>::Get(), TEXT("Seed"));
+	if (ensure(SeedProperty))
+	{
+		SeedProperty->SetPropertyValue_InContainer(&Stream, CurrentSeed);
+	}
+}
+
+FRandomStream* UCombatRandomSubsystem::GetStream(const UObject* WorldContextObject)
+{
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UCombatRandomSubsystem* Subsystem = World ? World->GetSubsystem<UCombatRandomSubsystem>() : nullptr;
+	return Subsystem ? &Subsystem->Stream : nullptr;
+}
@@ -0,0 +1,201 @@
+#include "Combat/CombatTargetCache.h"
+#include "Manager/StatComponent.h"
+#include "Character/AllyAbilityComponent.h"
+#include "Enemy/EnemyAbilityComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCombatTargetCache, Log, All);
+
+namespace CombatTargetCache
+{
+	const TArray<USkillData*>* FindSkills(const UActorComponent* AbilityComponent)
+	{
+		if (const UAllyAbilityComponent* AllyAbilities = Cast<UAllyAbilityComponent>(AbilityComponent))
+		{
+			return &AllyAbilities->Skills;
+		}
+		if (const UEnemyAbilityComponent* EnemyAbilities = Cast<UEnemyAbilityComponent>(AbilityComponent))
+		{
+			return &EnemyAbilities->Skills;
+		}
+		return nullptr;
+	}
+}
+
+void FCombatTargetCache::Build(TConstArrayView<AActor*> Combatants, const AActor* PlayerActor)
+{
+	Slots.Reset();
+	AliveMask = 0;
+	FMemory::Memzero(SideMasks);
+	FMemory::Memzero(TargetMasks);
+
+	for (AActor* Actor : Combatants)
+	{
+		if (!IsValid(Actor) || FindSlot(Actor) != INDEX_NONE)
+		{
+			continue;
+		}
+		if (Slots.Num() >= MaxSlots)
+		{
+			UE_LOG(LogCombatTargetCache, Warning, TEXT("Build - More than %d combatants, the rest is not targetable"), MaxSlots);
+			break;
+		}
+
+		// Tags and components are looked up here once per turn instead of on every hover.
+		FSlot& Slot = Slots.AddDefaulted_GetRef();
+		Slot.Actor = Actor;
+		Slot.StatComponent = Actor->FindComponentByClass<UStatComponent>();
+		Slot.Side = (Actor == PlayerActor || Actor->ActorHasTag("Player") || Actor->ActorHasTag("Ally")) ? ESide::Friendly : ESide::Hostile;
+		if (UActorComponent* AllyAbilities = Actor->FindComponentByClass<UAllyAbilityComponent>())
+		{
+			Slot.AbilityComponent = AllyAbilities;
+		}
+		else
+		{
+			Slot.AbilityComponent = Actor->FindComponentByClass<UEnemyAbilityComponent>();
+		}
+
+		const int32 Index = Slots.Num() - 1;
+		const UStatComponent* StatComp = Slot.StatComponent.Get();
+		if (StatComp && StatComp->Health > 0.f)
+		{
+			const FMask Bit = FMask(1) << Index;
+			AliveMask |= Bit;
+			SideMasks[static_cast<int32>(Slot.Side)] |= Bit;
+		}
+		RefreshAffordableSkills(Index);
+	}
+
+	for (int32 Side = 0; Side < NumSides; Side++)
+	{
+		const FMask Friends = SideMasks[Side];
+		const FMask Opponents = SideMasks[1 - Side];
+		for (int32 TargetType = 0; TargetType < NumTargetTypes; TargetType++)
+		{
+			for (int32 Category = 0; Category < NumCategories; Category++)
+			{
+				const ETargetType Type = static_cast<ETargetType>(TargetType);
+				if (TargetsCaster(Type))
+				{
+					continue;
+				}
+				TargetMasks[Side][TargetType][Category] = (Type == ETargetType::Enemy) ? Opponents : Friends;
+			}
+		}
+	}
+
+	bBuilt = true;
+}
+
+void FCombatTargetCache::RefreshAffordableSkills(int32 Slot)
+{
+	if (!Slots.IsValidIndex(Slot))
+	{
+		return;
+	}
+
+	FSlot& Entry = Slots[Slot];
+	Entry.AffordableSkills = 0;
+	const UStatComponent* StatComp = Entry.StatComponent.Get();
+	if (!StatComp)
+	{
+		return;
+	}
+
+	const TConstArrayView<USkillData*> Skills = GetSkills(Slot);
+	const int32 NumSkills = FMath::Min(Skills.Num(), MaxSlots);
+	for (int32 i = 0; i < NumSkills; i++)
+	{
+		if (Skills[i] && StatComp->TechniquePoints >= Skills[i]->TechniqueCost)
+		{
+			Entry.AffordableSkills |= FMask(1) << i;
+		}
+	}
+}
+
+int32 FCombatTargetCache::FindSlot(const AActor* Actor) const
+{
+	if (!Actor)
+	{
+		return INDEX_NONE;
+	}
+	// At most a handful of combatants: a linear scan over weak pointers beats a map here.
+	for (int32 i = 0; i < Slots.Num(); i++)
+	{
+		if (Slots[i].Actor.Get() == Actor)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+AActor* FCombatTargetCache::GetActor(int32 Slot) const
+{
+	return Slots.IsValidIndex(Slot) ? Slots[Slot].Actor.Get() : nullptr;
+}
+
+FCombatTargetCache::FMask FCombatTargetCache::GetValidTargets(int32 CasterSlot, ETargetType TargetType, EAbilityCategory Category) const
+{
+	if (!Slots.IsValidIndex(CasterSlot))
+	{
+		return 0;
+	}
+	if (TargetsCaster(TargetType))
+	{
+		return AliveMask & (FMask(1) << CasterSlot);
+	}
+	const int32 Side = static_cast<int32>(Slots[CasterSlot].Side);
+	return TargetMasks[Side][static_cast<int32>(TargetType)][static_cast<int32>(Category)];
+}
+
+FCombatTargetCache::FMask FCombatTargetCache::GetAttackTargets(int32 CasterSlot) const
+{
+	if (!Slots.IsValidIndex(CasterSlot))
+	{
+		return 0;
+	}
+	return SideMasks[1 - static_cast<int32>(Slots[CasterSlot].Side)];
+}
+
+AActor* FCombatTargetCache::GetFirstActor(FMask Mask) const
+{
+	while (Mask != 0)
+	{
+		const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		if (AActor* Actor = GetActor(Slot))
+		{
+			return Actor;
+		}
+		Mask &= Mask - 1;
+	}
+	return nullptr;
+}
+
+void FCombatTargetCache::GetActors(FMask Mask, TArray<AActor*>& OutActors) const
+{
+	while (Mask != 0)
+	{
+		const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		if (AActor* Actor = GetActor(Slot))
+		{
+			OutActors.Add(Actor);
+		}
+		Mask &= Mask - 1;
+	}
+}
+
+bool FCombatTargetCache::CanAfford(int32 Slot, const USkillData* Skill) const
+{
+	const int32 SkillIndex = GetSkills(Slot).IndexOfByKey(Skill);
+	return SkillIndex != INDEX_NONE && SkillIndex < MaxSlots && (GetAffordableSkills(Slot) & (FMask(1) << SkillIndex)) != 0;
+}
+
+TConstArrayView<USkillData*> FCombatTargetCache::GetSkills(int32 Slot) const
+{
+	if (!Slots.IsValidIndex(Slot))
+	{
+		return TConstArrayView<USkillData*>();
+	}
+	const TArray<USkillData*>* Skills = CombatTargetCache::FindSkills(Slots[Slot].AbilityComponent.Get());
+	return Skills ? TConstArrayView<USkillData*>(*Skills) : TConstArrayView<USkillData*>();
+}
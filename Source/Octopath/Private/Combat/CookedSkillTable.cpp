@@ -0,0 +1,343 @@
+#include "Combat/CookedSkillTable.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogCookedSkillTable, Log, All);
+
+namespace CookedSkillTable
+{
+	/** Average number of ids per hash bucket (lower: more displacement entries, faster build) */
+	constexpr int32 KeysPerBucket = 2;
+
+	/** Displacements tried per bucket before the build gives up */
+	constexpr uint32 MaxDisplacement = 1u << 24;
+
+	/** Integer finalizer (murmur3) of a key mixed with a seed */
+	FORCEINLINE uint32 Mix(uint32 Key, uint32 Seed)
+	{
+		uint32 Hash = Key ^ (Seed * 0x9E3779B9u);
+		Hash ^= Hash >> 16;
+		Hash *= 0x85EBCA6Bu;
+		Hash ^= Hash >> 13;
+		Hash *= 0xC2B2AE35u;
+		Hash ^= Hash >> 16;
+		return Hash;
+	}
+
+	FORCEINLINE uint32 GetBucket(uint32 SkillId, uint32 NumBuckets)
+	{
+		return Mix(SkillId, 0) % NumBuckets;
+	}
+
+	FORCEINLINE uint32 GetSlot(uint32 SkillId, uint32 Displacement, uint32 NumSlots)
+	{
+		return Mix(SkillId, Displacement + 1) % NumSlots;
+	}
+
+	/** Appends a string to the pool. */
+	FCookedSkillString AddString(TArray<UTF8CHAR>& Pool, const FString& Value)
+	{
+		const FTCHARToUTF8 Converted(*Value);
+		FCookedSkillString Result;
+		Result.Offset = Pool.Num();
+		Result.Length = Converted.Length();
+		Pool.Append(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length());
+		return Result;
+	}
+
+	FCookedSkillRecord MakeRecord(const USkillData& Skill, TArray<UTF8CHAR>& Pool)
+	{
+		FCookedSkillRecord Record;
+		FMemory::Memzero(Record);
+		Record.SkillId = FCookedSkillTable::MakeSkillId(Skill.GetFName());
+		Record.Damage = Skill.Damage;
+		Record.TechniqueCost = Skill.TechniqueCost;
+		Record.CastingTime = Skill.CastingTime;
+		Record.ModifierValue = Skill.ModifierValue;
+		Record.StatusEffectMagnitude = Skill.StatusEffectMagnitude;
+		Record.Duration = Skill.Duration;
+		Record.StatusEffectDuration = Skill.StatusEffectDuration;
+		Record.DamageTypeMask = Skill.DamageTypeMask;
+		Record.ShieldDamage = Skill.ShieldDamage;
+		Record.AttackType = Skill.AttackType;
+		Record.TargetMode = Skill.TargetMode;
+		Record.TargetType = Skill.TargetType;
+		Record.AbilityCategory = Skill.AbilityCategory;
+		Record.AffectedStat = Skill.AffectedStat;
+		Record.ModifierType = Skill.ModifierType;
+		Record.StatusEffect = Skill.StatusEffect;
+		Record.AssetName = AddString(Pool, Skill.GetName());
+		// Text is stored as its source string: the table does not carry localization.
+		Record.SkillName = AddString(Pool, Skill.SkillName.ToString());
+		Record.Description = AddString(Pool, Skill.Description.ToString());
+		Record.DamageFormula = AddString(Pool, Skill.DamageFormula);
+		Record.HealFormula = AddString(Pool, Skill.HealFormula);
+		return Record;
+	}
+}
+
+FCookedSkillTable::FCookedSkillTable() = default;
+
+FCookedSkillTable::~FCookedSkillTable()
+{
+	Reset();
+}
+
+FString FCookedSkillTable::GetDefaultFilename()
+{
+	return FPaths::ProjectContentDir() / TEXT("SkillTable/Skills.bin");
+}
+
+uint32 FCookedSkillTable::MakeSkillId(FName AssetName)
+{
+	return FCrc::StrCrc32(*AssetName.ToString().ToLower());
+}
+
+uint32 FCookedSkillTable::MakeContentHash(const USkillData& Skill)
+{
+	// The record is packed alone, so its string offsets only depend on the skill itself.
+	TArray<UTF8CHAR> Pool;
+	const FCookedSkillRecord Record = CookedSkillTable::MakeRecord(Skill, Pool);
+	return FCrc::MemCrc32(Pool.GetData(), Pool.Num(), FCrc::MemCrc32(&Record, sizeof(FCookedSkillRecord)));
+}
+
+bool FCookedSkillTable::Build(TConstArrayView<const USkillData*> Skills, TArray<uint8>& OutBytes, FString& OutError)
+{
+	using namespace CookedSkillTable;
+
+	OutBytes.Reset();
+	const uint32 NumSkills = Skills.Num();
+	if (NumSkills == 0)
+	{
+		OutError = TEXT("No skill to pack");
+		return false;
+	}
+
+	// Ids must be unique for the perfect hash (two asset names hashing alike must be renamed).
+	TMap<uint32, const USkillData*> SkillsById;
+	for (const USkillData* Skill : Skills)
+	{
+		check(Skill);
+		const uint32 SkillId = MakeSkillId(Skill->GetFName());
+		if (const USkillData** Existing = SkillsById.Find(SkillId))
+		{
+			OutError = FString::Printf(TEXT("%s and %s have the same skill id %u"), *(*Existing)->GetName(), *Skill->GetName(), SkillId);
+			return false;
+		}
+		SkillsById.Add(SkillId, Skill);
+	}
+
+	// Hash and displace: spread the ids into buckets, then place the largest buckets first, searching for each
+	// bucket a displacement that sends all its ids to free slots. Every slot ends up holding exactly one skill.
+	const uint32 NumBuckets = FMath::Max<uint32>(1, (NumSkills + KeysPerBucket - 1) / KeysPerBucket);
+	TArray<TArray<int32, TInlineAllocator<4>>> Buckets;
+	Buckets.SetNum(NumBuckets);
+	for (uint32 SkillIndex = 0; SkillIndex < NumSkills; SkillIndex++)
+	{
+		Buckets[GetBucket(MakeSkillId(Skills[SkillIndex]->GetFName()), NumBuckets)].Add(SkillIndex);
+	}
+
+	TArray<int32> BucketOrder;
+	BucketOrder.Reserve(NumBuckets);
+	for (uint32 BucketIndex = 0; BucketIndex < NumBuckets; BucketIndex++)
+	{
+		BucketOrder.Add(BucketIndex);
+	}
+	BucketOrder.Sort([&Buckets](int32 A, int32 B) { return Buckets[A].Num() > Buckets[B].Num(); });
+
+	TArray<uint32> BucketDisplacements;
+	BucketDisplacements.Init(0, NumBuckets);
+	TArray<int32> SlotToSkill;
+	SlotToSkill.Init(INDEX_NONE, NumSkills);
+	TArray<uint32, TInlineAllocator<8>> CandidateSlots;
+
+	for (const int32 BucketIndex : BucketOrder)
+	{
+		const TArray<int32, TInlineAllocator<4>>& Bucket = Buckets[BucketIndex];
+		if (Bucket.Num() == 0)
+		{
+			break;
+		}
+
+		bool bPlaced = false;
+		for (uint32 Displacement = 0; Displacement < MaxDisplacement && !bPlaced; Displacement++)
+		{
+			CandidateSlots.Reset();
+			bPlaced = true;
+			for (const int32 SkillIndex : Bucket)
+			{
+				const uint32 Slot = GetSlot(MakeSkillId(Skills[SkillIndex]->GetFName()), Displacement, NumSkills);
+				if (SlotToSkill[Slot] != INDEX_NONE || CandidateSlots.Contains(Slot))
+				{
+					bPlaced = false;
+					break;
+				}
+				CandidateSlots.Add(Slot);
+			}
+
+			if (bPlaced)
+			{
+				BucketDisplacements[BucketIndex] = Displacement;
+				for (int32 i = 0; i < Bucket.Num(); i++)
+				{
+					SlotToSkill[CandidateSlots[i]] = Bucket[i];
+				}
+			}
+		}
+
+		if (!bPlaced)
+		{
+			OutError = FString::Printf(TEXT("No perfect hash displacement found for bucket %d"), BucketIndex);
+			return false;
+		}
+	}
+
+	// Records in slot order, strings pooled.
+	TArray<UTF8CHAR> StringPool;
+	TArray<FCookedSkillRecord> Records;
+	Records.Reserve(NumSkills);
+	for (uint32 Slot = 0; Slot < NumSkills; Slot++)
+	{
+		const USkillData& Skill = *Skills[SlotToSkill[Slot]];
+		FCookedSkillRecord& Record = Records.Add_GetRef(MakeRecord(Skill, StringPool));
+		Record.ContentHash = MakeContentHash(Skill);
+	}
+
+	// Sections are 8-byte aligned so records can be read in place from the mapping.
+	FCookedSkillTableHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FCookedSkillTableHeader::ExpectedMagic;
+	Header.Version = FCookedSkillTableHeader::CurrentVersion;
+	Header.RecordSize = sizeof(FCookedSkillRecord);
+	Header.NumSkills = NumSkills;
+	Header.NumBuckets = NumBuckets;
+	Header.DisplacementsOffset = Align(sizeof(FCookedSkillTableHeader), 8);
+	Header.RecordsOffset = Align(Header.DisplacementsOffset + NumBuckets * sizeof(uint32), 8);
+	Header.StringsOffset = Align(Header.RecordsOffset + NumSkills * sizeof(FCookedSkillRecord), 8);
+	Header.StringsSize = StringPool.Num();
+
+	OutBytes.SetNumZeroed(Header.StringsOffset + Header.StringsSize);
+	FMemory::Memcpy(OutBytes.GetData() + Header.DisplacementsOffset, BucketDisplacements.GetData(), NumBuckets * sizeof(uint32));
+	FMemory::Memcpy(OutBytes.GetData() + Header.RecordsOffset, Records.GetData(), NumSkills * sizeof(FCookedSkillRecord));
+	FMemory::Memcpy(OutBytes.GetData() + Header.StringsOffset, StringPool.GetData(), StringPool.Num());
+
+	Header.PayloadCrc = FCrc::MemCrc32(OutBytes.GetData() + sizeof(FCookedSkillTableHeader), OutBytes.Num() - sizeof(FCookedSkillTableHeader));
+	FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(FCookedSkillTableHeader));
+	return true;
+}
+
+bool FCookedSkillTable::LoadFromFile(const FString& Filename)
+{
+	Reset();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Filename))
+	{
+		UE_LOG(LogCookedSkillTable, Log, TEXT("LoadFromFile - %s not found"), *Filename);
+		return false;
+	}
+
+	MappedHandle.Reset(PlatformFile.OpenMapped(*Filename));
+	if (MappedHandle)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+		if (MappedRegion && Bind(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), Filename))
+		{
+			UE_LOG(LogCookedSkillTable, Log, TEXT("LoadFromFile - Mapped %d skills from %s"), Num(), *Filename);
+			return true;
+		}
+		Reset();
+	}
+
+	// Mapping unsupported (e.g. the file ended up inside a pak): read it instead.
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+	{
+		UE_LOG(LogCookedSkillTable, Warning, TEXT("LoadFromFile - Could not read %s"), *Filename);
+		return false;
+	}
+	return LoadFromMemory(MoveTemp(Bytes));
+}
+
+bool FCookedSkillTable::LoadFromMemory(TArray<uint8>&& Bytes)
+{
+	Reset();
+	OwnedBytes = MoveTemp(Bytes);
+	if (!Bind(OwnedBytes.GetData(), OwnedBytes.Num(), TEXT("memory")))
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FCookedSkillTable::Reset()
+{
+	Header = nullptr;
+	Displacements = nullptr;
+	Records = nullptr;
+	Strings = nullptr;
+	// The region must be released before its file handle.
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	OwnedBytes.Empty();
+}
+
+bool FCookedSkillTable::Bind(const uint8* Data, int64 Size, const FString& SourceName)
+{
+	if (!Data || Size < static_cast<int64>(sizeof(FCookedSkillTableHeader)))
+	{
+		UE_LOG(LogCookedSkillTable, Warning, TEXT("Bind - %s is too small to be a skill table"), *SourceName);
+		return false;
+	}
+
+	const FCookedSkillTableHeader* CandidateHeader = reinterpret_cast<const FCookedSkillTableHeader*>(Data);
+	if (CandidateHeader->Magic != FCookedSkillTableHeader::ExpectedMagic
+		|| CandidateHeader->Version != FCookedSkillTableHeader::CurrentVersion
+		|| CandidateHeader->RecordSize != sizeof(FCookedSkillRecord))
+	{
+		UE_LOG(LogCookedSkillTable, Warning, TEXT("Bind - %s has an unsupported format (version %u), rebuild it with the SkillTable commandlet"), *SourceName, CandidateHeader->Version);
+		return false;
+	}
+
+	const int64 RecordsEnd = static_cast<int64>(CandidateHeader->RecordsOffset) + static_cast<int64>(CandidateHeader->NumSkills) * sizeof(FCookedSkillRecord);
+	const int64 DisplacementsEnd = static_cast<int64>(CandidateHeader->DisplacementsOffset) + static_cast<int64>(CandidateHeader->NumBuckets) * sizeof(uint32);
+	const int64 StringsEnd = static_cast<int64>(CandidateHeader->StringsOffset) + CandidateHeader->StringsSize;
+	if (CandidateHeader->NumSkills == 0 || CandidateHeader->NumBuckets == 0 || DisplacementsEnd > Size || RecordsEnd > Size || StringsEnd > Size
+		|| !IsAligned(CandidateHeader->RecordsOffset, alignof(FCookedSkillRecord)) || !IsAligned(CandidateHeader->DisplacementsOffset, alignof(uint32)))
+	{
+		UE_LOG(LogCookedSkillTable, Warning, TEXT("Bind - %s is truncated or corrupted"), *SourceName);
+		return false;
+	}
+
+#if !UE_BUILD_SHIPPING
+	// Full checksum in development builds only: shipping reads the mapped pages lazily.
+	if (FCrc::MemCrc32(Data + sizeof(FCookedSkillTableHeader), Size - sizeof(FCookedSkillTableHeader)) != CandidateHeader->PayloadCrc)
+	{
+		UE_LOG(LogCookedSkillTable, Warning, TEXT("Bind - %s failed its checksum"), *SourceName);
+		return false;
+	}
+#endif
+
+	Header = CandidateHeader;
+	Displacements = reinterpret_cast<const uint32*>(Data + Header->DisplacementsOffset);
+	Records = reinterpret_cast<const FCookedSkillRecord*>(Data + Header->RecordsOffset);
+	Strings = reinterpret_cast<const UTF8CHAR*>(Data + Header->StringsOffset);
+	return true;
+}
+
+const FCookedSkillRecord* FCookedSkillTable::Find(uint32 SkillId) const
+{
+	if (!Header)
+	{
+		return nullptr;
+	}
+
+	const uint32 Displacement = Displacements[CookedSkillTable::GetBucket(SkillId, Header->NumBuckets)];
+	const FCookedSkillRecord& Record = Records[CookedSkillTable::GetSlot(SkillId, Displacement, Header->NumSkills)];
+
+	// Unknown ids land on some other skill's slot.
+	return Record.SkillId == SkillId ? &Record : nullptr;
+}
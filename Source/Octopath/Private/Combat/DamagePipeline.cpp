@@ -0,0 +1,7 @@
+#include "Combat/DamagePipeline.h"
+#include "Combat/CombatBalance.h"
+
+const FDamageTunables& FDamageTunables::Get()
+{
+	return FCombatBalance::Get().Damage;
+}
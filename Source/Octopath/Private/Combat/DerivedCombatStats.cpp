@@ -0,0 +1,107 @@
+#include "Combat/DerivedCombatStats.h"
+#include "Combat/DamagePipeline.h"
+#include "Manager/StatComponent.h"
+
+namespace DerivedCombatStats
+{
+	// The default attack formula is owned by the damage pipeline; the cache stores its two halves.
+	using FBasicAttackMitigation = DamagePipeline::FBasicAttackMitigation;
+
+	// Input bits: one per stat channel, one for the defending and broken states, one per node (offset by NodeBitOffset).
+	constexpr uint32 ChannelBit(EStatChannel Channel) { return 1u << static_cast<uint32>(Channel); }
+	constexpr uint32 BrokenBit = 1u << 14;
+	constexpr uint32 DefendingBit = 1u << 15;
+	constexpr uint32 NodeBitOffset = 16;
+	constexpr uint32 NodeBit(EDerivedStat Stat) { return 1u << (NodeBitOffset + static_cast<uint32>(Stat)); }
+
+	/** Direct inputs of each node, indexed by EDerivedStat */
+	constexpr uint32 NodeInputs[FDerivedCombatStats::NumNodes] =
+	{
+		/* BasicAttackOutput     */ ChannelBit(EStatChannel::PhysicalAttack),
+		/* BasicAttackMitigation */ ChannelBit(EStatChannel::PhysicalDefense),
+		/* IncomingDamageScale   */ DefendingBit | BrokenBit,
+		/* HealthFraction        */ ChannelBit(EStatChannel::Health) | ChannelBit(EStatChannel::MaxHealth),
+		/* EffectiveHealth       */ ChannelBit(EStatChannel::Health) | NodeBit(EDerivedStat::IncomingDamageScale),
+	};
+
+	/** Returns the mask of nodes that must be invalidated (transitively) when the given inputs change. */
+	uint32 GetDependents(uint32 InputMask)
+	{
+		uint32 Dirty = 0;
+		// Nodes only depend on earlier nodes, so a single forward pass propagates through the graph.
+		for (int32 Node = 0; Node < FDerivedCombatStats::NumNodes; Node++)
+		{
+			const uint32 Inputs = NodeInputs[Node];
+			if ((Inputs & InputMask) != 0 || ((Inputs >> NodeBitOffset) & Dirty) != 0)
+			{
+				Dirty |= 1u << Node;
+			}
+		}
+		return Dirty;
+	}
+}
+
+float FDerivedCombatStats::Get(EDerivedStat Stat, const UStatComponent& Owner) const
+{
+	const int32 Index = static_cast<int32>(Stat);
+	check(Index >= 0 && Index < NumNodes);
+
+	const uint32 Bit = 1u << Index;
+	if (DirtyMask & Bit)
+	{
+		Values[Index] = Evaluate(Stat, Owner);
+		DirtyMask &= ~Bit;
+	}
+	return Values[Index];
+}
+
+void FDerivedCombatStats::InvalidateChannel(EStatChannel Channel)
+{
+	DirtyMask |= DerivedCombatStats::GetDependents(DerivedCombatStats::ChannelBit(Channel));
+}
+
+void FDerivedCombatStats::InvalidateDefending()
+{
+	DirtyMask |= DerivedCombatStats::GetDependents(DerivedCombatStats::DefendingBit);
+}
+
+void FDerivedCombatStats::InvalidateBroken()
+{
+	DirtyMask |= DerivedCombatStats::GetDependents(DerivedCombatStats::BrokenBit);
+}
+
+float FDerivedCombatStats::BasicAttackDamage(const FDerivedCombatStats& Attacker, const UStatComponent& AttackerOwner, const FDerivedCombatStats& Target, const UStatComponent& TargetOwner)
+{
+	const float Damage = Attacker.Get(EDerivedStat::BasicAttackOutput, AttackerOwner) - Target.Get(EDerivedStat::BasicAttackMitigation, TargetOwner);
+	return FMath::Max(Damage, FDamageTunables::Get().MinimumDamage);
+}
+
+float FDerivedCombatStats::Evaluate(EDerivedStat Stat, const UStatComponent& Owner) const
+{
+	switch (Stat)
+	{
+	case EDerivedStat::BasicAttackOutput:
+		return DerivedCombatStats::FBasicAttackMitigation::Output(Owner.PhysicalAttack, FDamageTunables::Get());
+
+	case EDerivedStat::BasicAttackMitigation:
+		return DerivedCombatStats::FBasicAttackMitigation::Reduction(Owner.PhysicalDefense, FDamageTunables::Get());
+
+	case EDerivedStat::IncomingDamageScale:
+	{
+		const float DefendingScale = Owner.bIsDefending ? (1.f - Owner.DefenseReductionPercentage) : 1.f;
+		return Owner.IsBroken() ? DefendingScale * Owner.BrokenDamageMultiplier : DefendingScale;
+	}
+
+	case EDerivedStat::HealthFraction:
+		return (Owner.MaxHealth > 0.f) ? Owner.Health / Owner.MaxHealth : 0.f;
+
+	case EDerivedStat::EffectiveHealth:
+	{
+		const float Scale = Get(EDerivedStat::IncomingDamageScale, Owner);
+		return (Scale > KINDA_SMALL_NUMBER) ? Owner.Health / Scale : MAX_flt;
+	}
+
+	default:
+		return 0.f;
+	}
+}
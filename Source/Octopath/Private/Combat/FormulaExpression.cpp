@@ -0,0 +1,526 @@
+#include "Combat/FormulaExpression.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFormulaExpression, Log, All);
+
+static_assert(FFormulaVariables::NumVariables <= 32, "FCompiledFormula::VariableMask holds one bit per variable");
+
+namespace FormulaExpression
+{
+	const TCHAR* StatNames[] =
+	{
+		TEXT("Health"), TEXT("MaxHealth"), TEXT("TechniquePoints"), TEXT("MaxTechniquePoints"),
+		TEXT("PhysicalAttack"), TEXT("MagicalAttack"), TEXT("PhysicalDefense"), TEXT("MagicalDefense"), TEXT("Speed")
+	};
+
+	/** Resolves a dotted variable name (case insensitive), or returns false. */
+	bool FindVariable(const FString& Name, EFormulaVariable& OutVariable)
+	{
+		FString Scope, Field;
+		if (!Name.Split(TEXT("."), &Scope, &Field))
+		{
+			if (Name.Equals(TEXT("Variance"), ESearchCase::IgnoreCase))
+			{
+				OutVariable = EFormulaVariable::Variance;
+				return true;
+			}
+			return false;
+		}
+
+		const bool bCaster = Scope.Equals(TEXT("Caster"), ESearchCase::IgnoreCase);
+		const bool bTarget = Scope.Equals(TEXT("Target"), ESearchCase::IgnoreCase);
+		if (bCaster || bTarget)
+		{
+			for (int32 i = 0; i < UE_ARRAY_COUNT(StatNames); i++)
+			{
+				if (Field.Equals(StatNames[i], ESearchCase::IgnoreCase))
+				{
+					const int32 First = static_cast<int32>(bCaster ? EFormulaVariable::CasterHealth : EFormulaVariable::TargetHealth);
+					OutVariable = static_cast<EFormulaVariable>(First + i);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		if (Scope.Equals(TEXT("Skill"), ESearchCase::IgnoreCase))
+		{
+			if (Field.Equals(TEXT("Damage"), ESearchCase::IgnoreCase))
+			{
+				OutVariable = EFormulaVariable::SkillDamage;
+				return true;
+			}
+			if (Field.Equals(TEXT("ModifierValue"), ESearchCase::IgnoreCase))
+			{
+				OutVariable = EFormulaVariable::SkillModifierValue;
+				return true;
+			}
+			if (Field.Equals(TEXT("TechniqueCost"), ESearchCase::IgnoreCase))
+			{
+				OutVariable = EFormulaVariable::SkillTechniqueCost;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FORCEINLINE float SafeDivide(float A, float B)
+	{
+		return (B != 0.f) ? A / B : 0.f;
+	}
+
+	float Fold(EFormulaOp Op, float A, float B)
+	{
+		switch (Op)
+		{
+		case EFormulaOp::Add: return A + B;
+		case EFormulaOp::Sub: return A - B;
+		case EFormulaOp::Mul: return A * B;
+		case EFormulaOp::Div: return SafeDivide(A, B);
+		case EFormulaOp::Min: return FMath::Min(A, B);
+		case EFormulaOp::Max: return FMath::Max(A, B);
+		case EFormulaOp::Neg: return -A;
+		default: return 0.f;
+		}
+	}
+
+	/** Result of a sub-expression: either a folded constant or a register */
+	struct FOperand
+	{
+		bool bConstant = false;
+		float Value = 0.f;
+		uint8 Register = 0;
+	};
+
+	/**
+	 * Recursive descent parser emitting register code as it goes.
+	 * Registers are allocated as a stack: a sub-expression's result always lands in the lowest free register,
+	 * so a binary operation writes into the lower of its two operand registers and frees the other one.
+	 *
+	 *   Expression := Term (('+' | '-') Term)*
+	 *   Term       := Unary (('*' | '/') Unary)*
+	 *   Unary      := '-' Unary | Primary
+	 *   Primary    := Number | Variable | Function '(' Expression (',' Expression)* ')' | '(' Expression ')'
+	 */
+	class FParser
+	{
+	public:
+		FParser(const FString& InSource, TArray<FFormulaInstruction>& InCode, TArray<float>& InConstants, uint32& InVariableMask)
+			: Source(InSource), Code(InCode), Constants(InConstants), VariableMask(InVariableMask)
+		{
+		}
+
+		bool Parse(FString& OutError)
+		{
+			FOperand Result;
+			if (!ParseExpression(Result))
+			{
+				OutError = Error;
+				return false;
+			}
+			SkipWhitespace();
+			if (Position < Source.Len())
+			{
+				OutError = FString::Printf(TEXT("Unexpected '%c' at %d"), Source[Position], Position);
+				return false;
+			}
+
+			// The result must end up in register 0.
+			if (!Materialize(Result))
+			{
+				OutError = Error;
+				return false;
+			}
+			check(Result.Register == 0);
+			return true;
+		}
+
+	private:
+		const FString& Source;
+		TArray<FFormulaInstruction>& Code;
+		TArray<float>& Constants;
+		uint32& VariableMask;
+
+		int32 Position = 0;
+		int32 NextRegister = 0;
+		FString Error;
+
+		bool Fail(const FString& Message)
+		{
+			if (Error.IsEmpty())
+			{
+				Error = FString::Printf(TEXT("%s at %d"), *Message, Position);
+			}
+			return false;
+		}
+
+		void SkipWhitespace()
+		{
+			while (Position < Source.Len() && FChar::IsWhitespace(Source[Position]))
+			{
+				Position++;
+			}
+		}
+
+		bool Match(TCHAR Character)
+		{
+			SkipWhitespace();
+			if (Position < Source.Len() && Source[Position] == Character)
+			{
+				Position++;
+				return true;
+			}
+			return false;
+		}
+
+		bool AllocateRegister(uint8& OutRegister)
+		{
+			if (NextRegister >= FCompiledFormula::MaxRegisters)
+			{
+				return Fail(TEXT("Formula too deeply nested"));
+			}
+			OutRegister = static_cast<uint8>(NextRegister++);
+			return true;
+		}
+
+		void Emit(EFormulaOp Op, uint8 Dst, uint8 A, uint8 B = 0)
+		{
+			Code.Add({ Op, Dst, A, B });
+		}
+
+		/** Loads a folded constant into a register. */
+		bool Materialize(FOperand& Operand)
+		{
+			if (!Operand.bConstant)
+			{
+				return true;
+			}
+			int32 ConstantIndex = Constants.IndexOfByKey(Operand.Value);
+			if (ConstantIndex == INDEX_NONE)
+			{
+				if (Constants.Num() > MAX_uint8)
+				{
+					return Fail(TEXT("Too many constants"));
+				}
+				ConstantIndex = Constants.Add(Operand.Value);
+			}
+			if (!AllocateRegister(Operand.Register))
+			{
+				return false;
+			}
+			Emit(EFormulaOp::LoadConst, Operand.Register, static_cast<uint8>(ConstantIndex));
+			Operand.bConstant = false;
+			return true;
+		}
+
+		/** Combines two operands, folding constants and trivial identities. */
+		bool Combine(EFormulaOp Op, FOperand& Left, FOperand Right)
+		{
+			if (Left.bConstant && Right.bConstant)
+			{
+				Left.Value = Fold(Op, Left.Value, Right.Value);
+				return true;
+			}
+
+			// x + 0, x - 0, x * 1, x / 1 and 0 + x, 1 * x need no instruction.
+			if (Right.bConstant && ((Right.Value == 0.f && (Op == EFormulaOp::Add || Op == EFormulaOp::Sub)) || (Right.Value == 1.f && (Op == EFormulaOp::Mul || Op == EFormulaOp::Div))))
+			{
+				return true;
+			}
+			if (Left.bConstant && ((Left.Value == 0.f && Op == EFormulaOp::Add) || (Left.Value == 1.f && Op == EFormulaOp::Mul)))
+			{
+				Left = Right;
+				return true;
+			}
+
+			if (!Materialize(Left) || !Materialize(Right))
+			{
+				return false;
+			}
+
+			// Both operands are the two topmost registers: keep the lower one, free the other.
+			const uint8 Dst = FMath::Min(Left.Register, Right.Register);
+			Emit(Op, Dst, Left.Register, Right.Register);
+			NextRegister = Dst + 1;
+			Left.Register = Dst;
+			return true;
+		}
+
+		bool ParseExpression(FOperand& Out)
+		{
+			if (!ParseTerm(Out))
+			{
+				return false;
+			}
+			while (true)
+			{
+				const EFormulaOp Op = Match(TEXT('+')) ? EFormulaOp::Add : (Match(TEXT('-')) ? EFormulaOp::Sub : EFormulaOp::LoadConst);
+				if (Op == EFormulaOp::LoadConst)
+				{
+					return true;
+				}
+				FOperand Right;
+				if (!ParseTerm(Right) || !Combine(Op, Out, Right))
+				{
+					return false;
+				}
+			}
+		}
+
+		bool ParseTerm(FOperand& Out)
+		{
+			if (!ParseUnary(Out))
+			{
+				return false;
+			}
+			while (true)
+			{
+				const EFormulaOp Op = Match(TEXT('*')) ? EFormulaOp::Mul : (Match(TEXT('/')) ? EFormulaOp::Div : EFormulaOp::LoadConst);
+				if (Op == EFormulaOp::LoadConst)
+				{
+					return true;
+				}
+				FOperand Right;
+				if (!ParseUnary(Right) || !Combine(Op, Out, Right))
+				{
+					return false;
+				}
+			}
+		}
+
+		bool ParseUnary(FOperand& Out)
+		{
+			if (Match(TEXT('-')))
+			{
+				if (!ParseUnary(Out))
+				{
+					return false;
+				}
+				if (Out.bConstant)
+				{
+					Out.Value = -Out.Value;
+					return true;
+				}
+				Emit(EFormulaOp::Neg, Out.Register, Out.Register);
+				return true;
+			}
+			return ParsePrimary(Out);
+		}
+
+		bool ParsePrimary(FOperand& Out)
+		{
+			SkipWhitespace();
+			if (Position >= Source.Len())
+			{
+				return Fail(TEXT("Unexpected end of formula"));
+			}
+
+			if (Match(TEXT('(')))
+			{
+				if (!ParseExpression(Out))
+				{
+					return false;
+				}
+				return Match(TEXT(')')) ? true : Fail(TEXT("Expected ')'"));
+			}
+
+			const TCHAR First = Source[Position];
+			if (FChar::IsDigit(First) || First == TEXT('.'))
+			{
+				const int32 Start = Position;
+				while (Position < Source.Len() && (FChar::IsDigit(Source[Position]) || Source[Position] == TEXT('.')))
+				{
+					Position++;
+				}
+				Out.bConstant = true;
+				Out.Value = FCString::Atof(*Source.Mid(Start, Position - Start));
+				return true;
+			}
+
+			if (FChar::IsAlpha(First) || First == TEXT('_'))
+			{
+				const int32 Start = Position;
+				while (Position < Source.Len() && (FChar::IsAlnum(Source[Position]) || Source[Position] == TEXT('_') || Source[Position] == TEXT('.')))
+				{
+					Position++;
+				}
+				const FString Name = Source.Mid(Start, Position - Start);
+
+				if (Match(TEXT('(')))
+				{
+					return ParseFunction(Name, Out);
+				}
+
+				EFormulaVariable Variable;
+				if (!FindVariable(Name, Variable))
+				{
+					return Fail(FString::Printf(TEXT("Unknown variable '%s'"), *Name));
+				}
+				if (!AllocateRegister(Out.Register))
+				{
+					return false;
+				}
+				Out.bConstant = false;
+				Emit(EFormulaOp::LoadVar, Out.Register, static_cast<uint8>(Variable));
+				VariableMask |= 1u << static_cast<uint32>(Variable);
+				return true;
+			}
+
+			return Fail(FString::Printf(TEXT("Unexpected '%c'"), First));
+		}
+
+		bool ParseFunction(const FString& Name, FOperand& Out)
+		{
+			TArray<FOperand, TInlineAllocator<3>> Arguments;
+			do
+			{
+				FOperand& Argument = Arguments.AddDefaulted_GetRef();
+				if (!ParseExpression(Argument))
+				{
+					return false;
+				}
+			} while (Match(TEXT(',')));
+			if (!Match(TEXT(')')))
+			{
+				return Fail(TEXT("Expected ')'"));
+			}
+
+			const bool bMin = Name.Equals(TEXT("min"), ESearchCase::IgnoreCase);
+			const bool bMax = Name.Equals(TEXT("max"), ESearchCase::IgnoreCase);
+			if ((bMin || bMax) && Arguments.Num() == 2)
+			{
+				Out = Arguments[0];
+				return Combine(bMin ? EFormulaOp::Min : EFormulaOp::Max, Out, Arguments[1]);
+			}
+			if (Name.Equals(TEXT("clamp"), ESearchCase::IgnoreCase) && Arguments.Num() == 3)
+			{
+				// clamp(x, lo, hi) = min(max(x, lo), hi)
+				Out = Arguments[0];
+				if (Arguments[2].bConstant)
+				{
+					return Combine(EFormulaOp::Max, Out, Arguments[1]) && Combine(EFormulaOp::Min, Out, Arguments[2]);
+				}
+
+				// hi already holds a register, so x, lo and hi are the three topmost registers once materialized.
+				FOperand& Low = Arguments[1];
+				const FOperand& High = Arguments[2];
+				if (!Materialize(Out) || !Materialize(Low))
+				{
+					return false;
+				}
+				const uint8 Temp = FMath::Min(Out.Register, Low.Register);
+				const uint8 Dst = FMath::Min(Temp, High.Register);
+				Emit(EFormulaOp::Max, Temp, Out.Register, Low.Register);
+				Emit(EFormulaOp::Min, Dst, Temp, High.Register);
+				NextRegister = Dst + 1;
+				Out.Register = Dst;
+				return true;
+			}
+			return Fail(FString::Printf(TEXT("Unknown function '%s' with %d argument(s)"), *Name, Arguments.Num()));
+		}
+	};
+}
+
+bool FCompiledFormula::Compile(const FString& Source, FString* OutError)
+{
+	Reset();
+
+	FString Error;
+	FormulaExpression::FParser Parser(Source, Code, Constants, VariableMask);
+	if (!Parser.Parse(Error))
+	{
+		Reset();
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+		return false;
+	}
+	return true;
+}
+
+void FCompiledFormula::Reset()
+{
+	Code.Reset();
+	Constants.Reset();
+	VariableMask = 0;
+}
+
+float FCompiledFormula::Evaluate(const FFormulaVariables& Variables) const
+{
+	float Registers[MaxRegisters];
+	const float* RESTRICT Values = Variables.Values;
+	const float* RESTRICT ConstantValues = Constants.GetData();
+
+	for (const FFormulaInstruction& Instruction : Code)
+	{
+		switch (Instruction.Op)
+		{
+		case EFormulaOp::LoadConst: Registers[Instruction.Dst] = ConstantValues[Instruction.A]; break;
+		case EFormulaOp::LoadVar:   Registers[Instruction.Dst] = Values[Instruction.A]; break;
+		case EFormulaOp::Add:       Registers[Instruction.Dst] = Registers[Instruction.A] + Registers[Instruction.B]; break;
+		case EFormulaOp::Sub:       Registers[Instruction.Dst] = Registers[Instruction.A] - Registers[Instruction.B]; break;
+		case EFormulaOp::Mul:       Registers[Instruction.Dst] = Registers[Instruction.A] * Registers[Instruction.B]; break;
+		case EFormulaOp::Div:       Registers[Instruction.Dst] = FormulaExpression::SafeDivide(Registers[Instruction.A], Registers[Instruction.B]); break;
+		case EFormulaOp::Min:       Registers[Instruction.Dst] = FMath::Min(Registers[Instruction.A], Registers[Instruction.B]); break;
+		case EFormulaOp::Max:       Registers[Instruction.Dst] = FMath::Max(Registers[Instruction.A], Registers[Instruction.B]); break;
+		case EFormulaOp::Neg:       Registers[Instruction.Dst] = -Registers[Instruction.A]; break;
+		default:                    checkNoEntry(); break;
+		}
+	}
+	return Registers[0];
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.Formula [Iterations] [Formula]
+ *
+ * Compiles a formula and logs its instruction count and the average cost per evaluation.
+ * Compare with the dynamic broadcast cost logged by Octopath.Bench.StatBroadcast (one Blueprint-style call).
+ */
+static FAutoConsoleCommand GFormulaBenchmarkCommand(
+	TEXT("Octopath.Bench.Formula"),
+	TEXT("Times compiled formula evaluation. Usage: Octopath.Bench.Formula [Iterations] [Formula]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			int32 Iterations = 1000000;
+			if (Args.Num() > 0)
+			{
+				Iterations = FMath::Max(1, FCString::Atoi(*Args[0]));
+			}
+			FString Source = TEXT("(Skill.Damage + Caster.MagicalAttack - Target.MagicalDefense * (1 / 2)) * Variance");
+			if (Args.Num() > 1)
+			{
+				Source = FString::Join(TArrayView<const FString>(Args).RightChop(1), TEXT(" "));
+			}
+
+			FCompiledFormula Formula;
+			FString Error;
+			if (!Formula.Compile(Source, &Error))
+			{
+				UE_LOG(LogFormulaExpression, Error, TEXT("Formula '%s' does not compile: %s"), *Source, *Error);
+				return;
+			}
+
+			FFormulaVariables Variables;
+			for (int32 i = 0; i < FFormulaVariables::NumVariables; i++)
+			{
+				Variables.Values[i] = 10.f + i;
+			}
+
+			float Sum = 0.f;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; i++)
+			{
+				Variables.Values[0] = static_cast<float>(i & 0xFF);
+				Sum += Formula.Evaluate(Variables);
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			UE_LOG(LogFormulaExpression, Display, TEXT("Formula '%s' (%d instructions, %d iterations): %.1f ns/evaluation (checksum %f)"),
+				*Source, Formula.GetCode().Num(), Iterations, Seconds * 1.0e9 / Iterations, Sum);
+		}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,175 @@
+#include "Combat/ScreenTargetPicker.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+AActor* FScreenTargetPicker::GetActorUnderCursor(const APlayerController& PC, const FCombatTargetCache& Targets, FMask Candidates)
+{
+	float CursorX = 0.f;
+	float CursorY = 0.f;
+	if (!PC.GetMousePosition(CursorX, CursorY))
+	{
+		bCursorMoved = false;
+		return nullptr;
+	}
+	const FVector2D Cursor(CursorX, CursorY);
+	bCursorMoved = Cursor != LastCursor;
+
+	// Build drops the last pick, which forces a new one below.
+	Update(PC, Targets);
+
+	if (bCursorMoved || Candidates != LastCandidates || !bHasPick)
+	{
+		LastCursor = Cursor;
+		LastCandidates = Candidates;
+		LastPickedSlot = Pick(Cursor, Candidates);
+		bHasPick = true;
+	}
+	return LastPickedSlot != INDEX_NONE ? Entries[LastPickedSlot].Actor.Get() : nullptr;
+}
+
+void FScreenTargetPicker::Update(const APlayerController& PC, const FCombatTargetCache& Targets)
+{
+	if (!bBuilt || IsStale(PC, Targets))
+	{
+		Build(PC, Targets);
+	}
+}
+
+bool FScreenTargetPicker::GetScreenCenter(int32 Slot, FVector2D& OutCenter) const
+{
+	if (!Entries.IsValidIndex(Slot) || !Entries[Slot].Rect.bIsValid)
+	{
+		return false;
+	}
+	OutCenter = Entries[Slot].Rect.GetCenter();
+	return true;
+}
+
+int32 FScreenTargetPicker::Pick(const FVector2D& ScreenPosition, FMask Candidates) const
+{
+	if (ViewportSize.X <= 0 || ViewportSize.Y <= 0)
+	{
+		return INDEX_NONE;
+	}
+	const int32 CellX = FMath::FloorToInt32(ScreenPosition.X * GridSize / ViewportSize.X);
+	const int32 CellY = FMath::FloorToInt32(ScreenPosition.Y * GridSize / ViewportSize.Y);
+	if (CellX < 0 || CellX >= GridSize || CellY < 0 || CellY >= GridSize)
+	{
+		return INDEX_NONE;
+	}
+
+	int32 BestSlot = INDEX_NONE;
+	float BestDepth = MAX_flt;
+	for (FMask Mask = Cells[CellY * GridSize + CellX] & Candidates; Mask != 0; Mask &= Mask - 1)
+	{
+		const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		const FEntry& Entry = Entries[Slot];
+		if (Entry.Depth < BestDepth && Entry.Rect.IsInside(ScreenPosition))
+		{
+			BestSlot = Slot;
+			BestDepth = Entry.Depth;
+		}
+	}
+	return BestSlot;
+}
+
+bool FScreenTargetPicker::IsStale(const APlayerController& PC, const FCombatTargetCache& Targets) const
+{
+	if (Entries.Num() != Targets.Num())
+	{
+		return true;
+	}
+
+	FVector Location;
+	FRotator Rotation;
+	float FOV;
+	FIntPoint Size;
+	GetView(PC, Location, Rotation, FOV, Size);
+	if (!Location.Equals(ViewLocation) || !Rotation.Equals(ViewRotation) || FOV != ViewFOV || Size != ViewportSize)
+	{
+		return true;
+	}
+
+	for (int32 Slot = 0; Slot < Entries.Num(); Slot++)
+	{
+		const FEntry& Entry = Entries[Slot];
+		const AActor* Actor = Targets.GetActor(Slot);
+		if (Entry.Actor.Get() != Actor)
+		{
+			return true;
+		}
+		if (Actor && (!Actor->GetActorLocation().Equals(Entry.Location) || !Actor->GetActorQuat().Equals(Entry.Rotation)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FScreenTargetPicker::Build(const APlayerController& PC, const FCombatTargetCache& Targets)
+{
+	GetView(PC, ViewLocation, ViewRotation, ViewFOV, ViewportSize);
+	FMemory::Memzero(Cells);
+	Entries.Reset();
+	bBuilt = true;
+
+	// The slot of the last pick may have moved or changed actor.
+	LastPickedSlot = INDEX_NONE;
+	bHasPick = false;
+
+	for (int32 Slot = 0; Slot < Targets.Num(); Slot++)
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		AActor* Actor = Targets.GetActor(Slot);
+		Entry.Actor = Actor;
+		if (!Actor)
+		{
+			continue;
+		}
+		Entry.Location = Actor->GetActorLocation();
+		Entry.Rotation = Actor->GetActorQuat();
+
+		// Same components as the Visibility trace this replaces: only the colliding ones.
+		FVector Origin;
+		FVector Extent;
+		Actor->GetActorBounds(true, Origin, Extent);
+		Entry.Depth = FVector::Dist(ViewLocation, Origin);
+
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			const FVector CornerLocation = Origin + Extent * FVector((Corner & 1) ? 1.f : -1.f, (Corner & 2) ? 1.f : -1.f, (Corner & 4) ? 1.f : -1.f);
+			FVector2D ScreenLocation;
+			if (PC.ProjectWorldLocationToScreen(CornerLocation, ScreenLocation, false))
+			{
+				Entry.Rect += ScreenLocation;
+			}
+		}
+		if (!Entry.Rect.bIsValid || ViewportSize.X <= 0 || ViewportSize.Y <= 0)
+		{
+			continue;
+		}
+
+		const int32 MinCellX = FMath::Clamp(FMath::FloorToInt32(Entry.Rect.Min.X * GridSize / ViewportSize.X), 0, GridSize - 1);
+		const int32 MaxCellX = FMath::Clamp(FMath::FloorToInt32(Entry.Rect.Max.X * GridSize / ViewportSize.X), 0, GridSize - 1);
+		const int32 MinCellY = FMath::Clamp(FMath::FloorToInt32(Entry.Rect.Min.Y * GridSize / ViewportSize.Y), 0, GridSize - 1);
+		const int32 MaxCellY = FMath::Clamp(FMath::FloorToInt32(Entry.Rect.Max.Y * GridSize / ViewportSize.Y), 0, GridSize - 1);
+		for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+		{
+			for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+			{
+				Cells[CellY * GridSize + CellX] |= FMask(1) << Slot;
+			}
+		}
+	}
+}
+
+void FScreenTargetPicker::GetView(const APlayerController& PC, FVector& OutLocation, FRotator& OutRotation, float& OutFOV, FIntPoint& OutViewportSize)
+{
+	PC.GetPlayerViewPoint(OutLocation, OutRotation);
+	OutFOV = PC.PlayerCameraManager ? PC.PlayerCameraManager->GetFOVAngle() : 0.f;
+
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	PC.GetViewportSize(SizeX, SizeY);
+	OutViewportSize = FIntPoint(SizeX, SizeY);
+}
@@ -0,0 +1,51 @@
+#include "Combat/SkillPreview.h"
+#include "Manager/SkillData.h"
+#include "Manager/StatComponent.h"
+
+#define LOCTEXT_NAMESPACE "SkillPreview"
+
+FText FSkillPreview::ToText() const
+{
+	FNumberFormattingOptions Options;
+	Options.MaximumFractionalDigits = 0;
+
+	TArray<FText> Parts;
+	if (HasDamage())
+	{
+		const FText Min = FText::AsNumber(FMath::FloorToFloat(MinDamage), &Options);
+		const FText Max = FText::AsNumber(FMath::FloorToFloat(MaxDamage), &Options);
+		Parts.Add(bWeaknessHit
+			? FText::Format(LOCTEXT("WeakDamage", "{0}-{1} damage (weak)"), Min, Max)
+			: FText::Format(LOCTEXT("Damage", "{0}-{1} damage"), Min, Max));
+	}
+	if (HasHealing())
+	{
+		const FText Min = FText::AsNumber(FMath::FloorToFloat(MinHealing), &Options);
+		const FText Max = FText::AsNumber(FMath::FloorToFloat(MaxHealing), &Options);
+		Parts.Add(MinHealing == MaxHealing
+			? FText::Format(LOCTEXT("Heal", "+{0} HP"), Min)
+			: FText::Format(LOCTEXT("HealRange", "+{0}-{1} HP"), Min, Max));
+	}
+	return FText::Join(FText::FromString(TEXT(", ")), Parts);
+}
+
+const FSkillPreview& FSkillPreviewCache::Get(const USkillData& Skill, const UStatComponent& Caster, const UStatComponent& Target, const FDamageTunables& Tunables)
+{
+	const FKey Key{ &Skill, &Caster, &Target };
+	FEntry* Entry = Entries.Find(Key);
+	if (Entry && Entry->CasterVersion == Caster.GetStatVersion() && Entry->TargetVersion == Target.GetStatVersion())
+	{
+		return Entry->Preview;
+	}
+
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Key);
+	}
+	Entry->CasterVersion = Caster.GetStatVersion();
+	Entry->TargetVersion = Target.GetStatVersion();
+	Skill.GetProgram().Preview(Caster, Target, Tunables, Entry->Preview);
+	return Entry->Preview;
+}
+
+#undef LOCTEXT_NAMESPACE
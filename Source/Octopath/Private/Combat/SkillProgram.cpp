@@ -0,0 +1,570 @@
+#include "Combat/SkillProgram.h"
+#include "Manager/SkillData.h"
+#include "Manager/StatComponent.h"
+#include "Combat/SkillHitResult.h"
+#include "Combat/SkillPreview.h"
+#include "Combat/CookedSkillTable.h"
+#include "Combat/CombatSnapshot.h"
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSkillProgram, Log, All);
+
+namespace SkillProgram
+{
+	/** Per-target scratch arrays of one op (no heap allocation up to 16 targets) */
+	using FTargetFloats = TArray<float, TInlineAllocator<16>>;
+
+	/** Computes the raw damage of one damage op on every recipient with a fully specialized skill pipeline. */
+	template<typename AttackTypePolicy, typename CasterType, typename RecipientType>
+	void ComputeDamageWith(const FSkillOp& Op, const CasterType& Caster, const FDamageTunables& Tunables, TArrayView<RecipientType* const> Recipients, TArrayView<const float> Variances, TArrayView<float> OutDamage)
+	{
+		using FPipeline = DamagePipeline::TSkillPipeline<AttackTypePolicy>;
+
+		// Gather the defenses once, then run the formula over flat arrays.
+		FTargetFloats Defenses;
+		Defenses.SetNumUninitialized(Recipients.Num());
+		for (int32 i = 0; i < Recipients.Num(); i++)
+		{
+			Defenses[i] = AttackTypePolicy::Defense(*Recipients[i]);
+		}
+		FPipeline::RawBatch(Caster, Op.Value, Defenses, Variances, OutDamage, Tunables);
+	}
+
+	/** Resolves the op's attack type once, then runs the specialized per-target loop. */
+	template<typename CasterType, typename RecipientType>
+	void ComputeDamage(const FSkillOp& Op, const CasterType& Caster, const FDamageTunables& Tunables, TArrayView<RecipientType* const> Recipients, TArrayView<const float> Variances, TArrayView<float> OutDamage)
+	{
+		using namespace DamagePipeline;
+		if (Op.Arg0 == static_cast<uint8>(EAttackType::Magical))
+		{
+			ComputeDamageWith<FMagicalAttack>(Op, Caster, Tunables, Recipients, Variances, OutDamage);
+		}
+		else
+		{
+			ComputeDamageWith<FPhysicalAttack>(Op, Caster, Tunables, Recipients, Variances, OutDamage);
+		}
+	}
+
+	/** Multiplier the target applies to incoming damage (defending, broken) */
+	float IncomingDamageScale(const UStatComponent& Target)
+	{
+		return Target.GetDerivedStat(EDerivedStat::IncomingDamageScale);
+	}
+
+	float IncomingDamageScale(const FCombatantSnapshot& Target)
+	{
+		return Target.GetIncomingDamageScale();
+	}
+
+	/** Sums an array (totals reported by Execute). */
+	float Sum(TArrayView<const float> Values)
+	{
+		float Total = 0.f;
+		for (const float Value : Values)
+		{
+			Total += Value;
+		}
+		return Total;
+	}
+
+	/** Fills the caster and skill variables shared by every target of a formula op. */
+	template<typename StatsType>
+	void SetFormulaVariables(FFormulaVariables& Variables, const StatsType& Caster, float SkillDamage, float SkillModifierValue, float TechniqueCost)
+	{
+		Variables.SetCaster(Caster);
+		Variables.Set(EFormulaVariable::SkillDamage, SkillDamage);
+		Variables.Set(EFormulaVariable::SkillModifierValue, SkillModifierValue);
+		Variables.Set(EFormulaVariable::SkillTechniqueCost, TechniqueCost);
+	}
+
+	/** Compiles one designer formula, logging errors (the built-in formula is used when it does not compile). */
+	void CompileFormula(FCompiledFormula& Formula, const FString& Source, const FString& SkillName, const TCHAR* FormulaName)
+	{
+		Formula.Reset();
+		if (Source.TrimStartAndEnd().IsEmpty())
+		{
+			return;
+		}
+		FString Error;
+		if (!Formula.Compile(Source, &Error))
+		{
+			UE_LOG(LogSkillProgram, Error, TEXT("Compile - %s of %s does not compile (%s), using the built-in formula"), FormulaName, *SkillName, *Error);
+		}
+	}
+
+	FSkillOp MakeOp(ESkillOp Code, float Value = 0.f, uint8 Arg0 = 0, uint8 Arg1 = 0, int32 IntValue = 0, bool bOnCaster = false)
+	{
+		FSkillOp Op;
+		Op.Code = Code;
+		Op.Arg0 = Arg0;
+		Op.Arg1 = Arg1;
+		Op.bOnCaster = bOnCaster ? 1 : 0;
+		Op.Value = Value;
+		Op.IntValue = IntValue;
+		return Op;
+	}
+
+	/** Appends the stat modifier and status effect carried by the skill, if any. */
+	template<typename SkillType>
+	void AddModifierOps(TArray<FSkillOp>& Ops, const SkillType& Skill, bool bOnCaster)
+	{
+		if (Skill.AffectedStat != ECombatStatType::None)
+		{
+			Ops.Add(MakeOp(ESkillOp::ApplyModifier, Skill.ModifierValue, static_cast<uint8>(Skill.AffectedStat), static_cast<uint8>(Skill.ModifierType), Skill.Duration, bOnCaster));
+		}
+		if (Skill.StatusEffect != EStatusEffectType::None)
+		{
+			Ops.Add(MakeOp(ESkillOp::ApplyStatusEffect, Skill.StatusEffectMagnitude, static_cast<uint8>(Skill.StatusEffect), 0, Skill.StatusEffectDuration, bOnCaster));
+		}
+	}
+}
+
+void FSkillProgram::Compile(const USkillData& Skill)
+{
+	CompileFrom(Skill, Skill.SkillName.ToString(), Skill.DamageFormula, Skill.HealFormula);
+}
+
+void FSkillProgram::Compile(const FCookedSkillTable& Table, const FCookedSkillRecord& Record)
+{
+	CompileFrom(Record, Table.GetString(Record.SkillName), Table.GetString(Record.DamageFormula), Table.GetString(Record.HealFormula));
+}
+
+template<typename SkillType>
+void FSkillProgram::CompileFrom(const SkillType& Skill, const FString& InDebugName, const FString& DamageFormulaSource, const FString& HealFormulaSource)
+{
+	using namespace SkillProgram;
+
+	Ops.Reset();
+	TechniqueCost = Skill.TechniqueCost;
+	DebugName = InDebugName;
+	SkillDamage = Skill.Damage;
+	SkillModifierValue = Skill.ModifierValue;
+
+	CompileFormula(DamageFormula, DamageFormulaSource, DebugName, TEXT("DamageFormula"));
+	CompileFormula(HealFormula, HealFormulaSource, DebugName, TEXT("HealFormula"));
+
+	if (Skill.TechniqueCost > 0.f)
+	{
+		Ops.Add(MakeOp(ESkillOp::SpendTechniquePoints, Skill.TechniqueCost));
+	}
+
+	switch (Skill.AbilityCategory)
+	{
+	case EAbilityCategory::Offensive:
+		Ops.Add(MakeOp(ESkillOp::RollVariance));
+		Ops.Add(MakeOp(ESkillOp::Damage, Skill.Damage, static_cast<uint8>(Skill.AttackType)));
+		if (Skill.DamageTypeMask != 0)
+		{
+			Ops.Add(MakeOp(ESkillOp::ShieldHit, 0.f, static_cast<uint8>(FMath::Clamp(Skill.ShieldDamage, 0, 255)), 0, Skill.DamageTypeMask));
+		}
+		// Offensive skills may also debuff or afflict the targets they hit.
+		AddModifierOps(Ops, Skill, false);
+		break;
+
+	case EAbilityCategory::Heal:
+		Ops.Add(MakeOp(ESkillOp::Heal, Skill.Damage));
+		AddModifierOps(Ops, Skill, false);
+		break;
+
+	case EAbilityCategory::Buff:
+	case EAbilityCategory::Debuff:
+		AddModifierOps(Ops, Skill, Skill.TargetType == ETargetType::Self);
+		break;
+
+	default:
+		UE_LOG(LogSkillProgram, Warning, TEXT("Compile - Ability category of %s is not implemented, the skill only spends technique points"), *DebugName);
+		break;
+	}
+}
+
+bool FSkillProgram::CanExecute(const UStatComponent& Caster) const
+{
+	// A silenced caster cannot use skills.
+	if (Caster.HasStatusEffect(EStatusEffectType::Silence))
+	{
+		UE_LOG(LogSkillProgram, Warning, TEXT("Caster is silenced and cannot use %s"), *DebugName);
+		return false;
+	}
+
+	// Check if the caster has enough Technique Points to use the skill.
+	if (Caster.TechniquePoints < TechniqueCost)
+	{
+		UE_LOG(LogSkillProgram, Warning, TEXT("Not enough Technique Points to use %s"), *DebugName);
+		return false;
+	}
+	return true;
+}
+
+float FSkillProgram::Execute(const FSkillExecutionContext& Context) const
+{
+	check(Context.Caster);
+	UStatComponent& Caster = *Context.Caster;
+	if (!CanExecute(Caster))
+	{
+		return 0.f;
+	}
+
+	float TotalEffect = 0.f;
+	const int32 NumTargets = Context.Targets.Num();
+
+	// One variance multiplier per target, filled by RollVariance.
+	SkillProgram::FTargetFloats Variances;
+	Variances.Init(1.f, NumTargets);
+
+	// Per-target scratch reused by the damage and heal ops.
+	SkillProgram::FTargetFloats Amounts;
+	SkillProgram::FTargetFloats Applied;
+
+	TArray<FSkillHitResult>* Results = Context.OutResults;
+	if (Results)
+	{
+		Results->SetNum(NumTargets);
+		for (int32 i = 0; i < NumTargets; i++)
+		{
+			(*Results)[i] = FSkillHitResult();
+			(*Results)[i].Target = Context.Targets[i]->GetOwner();
+		}
+	}
+
+	for (const FSkillOp& Op : Ops)
+	{
+		TArrayView<UStatComponent* const> Recipients = Op.bOnCaster ? TArrayView<UStatComponent* const>(&Context.Caster, 1) : Context.Targets;
+
+		switch (Op.Code)
+		{
+		case ESkillOp::SpendTechniquePoints:
+			Caster.UseTechniquePoints(Op.Value);
+			break;
+
+		case ESkillOp::RollVariance:
+			for (float& Variance : Variances)
+			{
+				Variance = DamagePipeline::FRandomVariance::Roll(Context.Random, Context.Tunables);
+			}
+			break;
+
+		case ESkillOp::Damage:
+		{
+			// Compute every outcome first, then write all health values in one batch.
+			Amounts.SetNumUninitialized(Recipients.Num());
+			Applied.SetNumUninitialized(Recipients.Num());
+			if (DamageFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				for (int32 i = 0; i < Recipients.Num(); i++)
+				{
+					Variables.SetTarget(*Recipients[i]);
+					Variables.Set(EFormulaVariable::Variance, Variances[i]);
+					Amounts[i] = FMath::Max(DamageFormula.Evaluate(Variables), Context.Tunables.MinimumDamage);
+				}
+			}
+			else
+			{
+				// The side and the attack type are resolved once per op; the per-target loop is specialized.
+				SkillProgram::ComputeDamage(Op, Caster, Context.Tunables, Recipients, Variances, Amounts);
+			}
+
+			UStatComponent::ApplyDamageBatch(Recipients, Amounts, Applied);
+			const float OpDamage = SkillProgram::Sum(Amounts);
+			TotalEffect += OpDamage;
+			UE_LOG(LogSkillProgram, Log, TEXT("%s dealt %.2f damage to %d target(s)"), *DebugName, OpDamage, Recipients.Num());
+
+			if (Results && !Op.bOnCaster)
+			{
+				for (int32 i = 0; i < NumTargets; i++)
+				{
+					(*Results)[i].Damage += Applied[i];
+				}
+			}
+			break;
+		}
+
+		case ESkillOp::Heal:
+		{
+			Amounts.Init(Op.Value, Recipients.Num());
+			Applied.SetNumUninitialized(Recipients.Num());
+			if (HealFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				for (int32 i = 0; i < Recipients.Num(); i++)
+				{
+					Variables.SetTarget(*Recipients[i]);
+					Amounts[i] = FMath::Max(HealFormula.Evaluate(Variables), 0.f);
+				}
+			}
+
+			UStatComponent::HealBatch(Recipients, Amounts, Applied);
+			// Convention: negative result represents healing.
+			TotalEffect -= SkillProgram::Sum(Amounts);
+
+			if (Results && !Op.bOnCaster)
+			{
+				for (int32 i = 0; i < NumTargets; i++)
+				{
+					(*Results)[i].Healing += Applied[i];
+				}
+			}
+			break;
+		}
+
+		case ESkillOp::ApplyModifier:
+			for (UStatComponent* Target : Recipients)
+			{
+				Target->ApplyStatModifier(static_cast<ECombatStatType>(Op.Arg0), Op.Value, static_cast<EModifierType>(Op.Arg1), Op.IntValue);
+				TotalEffect += Op.Value;
+			}
+			break;
+
+		case ESkillOp::ApplyStatusEffect:
+			for (UStatComponent* Target : Recipients)
+			{
+				Target->ApplyStatusEffect(static_cast<EStatusEffectType>(Op.Arg0), Op.Value, Op.IntValue);
+			}
+			break;
+
+		case ESkillOp::ShieldHit:
+		{
+			const bool bReportBreaks = Results && !Op.bOnCaster;
+			TBitArray<TInlineAllocator<4>> WasBroken;
+			if (bReportBreaks)
+			{
+				WasBroken.Init(false, NumTargets);
+				for (int32 i = 0; i < NumTargets; i++)
+				{
+					WasBroken[i] = Recipients[i]->IsBroken();
+				}
+			}
+
+			const int32 NumBroken = UStatComponent::ApplyShieldHits(Recipients, Op.IntValue, Op.Arg0);
+			UE_LOG(LogSkillProgram, Log, TEXT("%s broke %d target(s)"), *DebugName, NumBroken);
+
+			if (bReportBreaks)
+			{
+				for (int32 i = 0; i < NumTargets; i++)
+				{
+					(*Results)[i].bWeaknessHit |= Recipients[i]->IsWeakTo(Op.IntValue);
+					(*Results)[i].bBroken |= !WasBroken[i] && Recipients[i]->IsBroken();
+				}
+			}
+			break;
+		}
+
+		default:
+			checkNoEntry();
+			break;
+		}
+	}
+
+	if (Results)
+	{
+		for (int32 i = 0; i < NumTargets; i++)
+		{
+			(*Results)[i].RemainingHealth = Context.Targets[i]->Health;
+			(*Results)[i].bDefeated = Context.Targets[i]->Health <= 0.f;
+		}
+	}
+
+	return TotalEffect;
+}
+
+float FSkillProgram::Simulate(FCombatSnapshot& State, int32 CasterSlot, TConstArrayView<int32> TargetSlots, FRandomStream& Random, const FDamageTunables& Tunables) const
+{
+	FCombatantSnapshot* const Caster = &State.Combatants[CasterSlot];
+	// Same checks as CanExecute.
+	if (Caster->HasStatusEffect(EStatusEffectType::Silence) || Caster->TechniquePoints < TechniqueCost)
+	{
+		return 0.f;
+	}
+
+	TArray<FCombatantSnapshot*, TInlineAllocator<16>> Targets;
+	for (const int32 Slot : TargetSlots)
+	{
+		Targets.Add(&State.Combatants[Slot]);
+	}
+
+	float TotalEffect = 0.f;
+	SkillProgram::FTargetFloats Variances;
+	Variances.Init(1.f, Targets.Num());
+	SkillProgram::FTargetFloats Amounts;
+
+	// Mirrors Execute op by op; any change there must be reflected here or speculation stops matching.
+	for (const FSkillOp& Op : Ops)
+	{
+		TArrayView<FCombatantSnapshot* const> Recipients = Op.bOnCaster ? TArrayView<FCombatantSnapshot* const>(&Caster, 1) : TArrayView<FCombatantSnapshot* const>(Targets);
+
+		switch (Op.Code)
+		{
+		case ESkillOp::SpendTechniquePoints:
+			Caster->UseTechniquePoints(Op.Value);
+			break;
+
+		case ESkillOp::RollVariance:
+			for (float& Variance : Variances)
+			{
+				Variance = DamagePipeline::FRandomVariance::Roll(&Random, Tunables);
+			}
+			break;
+
+		case ESkillOp::Damage:
+		{
+			Amounts.SetNumUninitialized(Recipients.Num());
+			if (DamageFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, *Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				for (int32 i = 0; i < Recipients.Num(); i++)
+				{
+					Variables.SetTarget(*Recipients[i]);
+					Variables.Set(EFormulaVariable::Variance, Variances[i]);
+					Amounts[i] = FMath::Max(DamageFormula.Evaluate(Variables), Tunables.MinimumDamage);
+				}
+			}
+			else
+			{
+				// The side and the attack type are resolved once per op; the per-target loop is specialized.
+				SkillProgram::ComputeDamage(Op, *Caster, Tunables, Recipients, Variances, Amounts);
+			}
+
+			// Same write as UStatComponent::ApplyDamageBatch.
+			for (int32 i = 0; i < Recipients.Num(); i++)
+			{
+				Recipients[i]->ApplyDamage(Amounts[i]);
+			}
+			TotalEffect += SkillProgram::Sum(Amounts);
+			break;
+		}
+
+		case ESkillOp::Heal:
+		{
+			Amounts.Init(Op.Value, Recipients.Num());
+			if (HealFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, *Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				for (int32 i = 0; i < Recipients.Num(); i++)
+				{
+					Variables.SetTarget(*Recipients[i]);
+					Amounts[i] = FMath::Max(HealFormula.Evaluate(Variables), 0.f);
+				}
+			}
+
+			for (int32 i = 0; i < Recipients.Num(); i++)
+			{
+				Recipients[i]->Heal(Amounts[i]);
+			}
+			TotalEffect -= SkillProgram::Sum(Amounts);
+			break;
+		}
+
+		case ESkillOp::ApplyModifier:
+			for (FCombatantSnapshot* Target : Recipients)
+			{
+				Target->ApplyStatModifier(static_cast<ECombatStatType>(Op.Arg0), Op.Value, static_cast<EModifierType>(Op.Arg1), Op.IntValue);
+				TotalEffect += Op.Value;
+			}
+			break;
+
+		case ESkillOp::ApplyStatusEffect:
+			for (FCombatantSnapshot* Target : Recipients)
+			{
+				Target->ApplyStatusEffect(static_cast<EStatusEffectType>(Op.Arg0), Op.Value, Op.IntValue);
+			}
+			break;
+
+		case ESkillOp::ShieldHit:
+			for (FCombatantSnapshot* Target : Recipients)
+			{
+				Target->ApplyShieldHit(Op.IntValue, Op.Arg0);
+			}
+			break;
+
+		default:
+			checkNoEntry();
+			break;
+		}
+	}
+
+	return TotalEffect;
+}
+
+void FSkillProgram::Preview(const UStatComponent& Caster, const UStatComponent& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const
+{
+	PreviewFrom(Caster, Target, Tunables, OutPreview);
+}
+
+void FSkillProgram::Preview(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const
+{
+	PreviewFrom(Caster, Target, Tunables, OutPreview);
+}
+
+template<typename StatsType>
+void FSkillProgram::PreviewFrom(const StatsType& Caster, const StatsType& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const
+{
+	OutPreview = FSkillPreview();
+
+	// Both ends of the variance range go through the same formulas as Execute, as a two-element batch.
+	const float Variances[2] = { Tunables.VarianceMin, Tunables.VarianceMax };
+	const StatsType* const Recipients[2] = { &Target, &Target };
+	float Amounts[2];
+
+	for (const FSkillOp& Op : Ops)
+	{
+		if (Op.bOnCaster)
+		{
+			continue;
+		}
+
+		switch (Op.Code)
+		{
+		case ESkillOp::Damage:
+		{
+			if (DamageFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				Variables.SetTarget(Target);
+				for (int32 i = 0; i < 2; i++)
+				{
+					Variables.Set(EFormulaVariable::Variance, Variances[i]);
+					Amounts[i] = FMath::Max(DamageFormula.Evaluate(Variables), Tunables.MinimumDamage);
+				}
+			}
+			else
+			{
+				// The side and the attack type are resolved once per op; the per-target loop is specialized.
+				SkillProgram::ComputeDamage(Op, Caster, Tunables, MakeArrayView(Recipients), MakeArrayView(Variances), MakeArrayView(Amounts));
+			}
+
+			// The target scales what it takes (defending, broken), as in UStatComponent::ApplyDamageBatch.
+			const float IncomingScale = SkillProgram::IncomingDamageScale(Target);
+			OutPreview.MinDamage += FMath::Min(Amounts[0], Amounts[1]) * IncomingScale;
+			OutPreview.MaxDamage += FMath::Max(Amounts[0], Amounts[1]) * IncomingScale;
+			break;
+		}
+
+		case ESkillOp::Heal:
+		{
+			float Amount = Op.Value;
+			if (HealFormula.IsValid())
+			{
+				FFormulaVariables Variables;
+				SkillProgram::SetFormulaVariables(Variables, Caster, SkillDamage, SkillModifierValue, TechniqueCost);
+				Variables.SetTarget(Target);
+				Amount = FMath::Max(HealFormula.Evaluate(Variables), 0.f);
+			}
+			OutPreview.MinHealing += Amount;
+			OutPreview.MaxHealing += Amount;
+			break;
+		}
+
+		case ESkillOp::ShieldHit:
+			OutPreview.bWeaknessHit |= Target.IsWeakTo(Op.IntValue);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
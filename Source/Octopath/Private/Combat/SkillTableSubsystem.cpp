@@ -0,0 +1,61 @@
+#include "Combat/SkillTableSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSkillTable, Log, All);
+
+USkillTableSubsystem* USkillTableSubsystem::ActiveSubsystem = nullptr;
+
+void USkillTableSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	Reload();
+	ActiveSubsystem = this;
+}
+
+void USkillTableSubsystem::Deinitialize()
+{
+	if (ActiveSubsystem == this)
+	{
+		ActiveSubsystem = nullptr;
+	}
+	Programs.Empty();
+	Table.Reset();
+	Super::Deinitialize();
+}
+
+bool USkillTableSubsystem::Reload()
+{
+	Programs.Reset();
+	if (!Table.LoadFromFile(FCookedSkillTable::GetDefaultFilename()))
+	{
+		return false;
+	}
+
+	Programs.Reserve(Table.Num());
+	for (const FCookedSkillRecord& Record : Table.GetRecords())
+	{
+		Programs.Add(Record.SkillId).Compile(Table, Record);
+	}
+	return true;
+}
+
+const FSkillProgram* USkillTableSubsystem::FindProgram(const USkillData& Skill) const
+{
+	const FCookedSkillRecord* Record = FindSkill(&Skill);
+	if (!Record)
+	{
+		return nullptr;
+	}
+
+	if (Record->ContentHash != Skill.GetContentHash())
+	{
+		UE_LOG(LogSkillTable, Verbose, TEXT("FindProgram - The cooked record of %s is stale, using the asset (rebuild with -run=SkillTable)"), *Skill.GetName());
+		return nullptr;
+	}
+	return Programs.Find(Record->SkillId);
+}
+
+const FSkillProgram* USkillTableSubsystem::FindActiveProgram(const USkillData& Skill)
+{
+	check(IsInGameThread());
+	return ActiveSubsystem ? ActiveSubsystem->FindProgram(Skill) : nullptr;
+}
@@ -0,0 +1,159 @@
+#include "Combat/StatusEffectSubsystem.h"
+#include "Manager/StatComponent.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStatusEffects, Log, All);
+
+void UStatusEffectSubsystem::ReservePools(int32 MaxCombatants)
+{
+	for (int32 Type = 1; Type < NumEffectTypes; Type++)
+	{
+		Pools[Type].Reserve(MaxCombatants);
+	}
+}
+
+void UStatusEffectSubsystem::ApplyEffect(UStatComponent* Target, EStatusEffectType EffectType, float Magnitude, int32 DurationTurns)
+{
+	if (!IsValid(Target) || EffectType == EStatusEffectType::None || EffectType == EStatusEffectType::Count || DurationTurns <= 0)
+	{
+		return;
+	}
+
+	TArray<FStatusEffectInstance>& Pool = Pools[static_cast<int32>(EffectType)];
+
+	// Refresh an existing instance rather than stacking a second one.
+	for (FStatusEffectInstance& Instance : Pool)
+	{
+		if (Instance.Target.Get() == Target)
+		{
+			Instance.Magnitude = Magnitude;
+			Instance.RemainingTurns = FMath::Max(Instance.RemainingTurns, DurationTurns);
+			return;
+		}
+	}
+
+	FStatusEffectInstance& NewInstance = Pool.AddDefaulted_GetRef();
+	NewInstance.Target = Target;
+	NewInstance.Magnitude = Magnitude;
+	NewInstance.RemainingTurns = DurationTurns;
+	SetTargetFlag(Target, EffectType, true);
+
+	UE_LOG(LogStatusEffects, Log, TEXT("ApplyEffect - %s applied to %s for %d rounds"),
+		*UEnum::GetValueAsString(EffectType), *Target->EntityName.ToString(), DurationTurns);
+}
+
+void UStatusEffectSubsystem::RemoveAllEffects(UStatComponent* Target)
+{
+	for (int32 Type = 1; Type < NumEffectTypes; Type++)
+	{
+		TArray<FStatusEffectInstance>& Pool = Pools[Type];
+		for (int32 i = Pool.Num() - 1; i >= 0; i--)
+		{
+			if (Pool[i].Target.Get() == Target)
+			{
+				Pool.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			}
+		}
+		SetTargetFlag(Target, static_cast<EStatusEffectType>(Type), false);
+	}
+}
+
+void UStatusEffectSubsystem::ProcessRoundEnd()
+{
+	// --- Ticking effects ---
+	for (const FStatusEffectInstance& Instance : Pools[static_cast<int32>(EStatusEffectType::Poison)])
+	{
+		if (UStatComponent* Target = Instance.Target.Get())
+		{
+			Target->ApplyDamage(Instance.Magnitude, false);
+		}
+	}
+	for (const FStatusEffectInstance& Instance : Pools[static_cast<int32>(EStatusEffectType::Regen)])
+	{
+		if (UStatComponent* Target = Instance.Target.Get())
+		{
+			Target->Heal(Instance.Magnitude);
+		}
+	}
+
+	// --- Durations (every pool but Stun, one pass each; see ConsumeStunnedTurn) ---
+	for (int32 Type = 1; Type < NumEffectTypes; Type++)
+	{
+		if (Type == static_cast<int32>(EStatusEffectType::Stun))
+		{
+			continue;
+		}
+		TArray<FStatusEffectInstance>& Pool = Pools[Type];
+		for (int32 i = Pool.Num() - 1; i >= 0; i--)
+		{
+			FStatusEffectInstance& Instance = Pool[i];
+			UStatComponent* Target = Instance.Target.Get();
+			if (!Target || --Instance.RemainingTurns <= 0)
+			{
+				SetTargetFlag(Target, static_cast<EStatusEffectType>(Type), false);
+				Pool.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+void UStatusEffectSubsystem::ConsumeStunnedTurn(UStatComponent* Target)
+{
+	TArray<FStatusEffectInstance>& Pool = Pools[static_cast<int32>(EStatusEffectType::Stun)];
+	for (int32 i = Pool.Num() - 1; i >= 0; i--)
+	{
+		if (Pool[i].Target.Get() == Target && --Pool[i].RemainingTurns <= 0)
+		{
+			SetTargetFlag(Target, EStatusEffectType::Stun, false);
+			Pool.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			UE_LOG(LogStatusEffects, Log, TEXT("ConsumeStunnedTurn - Stun expired on %s"), *Target->EntityName.ToString());
+		}
+	}
+}
+
+void UStatusEffectSubsystem::ResetPools()
+{
+	for (int32 Type = 1; Type < NumEffectTypes; Type++)
+	{
+		for (const FStatusEffectInstance& Instance : Pools[Type])
+		{
+			SetTargetFlag(Instance.Target.Get(), static_cast<EStatusEffectType>(Type), false);
+		}
+		Pools[Type].Reset();
+	}
+}
+
+const FStatusEffectInstance* UStatusEffectSubsystem::FindEffect(const UStatComponent* Target, EStatusEffectType EffectType) const
+{
+	for (const FStatusEffectInstance& Instance : GetPool(EffectType))
+	{
+		if (Instance.Target.Get() == Target)
+		{
+			return &Instance;
+		}
+	}
+	return nullptr;
+}
+
+const TArray<FStatusEffectInstance>& UStatusEffectSubsystem::GetPool(EStatusEffectType EffectType) const
+{
+	const int32 Index = static_cast<int32>(EffectType);
+	check(Index >= 0 && Index < NumEffectTypes);
+	return Pools[Index];
+}
+
+void UStatusEffectSubsystem::SetTargetFlag(UStatComponent* Target, EStatusEffectType EffectType, bool bActive)
+{
+	if (!Target)
+	{
+		return;
+	}
+	const uint8 Bit = static_cast<uint8>(1u << static_cast<uint32>(EffectType));
+	if (bActive)
+	{
+		Target->StatusEffectFlags |= Bit;
+	}
+	else
+	{
+		Target->StatusEffectFlags &= ~Bit;
+	}
+}
@@ -0,0 +1,65 @@
+#include "Combat/TargetRing.h"
+#include "Combat/ScreenTargetPicker.h"
+
+void FTargetRing::Build(FMask InCandidates, const FScreenTargetPicker& Picker)
+{
+	Reset();
+	Candidates = InCandidates;
+	bBuilt = true;
+
+	struct FOrderedSlot
+	{
+		int32 Slot;
+		FVector2D Center;
+		bool bOnScreen;
+	};
+	TArray<FOrderedSlot, TInlineAllocator<8>> Ordered;
+	for (FMask Mask = Candidates; Mask != 0; Mask &= Mask - 1)
+	{
+		FOrderedSlot& Entry = Ordered.AddDefaulted_GetRef();
+		Entry.Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		Entry.bOnScreen = Picker.GetScreenCenter(Entry.Slot, Entry.Center);
+	}
+
+	Ordered.StableSort([](const FOrderedSlot& A, const FOrderedSlot& B)
+		{
+			if (A.bOnScreen != B.bOnScreen)
+			{
+				return A.bOnScreen;
+			}
+			if (!A.bOnScreen)
+			{
+				return false;
+			}
+			return A.Center.X != B.Center.X ? A.Center.X < B.Center.X : A.Center.Y < B.Center.Y;
+		});
+
+	for (const FOrderedSlot& Entry : Ordered)
+	{
+		RingIndices[Entry.Slot] = static_cast<int8>(Slots.Add(Entry.Slot));
+	}
+}
+
+void FTargetRing::Reset()
+{
+	Slots.Reset();
+	FMemory::Memset(RingIndices, static_cast<uint8>(INDEX_NONE), sizeof(RingIndices));
+	Candidates = 0;
+	bBuilt = false;
+}
+
+int32 FTargetRing::Step(int32 CurrentSlot, int32 Direction) const
+{
+	const int32 Num = Slots.Num();
+	if (Num == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Current = (CurrentSlot >= 0 && CurrentSlot < FCombatTargetCache::MaxSlots) ? RingIndices[CurrentSlot] : INDEX_NONE;
+	if (Current == INDEX_NONE)
+	{
+		return Direction >= 0 ? Slots[0] : Slots[Num - 1];
+	}
+	return Slots[((Current + Direction) % Num + Num) % Num];
+}
@@ -0,0 +1,28 @@
+#include "Enemy/EnemyAIProfile.h"
+#include "Curves/CurveFloat.h"
+
+float UEnemyAIProfile::Evaluate(EUtilityConsideration Consideration, float Input) const
+{
+	const FUtilityCurve* Utility = nullptr;
+	switch (Consideration)
+	{
+	case EUtilityConsideration::ExpectedDamage:
+		Utility = &ExpectedDamage;
+		break;
+	case EUtilityConsideration::KillChance:
+		Utility = &KillChance;
+		break;
+	case EUtilityConsideration::HealNeed:
+		Utility = &HealNeed;
+		break;
+	case EUtilityConsideration::BuffUptime:
+		Utility = &BuffUptime;
+		break;
+	default:
+		return 0.f;
+	}
+
+	const float ClampedInput = FMath::Clamp(Input, 0.f, 1.f);
+	const float Output = Utility->Curve ? Utility->Curve->GetFloatValue(ClampedInput) : ClampedInput;
+	return Output * Utility->Weight;
+}
@@ -1,6 +1,8 @@
 #include "Enemy/EnemyAbilityComponent.h"
 #include "Manager/StatComponent.h"
 #include "Manager/SkillData.h"
+#include "Combat/CombatRandomSubsystem.h"
+#include "Combat/CombatBalance.h"
 
 UEnemyAbilityComponent::UEnemyAbilityComponent()
 {
@@ -27,6 +29,16 @@ float UEnemyAbilityComponent::ExecuteDefaultAttack()
 }
 
 float UEnemyAbilityComponent::ExecuteSkill(USkillData* Skill)
+{
+	TArray<AActor*> Targets;
+	if (Skill && Skill->TargetType == ETargetType::Self && GetOwner())
+	{
+		Targets.Add(GetOwner());
+	}
+	return ExecuteSkillOnTargets(Skill, Targets);
+}
+
+float UEnemyAbilityComponent::ExecuteSkillOnTargets(USkillData* Skill, const TArray<AActor*>& Targets)
 {
 	if (!Skill)
 	{
@@ -45,41 +57,35 @@ float UEnemyAbilityComponent::ExecuteSkill(USkillData* Skill)
 		return 0.f;
 	}
 
-	float Result = 0.f;
-	switch (Skill->AbilityCategory)
+	// Gather the stats of the valid targets.
+	TArray<UStatComponent*, TInlineAllocator<8>> TargetStats;
+	for (AActor* Target : Targets)
 	{
-	case EAbilityCategory::Offensive:
-	{
-		float BaseDamage = Skill->Damage;
-		if (Skill->AttackType == EAttackType::Physical)
+		if (!IsValid(Target))
 		{
-			BaseDamage += StatComp->PhysicalAttack;
+			continue;
 		}
-		else
+		if (UStatComponent* TargetStat = Target->FindComponentByClass<UStatComponent>())
 		{
-			BaseDamage += StatComp->MagicalAttack;
+			TargetStats.Add(TargetStat);
 		}
-		StatComp->UseTechniquePoints(Skill->TechniqueCost);
-		Result = BaseDamage;
-		break;
-	}
-	case EAbilityCategory::Heal:
-	{
-		float HealAmount = Skill->Damage;
-		StatComp->UseTechniquePoints(Skill->TechniqueCost);
-		Result = -HealAmount;
-		break;
-	}
-	case EAbilityCategory::Buff:
-	case EAbilityCategory::Debuff:
-	{
-		StatComp->ApplyStatModifier(Skill->AffectedStat, Skill->ModifierValue, Skill->ModifierType, Skill->Duration);
-		StatComp->UseTechniquePoints(Skill->TechniqueCost);
-		Result = Skill->ModifierValue;
-		break;
 	}
-	default:
-		break;
-	}
-	return Result;
+
+	FSkillExecutionContext Context;
+	Context.Caster = StatComp;
+	Context.Targets = TargetStats;
+	Context.Random = UCombatRandomSubsystem::GetStream(this);
+	Context.Tunables = GetDamageTunables();
+
+	return Skill->GetProgram().Execute(Context);
+}
+
+FEnemyAction UEnemyAbilityComponent::ChooseAction(const FCombatSnapshot& Snapshot, int32 SelfSlot) const
+{
+	return FEnemyUtilityAI::Decide(Snapshot, SelfSlot, Skills, AIProfile, GetDamageTunables());
+}
+
+const FDamageTunables& UEnemyAbilityComponent::GetDamageTunables() const
+{
+	return FCombatBalance::Get().EnemyDamage;
 }
@@ -0,0 +1,78 @@
+#include "Enemy/EnemyBenchFixture.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Manager/SkillData.h"
+
+namespace EnemyBenchFixture
+{
+	TArray<USkillData*> MakeSkills(int32 NumSkills)
+	{
+		TArray<USkillData*> Skills;
+		for (int32 i = 0; i < NumSkills; i++)
+		{
+			USkillData* Skill = NewObject<USkillData>(GetTransientPackage());
+			Skill->Damage = 30.f + 5.f * i;
+			Skill->TechniqueCost = 10.f * (i % 4);
+			Skill->AttackType = (i % 2) ? EAttackType::Magical : EAttackType::Physical;
+			Skill->TargetMode = static_cast<ETargetMode>(i % 4);
+			Skill->TargetType = ETargetType::Enemy;
+			Skill->AbilityCategory = EAbilityCategory::Offensive;
+			Skill->Duration = 0;
+			if (i % 5 == 3)
+			{
+				Skill->AbilityCategory = EAbilityCategory::Heal;
+				Skill->TargetMode = ETargetMode::Single;
+				Skill->TargetType = ETargetType::Self;
+			}
+			else if (i % 5 == 4)
+			{
+				Skill->AbilityCategory = EAbilityCategory::Buff;
+				Skill->TargetType = ETargetType::Ally;
+				Skill->AffectedStat = ECombatStatType::PhysicalAttack;
+				Skill->ModifierValue = 10.f;
+				Skill->ModifierType = EModifierType::Percentage;
+				Skill->Duration = 3;
+			}
+			Skill->CompileProgram();
+			Skills.Add(Skill);
+		}
+		return Skills;
+	}
+
+	TArray<FUtilitySkill> MakeUtilitySkills(int32 NumSkills)
+	{
+		TArray<FUtilitySkill> Skills;
+		for (const USkillData* Skill : MakeSkills(NumSkills))
+		{
+			Skills.Emplace(*Skill);
+		}
+		return Skills;
+	}
+
+	void MakeSnapshot(int32 NumCombatants, FCombatSnapshot& OutSnapshot)
+	{
+		FMemory::Memzero(OutSnapshot);
+		OutSnapshot.NumCombatants = NumCombatants;
+		OutSnapshot.NumTurns = NumCombatants;
+		OutSnapshot.CurrentTurnIndex = 0;
+		OutSnapshot.RandomInitialSeed = OutSnapshot.RandomSeed = 1234;
+		for (int32 Slot = 0; Slot < NumCombatants; Slot++)
+		{
+			FCombatantSnapshot& Combatant = OutSnapshot.Combatants[Slot];
+			Combatant.MaxHealth = Combatant.Health = 400.f;
+			Combatant.MaxTechniquePoints = 100.f;
+			Combatant.TechniquePoints = 60.f;
+			Combatant.PhysicalAttack = Combatant.BasePhysicalAttack = 50.f;
+			Combatant.MagicalAttack = Combatant.BaseMagicalAttack = 45.f;
+			Combatant.PhysicalDefense = Combatant.BasePhysicalDefense = 20.f;
+			Combatant.MagicalDefense = Combatant.BaseMagicalDefense = 15.f;
+			Combatant.Speed = Combatant.BaseSpeed = 100.f - Slot;
+			Combatant.BrokenDamageMultiplier = 1.5f;
+			Combatant.bIsPlayer = (Slot == 0);
+			OutSnapshot.TurnOrder[Slot] = static_cast<int8>(Slot);
+		}
+	}
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,452 @@
+#include "Enemy/EnemyLookahead.h"
+#include "Enemy/EnemyAIProfile.h"
+#include "Enemy/EnemyBenchFixture.h"
+#include "Combat/SkillPreview.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyLookahead, Log, All);
+
+namespace EnemyLookahead
+{
+	using FMask = FEnemyUtilityAI::FMask;
+	using FActionList = TArray<FEnemyAction, TInlineAllocator<32>>;
+
+	/** Positions in the variance range sampled by chance nodes, equally likely (the roll is uniform) */
+	constexpr float VarianceSamples[] = { 0.f, 0.5f, 1.f };
+
+	bool IsSameSide(const FCombatantSnapshot& A, const FCombatantSnapshot& B)
+	{
+		return (A.bIsPlayer != 0) == (B.bIsPlayer != 0);
+	}
+
+	bool CanAct(const FCombatantSnapshot& Combatant)
+	{
+		// Same rule as UTurnBasedCombatComponent::ShouldSkipTurn.
+		return Combatant.IsAlive() && !Combatant.IsBroken() && !Combatant.HasStatusEffect(EStatusEffectType::Stun);
+	}
+
+	bool HasDamage(const FSkillProgram& Program)
+	{
+		return Program.GetOps().ContainsByPredicate([](const FSkillOp& Op) { return Op.Code == ESkillOp::Damage && !Op.bOnCaster; });
+	}
+
+	/** Sorts the turns from First to the end of the queue by decreasing Speed (as NextTurn and EndRound do). */
+	void SortTurns(FCombatSnapshot& State, int32 First)
+	{
+		if (First >= State.NumTurns)
+		{
+			return;
+		}
+		// Same algorithm and predicate as the TArray<AActor*>::Sort in NextTurn, so ties resolve the same way.
+		TArrayView<int8>(State.TurnOrder + First, State.NumTurns - First).Sort([&State](int8 A, int8 B)
+			{
+				return State.Combatants[A].Speed > State.Combatants[B].Speed;
+			});
+	}
+
+	/** Same end of round as UTurnBasedCombatComponent::EndRound: ticks, then a new queue of the living combatants. */
+	void EndRound(FCombatSnapshot& State)
+	{
+		State.NumTurns = 0;
+		for (int32 Slot = 0; Slot < State.NumCombatants; Slot++)
+		{
+			FCombatantSnapshot& Combatant = State.Combatants[Slot];
+			Combatant.DecrementStatModifiers();
+			Combatant.ProcessBreakRoundEnd();
+			Combatant.ProcessStatusEffectsRoundEnd();
+			if (Combatant.IsAlive())
+			{
+				State.TurnOrder[State.NumTurns++] = static_cast<int8>(Slot);
+			}
+		}
+		State.CurrentTurnIndex = 0;
+		SortTurns(State, 0);
+	}
+
+	/** Moves the queue to the next combatant able to act, across round ends. */
+	void AdvanceTurn(FCombatSnapshot& State)
+	{
+		// Bounded: at worst every queued combatant of this round and the next one is skipped.
+		for (int32 Step = 0; Step < 2 * FCombatSnapshot::MaxCombatants; Step++)
+		{
+			if (++State.CurrentTurnIndex >= State.NumTurns)
+			{
+				EndRound(State);
+			}
+			else
+			{
+				SortTurns(State, State.CurrentTurnIndex);
+			}
+			if (State.NumTurns == 0)
+			{
+				return;
+			}
+			FCombatantSnapshot& Next = State.Combatants[State.TurnOrder[State.CurrentTurnIndex]];
+			if (CanAct(Next))
+			{
+				return;
+			}
+			// Same as UTurnBasedCombatComponent::ConsumeSkippedTurn.
+			Next.ConsumeStunnedTurn();
+		}
+	}
+
+	/** Appends every action the combatant in a slot can take (mirrors FEnemyUtilityAI::Decide). */
+	void EnumerateActions(const FCombatSnapshot& State, int32 Slot, TConstArrayView<FUtilitySkill> Skills, FActionList& OutActions)
+	{
+		for (FMask Mask = FEnemyUtilityAI::GetOpponents(State, Slot); Mask != 0; Mask &= Mask - 1)
+		{
+			FEnemyAction& Action = OutActions.AddDefaulted_GetRef();
+			Action.TargetSlot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		}
+
+		const FCombatantSnapshot& Caster = State.Combatants[Slot];
+		const int32 NumSkills = Caster.HasStatusEffect(EStatusEffectType::Silence) ? 0 : Skills.Num();
+		for (int32 SkillIndex = 0; SkillIndex < NumSkills; SkillIndex++)
+		{
+			const FUtilitySkill& Skill = Skills[SkillIndex];
+			if (Caster.TechniquePoints < Skill.TechniqueCost)
+			{
+				continue;
+			}
+			const FMask Targets = FEnemyUtilityAI::GetValidTargets(State, Slot, Skill.TargetType, Skill.AbilityCategory);
+			if (Targets == 0)
+			{
+				continue;
+			}
+			if (Skill.TargetMode == ETargetMode::All || Skill.TargetMode == ETargetMode::Random)
+			{
+				FEnemyAction& Action = OutActions.AddDefaulted_GetRef();
+				Action.SkillIndex = SkillIndex;
+				continue;
+			}
+			for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+			{
+				FEnemyAction& Action = OutActions.AddDefaulted_GetRef();
+				Action.SkillIndex = SkillIndex;
+				Action.TargetSlot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			}
+		}
+	}
+
+	/**
+	 * Applies one action to a state with a fixed variance position (0: lowest roll, 1: highest).
+	 * Damage and healing come from FSkillProgram::Preview, so they follow the same formulas as the live cast.
+	 */
+	void ApplyAction(FCombatSnapshot& State, int32 ActorSlot, const FUtilitySkill* Skill, FMask Targets, float VarianceAlpha, const FDamageTunables& Tunables)
+	{
+		FCombatantSnapshot& Caster = State.Combatants[ActorSlot];
+		if (!Skill)
+		{
+			for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+			{
+				FCombatantSnapshot& Target = State.Combatants[FMath::CountTrailingZeros64(Mask)];
+				Target.ApplyDamage(FEnemyUtilityAI::DefaultAttackDamage(Caster, Target, Tunables));
+			}
+			return;
+		}
+
+		// Outcomes are computed on the state before the cast, then written (as the live batch does).
+		FSkillPreview Previews[FCombatSnapshot::MaxCombatants];
+		for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+		{
+			const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			Skill->Program.Preview(Caster, State.Combatants[Slot], Tunables, Previews[Slot]);
+		}
+
+		for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+		{
+			const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			FCombatantSnapshot& Target = State.Combatants[Slot];
+			const FSkillPreview& Preview = Previews[Slot];
+			if (Preview.HasDamage())
+			{
+				// The preview already includes the target's defending and break multipliers.
+				const float Damage = FMath::Lerp(Preview.MinDamage, Preview.MaxDamage, VarianceAlpha);
+				Target.Health = FMath::Clamp(Target.Health - Damage, 0.f, Target.GetHealthClampMax());
+			}
+			if (Preview.HasHealing())
+			{
+				Target.Heal(FMath::Lerp(Preview.MinHealing, Preview.MaxHealing, VarianceAlpha));
+			}
+		}
+
+		for (const FSkillOp& Op : Skill->Program.GetOps())
+		{
+			if (Op.Code == ESkillOp::SpendTechniquePoints)
+			{
+				Caster.UseTechniquePoints(Op.Value);
+				continue;
+			}
+
+			const FMask Recipients = Op.bOnCaster ? FMask(1) << ActorSlot : Targets;
+			for (FMask Mask = Recipients; Mask != 0; Mask &= Mask - 1)
+			{
+				FCombatantSnapshot& Recipient = State.Combatants[FMath::CountTrailingZeros64(Mask)];
+				switch (Op.Code)
+				{
+				case ESkillOp::ApplyModifier:
+					Recipient.ApplyStatModifier(static_cast<ECombatStatType>(Op.Arg0), Op.Value, static_cast<EModifierType>(Op.Arg1), Op.IntValue);
+					break;
+				case ESkillOp::ApplyStatusEffect:
+					Recipient.ApplyStatusEffect(static_cast<EStatusEffectType>(Op.Arg0), Op.Value, Op.IntValue);
+					break;
+				case ESkillOp::ShieldHit:
+					Recipient.ApplyShieldHit(Op.IntValue, Op.Arg0);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	/** Depth-first expectimax from one worker thread */
+	struct FSearch
+	{
+		const FLookaheadRequest& Request;
+		double Deadline;
+		std::atomic<bool>& bOutOfTime;
+		int32 NumNodes = 0;
+
+		bool IsOutOfTime()
+		{
+			if (bOutOfTime.load(std::memory_order_relaxed))
+			{
+				return true;
+			}
+			// Reading the clock on every node would cost more than the node itself.
+			if ((NumNodes & 31) == 0 && FPlatformTime::Seconds() > Deadline)
+			{
+				bOutOfTime.store(true, std::memory_order_relaxed);
+				return true;
+			}
+			return false;
+		}
+
+		/** Value of a state for the searcher: damage taken by its opponents minus damage taken by its side. */
+		float Evaluate(const FCombatSnapshot& State) const
+		{
+			const FCombatantSnapshot& Searcher = State.Combatants[Request.SearcherSlot];
+			float Value = 0.f;
+			for (int32 Slot = 0; Slot < State.NumCombatants; Slot++)
+			{
+				const FCombatantSnapshot& Combatant = State.Combatants[Slot];
+				if (Combatant.MaxHealth <= 0.f)
+				{
+					continue;
+				}
+				// A defeat weighs as much as a second full health bar.
+				const float Loss = 1.f - Combatant.Health / Combatant.MaxHealth + (Combatant.IsAlive() ? 0.f : 1.f);
+				Value += IsSameSide(Combatant, Searcher) ? -Loss : Loss;
+			}
+			return Value;
+		}
+
+		bool IsOver(const FCombatSnapshot& State) const
+		{
+			return State.NumTurns == 0 || !State.Combatants[Request.SearcherSlot].IsAlive() || FEnemyUtilityAI::GetOpponents(State, Request.SearcherSlot) == 0;
+		}
+
+		float Expectimax(const FCombatSnapshot& State, int32 Depth)
+		{
+			if (IsOutOfTime())
+			{
+				return 0.f;
+			}
+			NumNodes++;
+			if (Depth <= 0 || IsOver(State))
+			{
+				return Evaluate(State);
+			}
+
+			const int32 ActorSlot = State.TurnOrder[State.CurrentTurnIndex];
+			if (ActorSlot == Request.SearcherSlot)
+			{
+				FActionList Actions;
+				EnumerateActions(State, ActorSlot, Request.Skills[ActorSlot], Actions);
+				float Best = Actions.Num() > 0 ? -MAX_flt : Evaluate(State);
+				for (const FEnemyAction& Action : Actions)
+				{
+					Best = FMath::Max(Best, ActionValue(State, ActorSlot, Action, Depth));
+				}
+				return Best;
+			}
+
+			// Everyone else is predicted with the cheap policy and their own profile instead of being branched on.
+			const FEnemyAction Action = FEnemyUtilityAI::Decide(State, ActorSlot, Request.Skills[ActorSlot], Request.Profiles[ActorSlot], Request.Tunables[ActorSlot]);
+			return ActionValue(State, ActorSlot, Action, Depth);
+		}
+
+		/** Expected value of taking an action: average over the variance samples and random targets. */
+		float ActionValue(const FCombatSnapshot& State, int32 ActorSlot, const FEnemyAction& Action, int32 Depth)
+		{
+			const FUtilitySkill* Skill = Request.Skills[ActorSlot].IsValidIndex(Action.SkillIndex) ? &Request.Skills[ActorSlot][Action.SkillIndex] : nullptr;
+
+			FMask Targets = 0;
+			bool bRandomTarget = false;
+			if (Action.TargetSlot != INDEX_NONE)
+			{
+				Targets = FMask(1) << Action.TargetSlot;
+			}
+			else if (Skill)
+			{
+				Targets = FEnemyUtilityAI::GetValidTargets(State, ActorSlot, Skill->TargetType, Skill->AbilityCategory);
+				bRandomTarget = (Skill->TargetMode == ETargetMode::Random);
+			}
+
+			const int32 NumVarianceSamples = (Skill && HasDamage(Skill->Program)) ? UE_ARRAY_COUNT(VarianceSamples) : 1;
+			float Sum = 0.f;
+			int32 NumOutcomes = 0;
+
+			FMask TargetOutcomes = bRandomTarget ? Targets : 1;
+			for (; TargetOutcomes != 0; TargetOutcomes &= TargetOutcomes - 1)
+			{
+				const FMask OutcomeTargets = bRandomTarget ? (TargetOutcomes & ~(TargetOutcomes - 1)) : Targets;
+				for (int32 Sample = 0; Sample < NumVarianceSamples; Sample++)
+				{
+					FCombatSnapshot Child;
+					Child.CopyFrom(State);
+					const float Alpha = (NumVarianceSamples > 1) ? VarianceSamples[Sample] : 0.5f;
+					ApplyAction(Child, ActorSlot, Skill, OutcomeTargets, Alpha, Request.Tunables[ActorSlot]);
+					AdvanceTurn(Child);
+					Sum += Expectimax(Child, Depth - 1);
+					NumOutcomes++;
+				}
+			}
+			return NumOutcomes > 0 ? Sum / NumOutcomes : Evaluate(State);
+		}
+	};
+}
+
+FLookaheadResult FEnemyLookahead::Search(const FLookaheadRequest& Request, double Deadline)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	FLookaheadResult Result;
+
+	const FCombatSnapshot& Root = Request.Root;
+	if (Request.SearcherSlot < 0 || Request.SearcherSlot >= Root.NumCombatants
+		|| Request.Skills.Num() < Root.NumCombatants || Request.Tunables.Num() < Root.NumCombatants || Request.Profiles.Num() < Root.NumCombatants)
+	{
+		return Result;
+	}
+
+	EnemyLookahead::FActionList Actions;
+	EnemyLookahead::EnumerateActions(Root, Request.SearcherSlot, Request.Skills[Request.SearcherSlot], Actions);
+	if (Actions.Num() == 0)
+	{
+		return Result;
+	}
+
+	std::atomic<bool> bOutOfTime = false;
+	std::atomic<int32> NumNodes = 0;
+	TArray<float, TInlineAllocator<32>> Values;
+	Values.SetNumZeroed(Actions.Num());
+
+	for (int32 Depth = 1; Depth <= Request.MaxDepth; Depth++)
+	{
+		ParallelFor(Actions.Num(), [&](int32 Index)
+			{
+				EnemyLookahead::FSearch SearchState{ Request, Deadline, bOutOfTime };
+				Values[Index] = SearchState.ActionValue(Root, Request.SearcherSlot, Actions[Index], Depth);
+				NumNodes.fetch_add(SearchState.NumNodes, std::memory_order_relaxed);
+			});
+
+		// An interrupted depth is discarded: its values mix complete and truncated subtrees.
+		if (bOutOfTime.load())
+		{
+			break;
+		}
+
+		int32 BestIndex = 0;
+		for (int32 Index = 1; Index < Actions.Num(); Index++)
+		{
+			if (Values[Index] > Values[BestIndex])
+			{
+				BestIndex = Index;
+			}
+		}
+		Result.Action = Actions[BestIndex];
+		Result.Action.Score = Values[BestIndex];
+		Result.CompletedDepth = Depth;
+	}
+
+	Result.NumNodes = NumNodes.load();
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
+
+void FEnemyLookahead::Start(FLookaheadRequest&& Request)
+{
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> NewState = MakeShared<FSharedState, ESPMode::ThreadSafe>();
+	NewState->Request = MoveTemp(Request);
+	NewState->Deadline = FPlatformTime::Seconds() + NewState->Request.BudgetSeconds;
+	for (const UEnemyAIProfile* Profile : NewState->Request.Profiles)
+	{
+		NewState->ProfileReferences.Emplace(Profile);
+	}
+	State = NewState;
+
+	// The task keeps its own reference: Reset() or a new Start() never wait for it.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [NewState]()
+		{
+			NewState->Result = Search(NewState->Request, NewState->Deadline);
+			NewState->bDone.store(true, std::memory_order_release);
+		});
+}
+
+bool FEnemyLookahead::TryGetResult(FLookaheadResult& OutResult) const
+{
+	if (!State.IsValid() || !State->bDone.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	OutResult = State->Result;
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.Lookahead [BudgetMs] [MaxDepth] [Enemies]
+ *
+ * Builds a synthetic combat (one player, a boss and N-1 enemies, four transient skills each) and logs how deep
+ * one lookahead search of the boss gets within the budget.
+ */
+static FAutoConsoleCommand GEnemyLookaheadBenchmarkCommand(
+	TEXT("Octopath.Bench.Lookahead"),
+	TEXT("Times one boss lookahead search. Usage: Octopath.Bench.Lookahead [BudgetMs] [MaxDepth] [Enemies]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const float BudgetMs = Args.Num() > 0 ? FMath::Max(0.1f, FCString::Atof(*Args[0])) : 5.f;
+			const int32 MaxDepth = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 8) : 4;
+			const int32 NumEnemies = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, FCombatSnapshot::MaxCombatants - 1) : 3;
+
+			const TArray<FUtilitySkill> Skills = EnemyBenchFixture::MakeUtilitySkills(4);
+
+			FLookaheadRequest Request;
+			EnemyBenchFixture::MakeSnapshot(NumEnemies + 1, Request.Root);
+			for (int32 Slot = 0; Slot < Request.Root.NumCombatants; Slot++)
+			{
+				// The boss acts first.
+				Request.Root.TurnOrder[Slot] = static_cast<int8>((Slot + 1) % Request.Root.NumCombatants);
+				Request.Skills.Add(Skills);
+				Request.Tunables.Add(FDamageTunables::Get());
+				Request.Profiles.Add(GetDefault<UEnemyAIProfile>());
+			}
+			FCombatantSnapshot& Boss = Request.Root.Combatants[1];
+			Boss.MaxHealth = Boss.Health = 2000.f;
+			Boss.bIsBoss = true;
+			Request.SearcherSlot = 1;
+			Request.MaxDepth = MaxDepth;
+			Request.BudgetSeconds = BudgetMs / 1000.0;
+
+			const FLookaheadResult Result = FEnemyLookahead::Search(Request, FPlatformTime::Seconds() + Request.BudgetSeconds);
+			UE_LOG(LogEnemyLookahead, Display, TEXT("Lookahead (%d combatants, budget %.1f ms): depth %d/%d, %d nodes in %.2f ms, best skill %d on slot %d (value %f)"),
+				Request.Root.NumCombatants, BudgetMs, Result.CompletedDepth, MaxDepth, Result.NumNodes, Result.ElapsedSeconds * 1000.0,
+				Result.Action.SkillIndex, Result.Action.TargetSlot, Result.Action.Score);
+		}));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,345 @@
+#include "Enemy/EnemySpeculation.h"
+#include "Enemy/EnemyAIProfile.h"
+#include "Enemy/EnemyBenchFixture.h"
+#include "Combat/CombatTargetCache.h"
+#include "Tasks/Task.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemySpeculation, Log, All);
+
+namespace EnemySpeculation
+{
+	using FMask = FEnemyUtilityAI::FMask;
+
+	/** Targets UTurnBasedCombatComponent::OnAbilitySelected preselects for All and Random skills (DefaultAbilityTargets) */
+	FMask GetDefaultAbilityTargets(const FCombatSnapshot& State, int32 PlayerSlot, const FUtilitySkill& Skill)
+	{
+		if (FCombatTargetCache::TargetsCaster(Skill.TargetType))
+		{
+			return 0;
+		}
+		return FEnemyUtilityAI::GetValidTargets(State, PlayerSlot, Skill.TargetType, Skill.AbilityCategory);
+	}
+
+	bool CanAfford(const FCombatantSnapshot& Player, const FUtilitySkill& Skill)
+	{
+		// Same rule as FCombatTargetCache::RefreshAffordableSkills (a silenced cast is simulated as a no-op).
+		return Player.TechniquePoints >= Skill.TechniqueCost;
+	}
+
+	/** Applies the player's action as ExecutePlayerDefaultAttack, OnAbilityCastingTimelineFinished and OnPlayerDefense do. */
+	void ApplyPlayerAction(const FSpeculationRequest& Request, const FSpeculatedPlayerAction& Action, FCombatSnapshot& State)
+	{
+		FRandomStream Random = State.MakeRandomStream();
+		FCombatantSnapshot& Player = State.Combatants[Request.PlayerSlot];
+		const FDamageTunables& Tunables = Request.Tunables[Request.PlayerSlot];
+
+		switch (Action.Type)
+		{
+		case FSpeculatedPlayerAction::EType::DefaultAttack:
+		{
+			// Same value as FDerivedCombatStats::BasicAttackDamage.
+			FCombatantSnapshot& Target = State.Combatants[Action.TargetSlot];
+			using FMitigation = DamagePipeline::FBasicAttackMitigation;
+			const float Damage = FMitigation::Output(Player.PhysicalAttack, Tunables) - FMitigation::Reduction(Target.PhysicalDefense, Tunables);
+			Target.ApplyDamage(FMath::Max(Damage, Tunables.MinimumDamage));
+			Target.ApplyShieldHit(Request.PlayerBasicAttackDamageTypeMask, 1);
+			break;
+		}
+
+		case FSpeculatedPlayerAction::EType::Skill:
+		{
+			const FUtilitySkill& Skill = Request.Skills[Request.PlayerSlot][Action.SkillIndex];
+			TArray<int32, TInlineAllocator<16>> Targets;
+			if (Action.TargetSlot != INDEX_NONE)
+			{
+				Targets.Add(Action.TargetSlot);
+			}
+			else
+			{
+				for (FMask Mask = GetDefaultAbilityTargets(State, Request.PlayerSlot, Skill); Mask != 0; Mask &= Mask - 1)
+				{
+					Targets.Add(static_cast<int32>(FMath::CountTrailingZeros64(Mask)));
+				}
+				if (Skill.TargetMode == ETargetMode::Random && Targets.Num() > 0)
+				{
+					const int32 Picked = Targets[Random.RandRange(0, Targets.Num() - 1)];
+					Targets.Reset();
+					Targets.Add(Picked);
+				}
+			}
+			Skill.Program.Simulate(State, Request.PlayerSlot, Targets, Random, Tunables);
+			break;
+		}
+
+		case FSpeculatedPlayerAction::EType::Defend:
+			Player.bIsDefending = 1;
+			State.bPlayerDefendedThisRound = 1;
+			State.bDefenseConsumed = 0;
+			break;
+		}
+
+		State.StoreRandomStream(Random);
+	}
+}
+
+void FEnemySpeculation::EnumeratePlayerActions(const FSpeculationRequest& Request, TArray<FSpeculatedPlayerAction>& OutActions)
+{
+	using namespace EnemySpeculation;
+
+	OutActions.Reset();
+	const FCombatSnapshot& Root = Request.Root;
+	if (Request.PlayerSlot < 0 || Request.PlayerSlot >= Root.NumCombatants)
+	{
+		return;
+	}
+
+	FSpeculatedPlayerAction Action;
+	Action.Type = FSpeculatedPlayerAction::EType::DefaultAttack;
+	for (FMask Mask = FEnemyUtilityAI::GetOpponents(Root, Request.PlayerSlot); Mask != 0; Mask &= Mask - 1)
+	{
+		Action.TargetSlot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+		OutActions.Add(Action);
+	}
+
+	const FCombatantSnapshot& Player = Root.Combatants[Request.PlayerSlot];
+	const TArray<FUtilitySkill>& Skills = Request.Skills[Request.PlayerSlot];
+	Action.Type = FSpeculatedPlayerAction::EType::Skill;
+	for (int32 SkillIndex = 0; SkillIndex < Skills.Num(); SkillIndex++)
+	{
+		const FUtilitySkill& Skill = Skills[SkillIndex];
+		if (!CanAfford(Player, Skill))
+		{
+			continue;
+		}
+
+		Action.SkillIndex = SkillIndex;
+		if (Skill.TargetMode == ETargetMode::All || Skill.TargetMode == ETargetMode::Random)
+		{
+			Action.TargetSlot = INDEX_NONE;
+			OutActions.Add(Action);
+			continue;
+		}
+		for (FMask Mask = FEnemyUtilityAI::GetValidTargets(Root, Request.PlayerSlot, Skill.TargetType, Skill.AbilityCategory); Mask != 0; Mask &= Mask - 1)
+		{
+			Action.TargetSlot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			OutActions.Add(Action);
+		}
+	}
+
+	Action = FSpeculatedPlayerAction();
+	Action.Type = FSpeculatedPlayerAction::EType::Defend;
+	OutActions.Add(Action);
+}
+
+bool FEnemySpeculation::PredictEnemyTurn(const FSpeculationRequest& Request, const FSpeculatedPlayerAction& Action, FSpeculatedDecision& OutDecision)
+{
+	const FCombatSnapshot& Root = Request.Root;
+	if (Request.PlayerSlot < 0 || Request.PlayerSlot >= Root.NumCombatants
+		|| Request.Skills.Num() < Root.NumCombatants || Request.Tunables.Num() < Root.NumCombatants || Request.Profiles.Num() < Root.NumCombatants)
+	{
+		return false;
+	}
+
+	FCombatSnapshot& State = OutDecision.State;
+	State.CopyFrom(Root);
+	EnemySpeculation::ApplyPlayerAction(Request, Action, State);
+
+	// Same steps as NextTurn: the rest of the queue is re-sorted by Speed, then stunned and broken combatants are skipped.
+	TArray<int32, TInlineAllocator<FCombatSnapshot::MaxCombatants>> Queue;
+	for (int32 Index = 0; Index < Root.NumTurns; Index++)
+	{
+		Queue.Add(Root.TurnOrder[Index]);
+	}
+	int32 TurnIndex = Root.CurrentTurnIndex;
+	for (;;)
+	{
+		if (++TurnIndex >= Queue.Num())
+		{
+			return false;
+		}
+
+		// Same algorithm and predicate as the TArray<AActor*>::Sort in NextTurn, so ties resolve the same way.
+		TArrayView<int32>(Queue).Slice(TurnIndex, Queue.Num() - TurnIndex).Sort([&State](int32 A, int32 B)
+			{
+				return State.Combatants[A].Speed > State.Combatants[B].Speed;
+			});
+
+		FCombatantSnapshot& Next = State.Combatants[Queue[TurnIndex]];
+		if (!Next.HasStatusEffect(EStatusEffectType::Stun) && !Next.IsBroken())
+		{
+			break;
+		}
+		Next.ConsumeStunnedTurn();
+	}
+
+	const int32 RootEnemySlot = Queue[TurnIndex];
+	if (State.Combatants[RootEnemySlot].bIsPlayer || !Request.Profiles[RootEnemySlot])
+	{
+		return false;
+	}
+
+	// CaptureSnapshot will list the combatants in queue order.
+	const FCombatSnapshot Simulated = State;
+	for (int32 Slot = 0; Slot < Queue.Num(); Slot++)
+	{
+		State.Combatants[Slot] = Simulated.Combatants[Queue[Slot]];
+		State.TurnOrder[Slot] = static_cast<int8>(Slot);
+		OutDecision.RootSlots[Slot] = static_cast<int8>(Queue[Slot]);
+	}
+	State.CurrentTurnIndex = TurnIndex;
+	OutDecision.EnemySlot = TurnIndex;
+	return true;
+}
+
+bool FEnemySpeculation::Speculate(const FSpeculationRequest& Request, const FSpeculatedPlayerAction& Action, FSpeculatedDecision& OutDecision)
+{
+	if (!PredictEnemyTurn(Request, Action, OutDecision))
+	{
+		return false;
+	}
+
+	const int32 EnemySlot = OutDecision.EnemySlot;
+	const int32 RootEnemySlot = OutDecision.RootSlots[EnemySlot];
+	const UEnemyAIProfile* Profile = Request.Profiles[RootEnemySlot];
+	OutDecision.Action = FEnemyUtilityAI::Decide(OutDecision.State, EnemySlot, Request.Skills[RootEnemySlot], Profile, Request.Tunables[RootEnemySlot]);
+	OutDecision.Lookahead = FLookaheadResult();
+
+	// Same search as the live boss turn, with the same budget.
+	if (OutDecision.State.Combatants[EnemySlot].bIsBoss && Profile->LookaheadDepth > 0)
+	{
+		FLookaheadRequest Lookahead;
+		Lookahead.Root.CopyFrom(OutDecision.State);
+		Lookahead.SearcherSlot = EnemySlot;
+		Lookahead.MaxDepth = Profile->LookaheadDepth;
+		Lookahead.BudgetSeconds = Profile->LookaheadBudgetMs / 1000.0;
+		for (int32 Slot = 0; Slot < OutDecision.State.NumCombatants; Slot++)
+		{
+			Lookahead.Skills.Add(Request.Skills[OutDecision.RootSlots[Slot]]);
+			Lookahead.Tunables.Add(Request.Tunables[OutDecision.RootSlots[Slot]]);
+			// Slots without a profile never choose a skill (or are the player) and are predicted with the default one.
+			Lookahead.Profiles.Add(Request.Profiles[OutDecision.RootSlots[Slot]]);
+		}
+		OutDecision.Lookahead = FEnemyLookahead::Search(Lookahead, FPlatformTime::Seconds() + Lookahead.BudgetSeconds);
+	}
+	return true;
+}
+
+void FEnemySpeculation::Start(FSpeculationRequest&& Request)
+{
+	Reset();
+
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> NewState = MakeShared<FSharedState, ESPMode::ThreadSafe>();
+	NewState->Request = MoveTemp(Request);
+	for (const UEnemyAIProfile* Profile : NewState->Request.Profiles)
+	{
+		NewState->ProfileReferences.Emplace(Profile);
+	}
+
+	TArray<FSpeculatedPlayerAction> Actions;
+	EnumeratePlayerActions(NewState->Request, Actions);
+	for (const FSpeculatedPlayerAction& Action : Actions)
+	{
+		NewState->Branches.Add_GetRef(MakeUnique<FBranch>())->Action = Action;
+	}
+	State = NewState;
+
+	// Each task keeps its own reference: Reset() or a new Start() never wait for them.
+	for (int32 Index = 0; Index < NewState->Branches.Num(); Index++)
+	{
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [NewState, Index]()
+			{
+				FBranch& Branch = *NewState->Branches[Index];
+				if (!NewState->bCancelled.load(std::memory_order_relaxed))
+				{
+					Branch.bHasDecision = Speculate(NewState->Request, Branch.Action, Branch.Decision);
+				}
+				Branch.bDone.store(true, std::memory_order_release);
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+	UE_LOG(LogEnemySpeculation, Verbose, TEXT("Start - %d player actions speculated"), NewState->Branches.Num());
+}
+
+bool FEnemySpeculation::TryGetDecision(const FCombatSnapshot& LiveState, TConstArrayView<int32> LiveRootSlots, FSpeculatedDecision& OutDecision) const
+{
+	if (!State.IsValid() || LiveRootSlots.Num() != LiveState.NumCombatants)
+	{
+		return false;
+	}
+
+	for (const TUniquePtr<FBranch>& Branch : State->Branches)
+	{
+		if (!Branch->bDone.load(std::memory_order_acquire) || !Branch->bHasDecision)
+		{
+			continue;
+		}
+
+		const FSpeculatedDecision& Decision = Branch->Decision;
+		bool bSameCombatants = Decision.State.NumCombatants == LiveState.NumCombatants;
+		for (int32 Slot = 0; bSameCombatants && Slot < LiveState.NumCombatants; Slot++)
+		{
+			bSameCombatants = Decision.RootSlots[Slot] == LiveRootSlots[Slot];
+		}
+		if (bSameCombatants && Decision.State.IsIdentical(LiveState))
+		{
+			OutDecision = Decision;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FEnemySpeculation::Reset()
+{
+	if (State.IsValid())
+	{
+		State->bCancelled.store(true, std::memory_order_relaxed);
+		State.Reset();
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.Speculation [Enemies]
+ *
+ * Builds a synthetic combat (the player acting first, N enemies, four transient skills each) and logs how many
+ * branches one player turn opens and how long deciding all of them takes on the calling thread.
+ */
+static FAutoConsoleCommand GEnemySpeculationBenchmarkCommand(
+	TEXT("Octopath.Bench.Speculation"),
+	TEXT("Times the speculative enemy decisions of one player turn. Usage: Octopath.Bench.Speculation [Enemies]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 NumEnemies = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, FCombatSnapshot::MaxCombatants - 1) : 4;
+
+			const TArray<FUtilitySkill> Skills = EnemyBenchFixture::MakeUtilitySkills(4);
+
+			FSpeculationRequest Request;
+			EnemyBenchFixture::MakeSnapshot(NumEnemies + 1, Request.Root);
+			for (int32 Slot = 0; Slot < Request.Root.NumCombatants; Slot++)
+			{
+				Request.Skills.Add(Skills);
+				Request.Tunables.Add(FDamageTunables::Get());
+				Request.Profiles.Add(Slot == 0 ? nullptr : GetDefault<UEnemyAIProfile>());
+			}
+			Request.PlayerSlot = 0;
+
+			TArray<FSpeculatedPlayerAction> Actions;
+			FEnemySpeculation::EnumeratePlayerActions(Request, Actions);
+
+			int32 NumDecided = 0;
+			FSpeculatedDecision Decision;
+			const double StartTime = FPlatformTime::Seconds();
+			for (const FSpeculatedPlayerAction& Action : Actions)
+			{
+				NumDecided += FEnemySpeculation::Speculate(Request, Action, Decision) ? 1 : 0;
+			}
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			UE_LOG(LogEnemySpeculation, Display, TEXT("Speculation (%d combatants): %d player actions, %d decisions in %.3f ms (%.2f us per branch)"),
+				Request.Root.NumCombatants, Actions.Num(), NumDecided, ElapsedMs, Actions.Num() > 0 ? ElapsedMs * 1000.0 / Actions.Num() : 0.0);
+		}));
+
+#endif
@@ -50,6 +50,10 @@ void AEnemyTrigger::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent,
             {
                 //GI->NumberOfEnemies = FMath::RandRange(1, 3);
                 GI->NumberOfEnemies = EnemiesCount;
+
+                // Start streaming the party's cast assets now so they load during the level transition.
+                GI->ReleaseSkillPreloads();
+                GI->PreloadCombatSkills({ OtherActor });
             }
 
             // Switch to the combat level
@@ -0,0 +1,301 @@
+#include "Enemy/EnemyUtilityAI.h"
+#include "Enemy/EnemyAIProfile.h"
+#include "Enemy/EnemyBenchFixture.h"
+#include "Combat/CombatSnapshot.h"
+#include "Combat/CombatTargetCache.h"
+#include "Combat/SkillPreview.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogEnemyUtilityAI, Log, All);
+
+namespace EnemyUtilityAI
+{
+	using FMask = FEnemyUtilityAI::FMask;
+
+	/** Scores a damage range against the target's remaining Health (variance is uniform between both ends). */
+	float ScoreDamage(const UEnemyAIProfile& Profile, float MinDamage, float MaxDamage, float TargetHealth)
+	{
+		const float Health = FMath::Max(TargetHealth, KINDA_SMALL_NUMBER);
+		const float Expected = 0.5f * (MinDamage + MaxDamage);
+
+		float Kill = 0.f;
+		if (MinDamage >= Health)
+		{
+			Kill = 1.f;
+		}
+		else if (MaxDamage >= Health)
+		{
+			Kill = (MaxDamage - Health) / (MaxDamage - MinDamage);
+		}
+
+		return Profile.Evaluate(EUtilityConsideration::ExpectedDamage, Expected / Health)
+			+ Profile.Evaluate(EUtilityConsideration::KillChance, Kill);
+	}
+
+	/** Share of a new modifier's duration not already covered by the same modifier on the recipient. */
+	float ModifierUptimeGain(const FCombatantSnapshot& Recipient, const FSkillOp& Op)
+	{
+		if (Op.IntValue <= 0)
+		{
+			return 0.f;
+		}
+		int32 Covered = 0;
+		for (int32 i = 0; i < Recipient.NumModifiers; i++)
+		{
+			const FModifierSnapshot& Modifier = Recipient.Modifiers[i];
+			// A buff does not refresh a debuff of the same stat and vice versa.
+			if (Modifier.AffectedStat == static_cast<ECombatStatType>(Op.Arg0) && (Modifier.ModifierValue > 0.f) == (Op.Value > 0.f))
+			{
+				Covered = FMath::Max<int32>(Covered, Modifier.RemainingTurns);
+			}
+		}
+		return 1.f - FMath::Min(static_cast<float>(Covered) / Op.IntValue, 1.f);
+	}
+
+	/** Same for a status effect (one instance per effect type). */
+	float StatusEffectUptimeGain(const FCombatantSnapshot& Recipient, const FSkillOp& Op)
+	{
+		const int32 EffectIndex = Op.Arg0;
+		if (Op.IntValue <= 0 || EffectIndex <= 0 || EffectIndex >= FCombatantSnapshot::NumStatusEffectTypes)
+		{
+			return 0.f;
+		}
+		const int32 Covered = Recipient.HasStatusEffect(static_cast<EStatusEffectType>(EffectIndex)) ? Recipient.StatusEffects[EffectIndex].RemainingTurns : 0;
+		return 1.f - FMath::Min(static_cast<float>(Covered) / Op.IntValue, 1.f);
+	}
+
+	bool IsFriendly(const FCombatantSnapshot& Combatant)
+	{
+		return Combatant.bIsPlayer != 0;
+	}
+
+	/** Living combatants on the same side as Caster (bSameSide) or on the other side. */
+	FMask SideMask(const FCombatSnapshot& Snapshot, const FCombatantSnapshot& Caster, bool bSameSide)
+	{
+		const int32 NumCombatants = FMath::Min(Snapshot.NumCombatants, FCombatSnapshot::MaxCombatants);
+		FMask Mask = 0;
+		for (int32 Slot = 0; Slot < NumCombatants; Slot++)
+		{
+			const FCombatantSnapshot& Combatant = Snapshot.Combatants[Slot];
+			if (Combatant.IsAlive() && (IsFriendly(Combatant) == IsFriendly(Caster)) == bSameSide)
+			{
+				Mask |= FMask(1) << Slot;
+			}
+		}
+		return Mask;
+	}
+}
+
+FEnemyUtilityAI::FMask FEnemyUtilityAI::GetValidTargets(const FCombatSnapshot& Snapshot, int32 CasterSlot, ETargetType TargetType, EAbilityCategory Category)
+{
+	if (CasterSlot < 0 || CasterSlot >= Snapshot.NumCombatants)
+	{
+		return 0;
+	}
+	const FCombatantSnapshot& Caster = Snapshot.Combatants[CasterSlot];
+	if (FCombatTargetCache::TargetsCaster(TargetType))
+	{
+		return Caster.IsAlive() ? FMask(1) << CasterSlot : 0;
+	}
+	return EnemyUtilityAI::SideMask(Snapshot, Caster, TargetType != ETargetType::Enemy);
+}
+
+FEnemyUtilityAI::FMask FEnemyUtilityAI::GetOpponents(const FCombatSnapshot& Snapshot, int32 CasterSlot)
+{
+	if (CasterSlot < 0 || CasterSlot >= Snapshot.NumCombatants)
+	{
+		return 0;
+	}
+	return EnemyUtilityAI::SideMask(Snapshot, Snapshot.Combatants[CasterSlot], false);
+}
+
+float FEnemyUtilityAI::ScoreSkill(const FSkillProgram& Program, const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const UEnemyAIProfile& Profile, const FDamageTunables& Tunables)
+{
+	FSkillPreview Preview;
+	Program.Preview(Caster, Target, Tunables, Preview);
+
+	float Score = 0.f;
+	if (Preview.HasDamage())
+	{
+		Score += EnemyUtilityAI::ScoreDamage(Profile, Preview.MinDamage, Preview.MaxDamage, Target.Health);
+	}
+	if (Preview.HasHealing() && Target.MaxHealth > 0.f)
+	{
+		Score += Profile.Evaluate(EUtilityConsideration::HealNeed, 1.f - Target.Health / Target.MaxHealth);
+	}
+
+	for (const FSkillOp& Op : Program.GetOps())
+	{
+		const FCombatantSnapshot& Recipient = Op.bOnCaster ? Caster : Target;
+		if (Op.Code == ESkillOp::ApplyModifier)
+		{
+			Score += Profile.Evaluate(EUtilityConsideration::BuffUptime, EnemyUtilityAI::ModifierUptimeGain(Recipient, Op));
+		}
+		else if (Op.Code == ESkillOp::ApplyStatusEffect)
+		{
+			Score += Profile.Evaluate(EUtilityConsideration::BuffUptime, EnemyUtilityAI::StatusEffectUptimeGain(Recipient, Op));
+		}
+	}
+	return Score;
+}
+
+float FEnemyUtilityAI::ScoreDefaultAttack(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const UEnemyAIProfile& Profile, const FDamageTunables& Tunables)
+{
+	// The default attack has no variance: both ends of the range are the same.
+	using FPipeline = DamagePipeline::TBasicAttackPipeline<DamagePipeline::FPhysicalAttack>;
+	const float Damage = FPipeline::Final(Caster, Target, 0.f, 1.f, Tunables);
+	return EnemyUtilityAI::ScoreDamage(Profile, Damage, Damage, Target.Health) + Profile.DefaultAttackBias;
+}
+
+float FEnemyUtilityAI::DefaultAttackDamage(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const FDamageTunables& Tunables)
+{
+	using FPipeline = DamagePipeline::TBasicAttackPipeline<DamagePipeline::FPhysicalAttack>;
+	return FPipeline::Raw(Caster, Target, 0.f, 1.f, Tunables);
+}
+
+namespace EnemyUtilityAI
+{
+	const USkillData* AsSkill(const USkillData* Skill) { return Skill; }
+	const FUtilitySkill* AsSkill(const FUtilitySkill& Skill) { return &Skill; }
+
+	/** Shared by both Decide overloads (USkillData* and FUtilitySkill expose the same fields). */
+	template<typename SkillElementType>
+	FEnemyAction DecideFrom(const FCombatSnapshot& Snapshot, int32 CasterSlot, TConstArrayView<SkillElementType> Skills, const UEnemyAIProfile* Profile, const FDamageTunables& Tunables)
+	{
+		FEnemyAction Best;
+		if (CasterSlot < 0 || CasterSlot >= Snapshot.NumCombatants)
+		{
+			return Best;
+		}
+
+		const UEnemyAIProfile& UsedProfile = Profile ? *Profile : *GetDefault<UEnemyAIProfile>();
+		const FCombatantSnapshot& Caster = Snapshot.Combatants[CasterSlot];
+		Best.Score = -MAX_flt;
+
+		// Default attack on every opponent.
+		for (FMask Mask = FEnemyUtilityAI::GetOpponents(Snapshot, CasterSlot); Mask != 0; Mask &= Mask - 1)
+		{
+			const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+			const float Score = FEnemyUtilityAI::ScoreDefaultAttack(Caster, Snapshot.Combatants[Slot], UsedProfile, Tunables);
+			if (Score > Best.Score)
+			{
+				Best.SkillIndex = INDEX_NONE;
+				Best.TargetSlot = Slot;
+				Best.Score = Score;
+			}
+		}
+
+		// Silenced combatants can only attack.
+		const int32 NumSkills = Caster.HasStatusEffect(EStatusEffectType::Silence) ? 0 : Skills.Num();
+		for (int32 SkillIndex = 0; SkillIndex < NumSkills; SkillIndex++)
+		{
+			const auto* Skill = AsSkill(Skills[SkillIndex]);
+			if (!Skill || Caster.TechniquePoints < Skill->TechniqueCost)
+			{
+				continue;
+			}
+
+			const FMask Targets = FEnemyUtilityAI::GetValidTargets(Snapshot, CasterSlot, Skill->TargetType, Skill->AbilityCategory);
+			if (Targets == 0)
+			{
+				continue;
+			}
+
+			if (Skill->TargetMode == ETargetMode::All || Skill->TargetMode == ETargetMode::Random)
+			{
+				// All: every target is hit. Random: one of them is, each with the same probability.
+				float Sum = 0.f;
+				for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+				{
+					const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+					Sum += FEnemyUtilityAI::ScoreSkill(Skill->GetProgram(), Caster, Snapshot.Combatants[Slot], UsedProfile, Tunables);
+				}
+				const float Score = (Skill->TargetMode == ETargetMode::All)
+					? Sum * UsedProfile.AreaSkillWeight
+					: Sum / FMath::CountBits(Targets);
+				if (Score > Best.Score)
+				{
+					Best.SkillIndex = SkillIndex;
+					Best.TargetSlot = INDEX_NONE;
+					Best.Score = Score;
+				}
+				continue;
+			}
+
+			for (FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+			{
+				const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+				const float Score = FEnemyUtilityAI::ScoreSkill(Skill->GetProgram(), Caster, Snapshot.Combatants[Slot], UsedProfile, Tunables);
+				if (Score > Best.Score)
+				{
+					Best.SkillIndex = SkillIndex;
+					Best.TargetSlot = Slot;
+					Best.Score = Score;
+				}
+			}
+		}
+
+		if (Best.Score == -MAX_flt)
+		{
+			// No opponent left and nothing to cast.
+			Best.Score = 0.f;
+		}
+		return Best;
+	}
+}
+
+FEnemyAction FEnemyUtilityAI::Decide(const FCombatSnapshot& Snapshot, int32 CasterSlot, TConstArrayView<USkillData*> Skills, const UEnemyAIProfile* Profile, const FDamageTunables& Tunables)
+{
+	return EnemyUtilityAI::DecideFrom(Snapshot, CasterSlot, Skills, Profile, Tunables);
+}
+
+FEnemyAction FEnemyUtilityAI::Decide(const FCombatSnapshot& Snapshot, int32 CasterSlot, TConstArrayView<FUtilitySkill> Skills, const UEnemyAIProfile* Profile, const FDamageTunables& Tunables)
+{
+	return EnemyUtilityAI::DecideFrom(Snapshot, CasterSlot, Skills, Profile, Tunables);
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.EnemyAI [Iterations] [Enemies] [SkillsPerEnemy]
+ *
+ * Builds a synthetic combat (one player, N enemies with M transient skills each) and logs the average cost
+ * of one FEnemyUtilityAI::Decide call.
+ */
+static FAutoConsoleCommand GEnemyAIBenchmarkCommand(
+	TEXT("Octopath.Bench.EnemyAI"),
+	TEXT("Times enemy utility decisions. Usage: Octopath.Bench.EnemyAI [Iterations] [Enemies] [SkillsPerEnemy]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+			const int32 NumEnemies = FMath::Clamp(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 20, 1, FCombatSnapshot::MaxCombatants - 1);
+			const int32 NumSkills = FMath::Max(Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 10, 0);
+
+			const TArray<USkillData*> Skills = EnemyBenchFixture::MakeSkills(NumSkills);
+
+			// Varied health so the kill and heal considerations do not score alike on every slot.
+			FCombatSnapshot Snapshot;
+			EnemyBenchFixture::MakeSnapshot(NumEnemies + 1, Snapshot);
+			for (int32 Slot = 0; Slot < Snapshot.NumCombatants; Slot++)
+			{
+				FCombatantSnapshot& Combatant = Snapshot.Combatants[Slot];
+				Combatant.Health = FMath::Min(100.f + 20.f * Slot, Combatant.MaxHealth);
+			}
+
+			const FDamageTunables& Tunables = FDamageTunables::Get();
+			float Checksum = 0.f;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; i++)
+			{
+				for (int32 Slot = 1; Slot < Snapshot.NumCombatants; Slot++)
+				{
+					Checksum += FEnemyUtilityAI::Decide(Snapshot, Slot, Skills, nullptr, Tunables).Score;
+				}
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+			UE_LOG(LogEnemyUtilityAI, Display, TEXT("Enemy AI (%d enemies, %d skills each, %d iterations): %.2f us/decision (checksum %f)"),
+				NumEnemies, NumSkills, Iterations, Seconds * 1.0e6 / (static_cast<double>(Iterations) * NumEnemies), Checksum);
+		}));
+
+#endif // !UE_BUILD_SHIPPING
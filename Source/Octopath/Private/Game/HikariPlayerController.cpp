@@ -2,15 +2,29 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "InputModifiers.h"
 #include "GameFramework/Character.h"
 #include "Character/Hikari.h"
 #include "Blueprint/UserWidget.h"
 #include "Widget/PlayerTurnMenuWidget.h"
 #include "TimerManager.h"
+#include "UObject/ConstructorHelpers.h"
 
 AHikariPlayerController::AHikariPlayerController()
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	// Combat input defaults, so target selection works without BP_HikariPlayerController assigning them.
+	static ConstructorHelpers::FObjectFinder<UInputMappingContext> CombatMappingContextAsset(TEXT("/Game/Input/IMC_Combat"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> MoveMenuActionAsset(TEXT("/Game/Input/Actions/IA_MoveMenu"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> ConfirmActionAsset(TEXT("/Game/Input/Actions/IA_Interact"));
+	static ConstructorHelpers::FObjectFinder<UInputAction> CancelActionAsset(TEXT("/Game/Input/Actions/IA_Cancel"));
+	CombatMappingContext = CombatMappingContextAsset.Object;
+	MoveMenuAction = MoveMenuActionAsset.Object;
+	ConfirmAction = ConfirmActionAsset.Object;
+	CancelAction = CancelActionAsset.Object;
 }
 
 void AHikariPlayerController::BeginPlay()
@@ -22,6 +36,7 @@ void AHikariPlayerController::BeginPlay()
 	{
 		Subsystem->AddMappingContext(DefaultMappingContext, 0);
 	}
+	BuildCombatKeyboardMappings();
 
 	// By default, use GameOnly mode and hide the mouse cursor.
 	FInputModeGameOnly InputMode;
@@ -37,6 +52,20 @@ void AHikariPlayerController::SetupInputComponent()
 	{
 		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &AHikariPlayerController::HandleMove);
 		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AHikariPlayerController::HandleLook);
+
+		// Combat actions: only mapped while the combat mapping context is active.
+		if (MoveMenuAction)
+		{
+			EnhancedInputComponent->BindAction(MoveMenuAction, ETriggerEvent::Triggered, this, &AHikariPlayerController::HandleMoveMenu);
+		}
+		if (ConfirmAction)
+		{
+			EnhancedInputComponent->BindAction(ConfirmAction, ETriggerEvent::Triggered, this, &AHikariPlayerController::HandleConfirm);
+		}
+		if (CancelAction)
+		{
+			EnhancedInputComponent->BindAction(CancelAction, ETriggerEvent::Triggered, this, &AHikariPlayerController::HandleCancel);
+		}
 	}
 	else
 	{
@@ -44,6 +73,35 @@ void AHikariPlayerController::SetupInputComponent()
 	}
 }
 
+void AHikariPlayerController::BuildCombatKeyboardMappings()
+{
+	// IMC_Combat only maps the gamepad; the keyboard keys are added here instead of editing the asset.
+	CombatKeyboardMappingContext = NewObject<UInputMappingContext>(this, TEXT("CombatKeyboardMappingContext"));
+	if (MoveMenuAction)
+	{
+		// Same convention as the D-pad: right and up step forward, left and down are negated.
+		for (const FKey& Key : { EKeys::Right, EKeys::Up, EKeys::D, EKeys::W })
+		{
+			CombatKeyboardMappingContext->MapKey(MoveMenuAction, Key);
+		}
+		for (const FKey& Key : { EKeys::Left, EKeys::Down, EKeys::A, EKeys::S })
+		{
+			FEnhancedActionKeyMapping& Mapping = CombatKeyboardMappingContext->MapKey(MoveMenuAction, Key);
+			Mapping.Modifiers.Add(NewObject<UInputModifierNegate>(CombatKeyboardMappingContext));
+		}
+	}
+	if (ConfirmAction)
+	{
+		CombatKeyboardMappingContext->MapKey(ConfirmAction, EKeys::Enter);
+		CombatKeyboardMappingContext->MapKey(ConfirmAction, EKeys::SpaceBar);
+	}
+	if (CancelAction)
+	{
+		CombatKeyboardMappingContext->MapKey(CancelAction, EKeys::Escape);
+		CombatKeyboardMappingContext->MapKey(CancelAction, EKeys::BackSpace);
+	}
+}
+
 void AHikariPlayerController::HandleMove(const FInputActionValue& Value)
 {
 	if (AHikari* HikariPawn = Cast<AHikari>(GetPawn()))
@@ -60,6 +118,25 @@ void AHikariPlayerController::HandleLook(const FInputActionValue& Value)
 	}
 }
 
+void AHikariPlayerController::HandleMoveMenu(const FInputActionValue& Value)
+{
+	// Right and up step forward, left and down backward. A boolean action only keeps the sign of its X axis,
+	// so a press without any direction steps forward.
+	const FVector Axis = Value.Get<FVector>();
+	const float Direction = Axis.X != 0.f ? Axis.X : Axis.Y;
+	OnCycleTarget.Broadcast(Direction < 0.f ? -1 : 1);
+}
+
+void AHikariPlayerController::HandleConfirm()
+{
+	OnConfirmTarget.Broadcast();
+}
+
+void AHikariPlayerController::HandleCancel()
+{
+	OnCancelTarget.Broadcast();
+}
+
 void AHikariPlayerController::EnableCombatInputMode()
 {
 	UE_LOG(LogTemp, Log, TEXT("EnableCombatInputMode() called"));
@@ -74,6 +151,10 @@ void AHikariPlayerController::EnableCombatInputMode()
 		{
 			Subsystem->AddMappingContext(CombatMappingContext, 1);
 		}
+		if (CombatKeyboardMappingContext)
+		{
+			Subsystem->AddMappingContext(CombatKeyboardMappingContext, 1);
+		}
 	}
 
 	// Switch to GameAndUI mode for UI input and show the mouse cursor.
@@ -93,6 +174,10 @@ void AHikariPlayerController::DisableCombatInputMode()
 		{
 			Subsystem->RemoveMappingContext(CombatMappingContext);
 		}
+		if (CombatKeyboardMappingContext)
+		{
+			Subsystem->RemoveMappingContext(CombatKeyboardMappingContext);
+		}
 		// Re-add the base mapping context if necessary:
 		if (DefaultMappingContext)
 		{
@@ -1,4 +1,11 @@
 #include "Game/OctopathGameInstance.h"
+#include "Character/AllyAbilityComponent.h"
+#include "Enemy/EnemyAbilityComponent.h"
+#include "Manager/SkillData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOctopathGameInstance, Log, All);
 
 UOctopathGameInstance::UOctopathGameInstance()
 {
@@ -8,4 +15,100 @@ UOctopathGameInstance::UOctopathGameInstance()
 void UOctopathGameInstance::ResetGameData()
 {
     NumberOfEnemies = 0;
+    ReleaseSkillPreloads();
+}
+
+void UOctopathGameInstance::PreloadCombatSkills(const TArray<AActor*>& Combatants)
+{
+    // Collect the skills of every combatant (duplicates are filtered out).
+    TArray<FPrimaryAssetId> SkillIds;
+    auto AddSkills = [&SkillIds](const TArray<USkillData*>& Skills)
+    {
+        for (const USkillData* Skill : Skills)
+        {
+            if (Skill)
+            {
+                SkillIds.AddUnique(Skill->GetPrimaryAssetId());
+            }
+        }
+    };
+
+    for (const AActor* Combatant : Combatants)
+    {
+        if (!IsValid(Combatant))
+        {
+            continue;
+        }
+        if (const UAllyAbilityComponent* AllyAbilities = Combatant->FindComponentByClass<UAllyAbilityComponent>())
+        {
+            AddSkills(AllyAbilities->Skills);
+        }
+        if (const UEnemyAbilityComponent* EnemyAbilities = Combatant->FindComponentByClass<UEnemyAbilityComponent>())
+        {
+            AddSkills(EnemyAbilities->Skills);
+        }
+    }
+
+    if (SkillIds.Num() == 0)
+    {
+        return;
+    }
+
+    const TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAssets(SkillIds, { USkillData::CastBundle },
+        FStreamableDelegate::CreateUObject(this, &UOctopathGameInstance::HandleSkillPreloadLoaded));
+
+    // No handle means every bundle was already in memory.
+    if (Handle.IsValid())
+    {
+        SkillPreloadHandles.Add(Handle);
+    }
+    UE_LOG(LogOctopathGameInstance, Log, TEXT("PreloadCombatSkills - Preloading the Cast bundle of %d skill(s)"), SkillIds.Num());
+}
+
+void UOctopathGameInstance::ReleaseSkillPreloads()
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : SkillPreloadHandles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->ReleaseHandle();
+        }
+    }
+    SkillPreloadHandles.Reset();
+}
+
+float UOctopathGameInstance::GetSkillPreloadProgress() const
+{
+    if (SkillPreloadHandles.Num() == 0)
+    {
+        return 1.f;
+    }
+
+    float Progress = 0.f;
+    for (const TSharedPtr<FStreamableHandle>& Handle : SkillPreloadHandles)
+    {
+        Progress += Handle->GetProgress();
+    }
+    return Progress / SkillPreloadHandles.Num();
+}
+
+bool UOctopathGameInstance::IsSkillPreloadComplete() const
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : SkillPreloadHandles)
+    {
+        if (!Handle->HasLoadCompleted())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UOctopathGameInstance::HandleSkillPreloadLoaded()
+{
+    if (IsSkillPreloadComplete())
+    {
+        UE_LOG(LogOctopathGameInstance, Log, TEXT("HandleSkillPreloadLoaded - Skill preloads complete"));
+        OnSkillPreloadCompleted.Broadcast();
+    }
 }
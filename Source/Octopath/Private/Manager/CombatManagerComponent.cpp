@@ -88,16 +88,53 @@ void UCombatManagerComponent::SetupCombat()
 	FVector PlayerForward = PlayerSpawnRotation.Vector();
 	TArray<FVector> SpawnPositions = ComputeEnemySpawnPositions(PlayerSpawnLocation, PlayerForward, NumEnemies, EnemySpawnDistance, MaxSpreadAngle);
 
+	SpawnEnemies(SpawnPositions);
+	SetupCombatCamera(SpawnPositions);
+
+	// Preload the cast assets of the spawned enemies (the party's were requested by the trigger).
+	if (GI)
+	{
+		GI->PreloadCombatSkills(SpawnedEnemies);
+	}
+}
+
+void UCombatManagerComponent::SpawnEnemies(const TArray<FVector>& SpawnPositions)
+{
+	SpawnedEnemies.Reset(SpawnPositions.Num());
+	EnemySpawnTransforms.Reset(SpawnPositions.Num());
+
 	// Spawn enemies at the computed positions.
 	for (const FVector& SpawnLocation : SpawnPositions)
 	{
 		// Compute rotation so that the enemy faces the player.
 		FRotator SpawnRotation = (PlayerSpawnLocation - SpawnLocation).Rotation();
-		GetWorld()->SpawnActor<AActor>(EnemyClass, SpawnLocation, SpawnRotation);
+		EnemySpawnTransforms.Add(FTransform(SpawnRotation, SpawnLocation));
+		SpawnedEnemies.Add(GetWorld()->SpawnActor<AActor>(EnemyClass, SpawnLocation, SpawnRotation));
 	}
+}
 
-	// --- Configure the Combat Camera ---
+AActor* UCombatManagerComponent::RespawnEnemy(int32 EnemyIndex)
+{
+	if (!SpawnedEnemies.IsValidIndex(EnemyIndex))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RespawnEnemy - Invalid enemy index %d"), EnemyIndex);
+		return nullptr;
+	}
+
+	// Enemies that survived the battle are kept as is, their state is restored by the caller.
+	if (IsValid(SpawnedEnemies[EnemyIndex]))
+	{
+		return SpawnedEnemies[EnemyIndex];
+	}
+
+	const FTransform& SpawnTransform = EnemySpawnTransforms[EnemyIndex];
+	SpawnedEnemies[EnemyIndex] = GetWorld()->SpawnActor<AActor>(EnemyClass, SpawnTransform.GetLocation(), SpawnTransform.Rotator());
+	UE_LOG(LogTemp, Log, TEXT("RespawnEnemy - Respawned enemy %d"), EnemyIndex);
+	return SpawnedEnemies[EnemyIndex];
+}
 
+void UCombatManagerComponent::SetupCombatCamera(const TArray<FVector>& SpawnPositions)
+{
 	// Determine the focus point.
 	FVector FocusPoint = PlayerSpawnLocation; // Default focus is the player's location.
 	if (bUseDynamicCameraFocus && SpawnPositions.Num() > 0)
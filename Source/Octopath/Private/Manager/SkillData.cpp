@@ -2,4 +2,48 @@
 
 
 #include "Manager/SkillData.h"
+#include "Combat/CookedSkillTable.h"
+#include "Combat/SkillTableSubsystem.h"
 
+const FPrimaryAssetType USkillData::PrimaryAssetType(TEXT("Skill"));
+const FName USkillData::MenuBundle(TEXT("Menu"));
+const FName USkillData::CastBundle(TEXT("Cast"));
+
+FPrimaryAssetId USkillData::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void USkillData::PostLoad()
+{
+    Super::PostLoad();
+    CompileProgram();
+}
+
+#if WITH_EDITOR
+void USkillData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    CompileProgram();
+}
+#endif
+
+void USkillData::CompileProgram()
+{
+    Program.Compile(*this);
+    ContentHash = FCookedSkillTable::MakeContentHash(*this);
+}
+
+const FSkillProgram& USkillData::GetProgram() const
+{
+    if (const FSkillProgram* CookedProgram = USkillTableSubsystem::FindActiveProgram(*this))
+    {
+        return *CookedProgram;
+    }
+    return Program;
+}
+
+uint32 USkillData::GetSkillId() const
+{
+    return FCookedSkillTable::MakeSkillId(GetFName());
+}
@@ -0,0 +1,68 @@
+#include "Manager/StatBroadcastBenchmark.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogStatBroadcastBenchmark, Log, All);
+
+void UStatBroadcastBenchmarkListener::HandleStatChanged()
+{
+	++CallCount;
+}
+
+void UStatBroadcastBenchmarkListener::HandleStatChangedNative(UStatComponent* StatComponent, EStatChannel Channel)
+{
+	++CallCount;
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.StatBroadcast [Iterations]
+ *
+ * Broadcasts OnHealthChanged (dynamic) and OnStatChangedNative (native) with one listener each
+ * and logs the average cost per broadcast.
+ */
+static FAutoConsoleCommand GStatBroadcastBenchmarkCommand(
+	TEXT("Octopath.Bench.StatBroadcast"),
+	TEXT("Times dynamic vs native UStatComponent delegate broadcasts. Usage: Octopath.Bench.StatBroadcast [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			int32 Iterations = 100000;
+			if (Args.Num() > 0)
+			{
+				Iterations = FMath::Max(1, FCString::Atoi(*Args[0]));
+			}
+
+			UStatComponent* StatComp = NewObject<UStatComponent>(GetTransientPackage());
+			UStatBroadcastBenchmarkListener* Listener = NewObject<UStatBroadcastBenchmarkListener>(GetTransientPackage());
+
+			StatComp->OnHealthChanged.AddDynamic(Listener, &UStatBroadcastBenchmarkListener::HandleStatChanged);
+			StatComp->OnStatChangedNative.AddUObject(Listener, &UStatBroadcastBenchmarkListener::HandleStatChangedNative);
+
+			// Dynamic path.
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; i++)
+			{
+				StatComp->OnHealthChanged.Broadcast();
+			}
+			const double DynamicSeconds = FPlatformTime::Seconds() - StartTime;
+
+			// Native path.
+			StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; i++)
+			{
+				StatComp->OnStatChangedNative.Broadcast(StatComp, EStatChannel::Health);
+			}
+			const double NativeSeconds = FPlatformTime::Seconds() - StartTime;
+
+			const double DynamicNs = DynamicSeconds * 1.0e9 / Iterations;
+			const double NativeNs = NativeSeconds * 1.0e9 / Iterations;
+			UE_LOG(LogStatBroadcastBenchmark, Display, TEXT("StatBroadcast (%d iterations): dynamic %.1f ns/broadcast, native %.1f ns/broadcast (x%.1f), %lld calls"),
+				Iterations, DynamicNs, NativeNs, NativeNs > 0.0 ? DynamicNs / NativeNs : 0.0, Listener->CallCount);
+
+			StatComp->OnHealthChanged.RemoveAll(Listener);
+			StatComp->OnStatChangedNative.RemoveAll(Listener);
+		}));
+
+#endif // !UE_BUILD_SHIPPING
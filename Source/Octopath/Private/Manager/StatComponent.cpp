@@ -1,4 +1,7 @@
 #include "Manager/StatComponent.h"
+#include "Combat/StatusEffectSubsystem.h"
+#include "Combat/CombatSnapshot.h"
+#include "Combat/CombatBalance.h"
 #include "Math/UnrealMathUtility.h"
 
 
@@ -33,7 +36,19 @@ UStatComponent::UStatComponent()
 	bIsBoss = false;
 
 	bIsDefending = false;
-	DefenseReductionPercentage = 0.3f;
+	DefenseReductionPercentage = FCombatBalance::Get().DefendingDamageReduction;
+	BalanceDefenseReductionPercentage = DefenseReductionPercentage;
+
+	StatusEffectFlags = 0;
+
+	// Break defaults: no weakness, no shield.
+	WeaknessMask = 0;
+	BasicAttackDamageTypeMask = 0;
+	MaxShieldPoints = 0;
+	ShieldPoints = 0;
+	BreakRecoveryRounds = 1;
+	BrokenDamageMultiplier = 1.5f;
+	BreakRoundsRemaining = 0;
 }
 
 void UStatComponent::BeginPlay()
@@ -44,6 +59,39 @@ void UStatComponent::BeginPlay()
 	BasePhysicalDefense = PhysicalDefense;
 	BaseMagicalDefense = MagicalDefense;
 	BaseSpeed = Speed;
+	ShieldPoints = MaxShieldPoints;
+
+	// Stats may have been edited in the editor or by Blueprint before BeginPlay (RefreshBalance invalidates the derived values).
+	RefreshBalance();
+	BalanceReloadedHandle = FCombatBalance::OnReloaded.AddUObject(this, &UStatComponent::RefreshBalance);
+}
+
+void UStatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FCombatBalance::OnReloaded.Remove(BalanceReloadedHandle);
+	BalanceReloadedHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UStatComponent::RefreshBalance()
+{
+	// A value set on the Blueprint, the instance or at runtime differs from the last balance value and is kept.
+	const float BalanceValue = FCombatBalance::Get().DefendingDamageReduction;
+	if (DefenseReductionPercentage == BalanceDefenseReductionPercentage)
+	{
+		DefenseReductionPercentage = BalanceValue;
+	}
+	BalanceDefenseReductionPercentage = BalanceValue;
+
+	// Derived values cache the damage tunables too; caches keyed on the stat version rebuild on the next query.
+	DerivedStats.InvalidateAll();
+	StatVersion++;
+}
+
+float UStatComponent::GetHealthClampMax() const
+{
+	return bIsBoss ? MaxHealth : FMath::Min(MaxHealth, FCombatBalance::Get().NonBossMaxHealth);
 }
 
 void UStatComponent::ApplyDamage(float DamageAmount, bool bIsMagical)
@@ -52,18 +100,14 @@ void UStatComponent::ApplyDamage(float DamageAmount, bool bIsMagical)
     float EffectiveDamage = DamageAmount;
 
     // If the actor is defending, apply the defense reduction multiplier.
-    if (bIsDefending)
-    {
-        EffectiveDamage *= (1.f - DefenseReductionPercentage);
-    }
+    EffectiveDamage *= GetDerivedStat(EDerivedStat::IncomingDamageScale);
 
     Health -= EffectiveDamage;
 
-    float HealthClampMax = bIsBoss ? MaxHealth : FMath::Min(MaxHealth, 10000.f);
-    Health = FMath::Clamp(Health, 0.f, HealthClampMax);
+    Health = FMath::Clamp(Health, 0.f, GetHealthClampMax());
 
     // Broadcast the health change event.
-    OnHealthChanged.Broadcast();
+    NotifyStatChanged(EStatChannel::Health);
 }
 
 
@@ -73,17 +117,118 @@ void UStatComponent::UseTechniquePoints(float Amount)
 	TechniquePoints = FMath::Clamp(TechniquePoints, 0.f, MaxTechniquePoints);
 
 	// Broadcast the event for Technique Points change.
-	OnTechniquePointsChanged.Broadcast();
+	NotifyStatChanged(EStatChannel::TechniquePoints);
 }
 
 void UStatComponent::Heal(float Amount)
 {
 	Health += Amount;
-	float HealthClampMax = bIsBoss ? MaxHealth : FMath::Min(MaxHealth, 10000.f);
-	Health = FMath::Clamp(Health, 0.f, HealthClampMax);
+	Health = FMath::Clamp(Health, 0.f, GetHealthClampMax());
 
 	// Broadcast the event for Health change.
-	OnHealthChanged.Broadcast();
+	NotifyStatChanged(EStatChannel::Health);
+}
+
+void UStatComponent::SetHealth(float NewHealth)
+{
+	Health = FMath::Clamp(NewHealth, 0.f, GetHealthClampMax());
+	NotifyStatChanged(EStatChannel::Health);
+}
+
+void UStatComponent::SetMaxHealth(float NewMaxHealth)
+{
+	MaxHealth = bIsBoss ? FMath::Max(NewMaxHealth, 0.f) : FMath::Clamp(NewMaxHealth, 0.f, FCombatBalance::Get().NonBossMaxHealth);
+	NotifyStatChanged(EStatChannel::MaxHealth);
+
+	const float ClampedHealth = FMath::Clamp(Health, 0.f, GetHealthClampMax());
+	if (ClampedHealth != Health)
+	{
+		Health = ClampedHealth;
+		NotifyStatChanged(EStatChannel::Health);
+	}
+}
+
+void UStatComponent::SetTechniquePoints(float NewTechniquePoints)
+{
+	TechniquePoints = FMath::Clamp(NewTechniquePoints, 0.f, MaxTechniquePoints);
+	NotifyStatChanged(EStatChannel::TechniquePoints);
+}
+
+void UStatComponent::SetMaxTechniquePoints(float NewMaxTechniquePoints)
+{
+	MaxTechniquePoints = FMath::Clamp(NewMaxTechniquePoints, 0.f, 1000.f);
+	NotifyStatChanged(EStatChannel::MaxTechniquePoints);
+
+	if (TechniquePoints > MaxTechniquePoints)
+	{
+		TechniquePoints = MaxTechniquePoints;
+		NotifyStatChanged(EStatChannel::TechniquePoints);
+	}
+}
+
+void UStatComponent::SetBaseStat(ECombatStatType CombatStatType, float NewBaseValue)
+{
+	const float ClampedValue = FMath::Clamp(NewBaseValue, 0.f, FCombatBalance::Get().MaxStatValue);
+	switch (CombatStatType)
+	{
+	case ECombatStatType::PhysicalAttack:
+		BasePhysicalAttack = ClampedValue;
+		break;
+	case ECombatStatType::MagicalAttack:
+		BaseMagicalAttack = ClampedValue;
+		break;
+	case ECombatStatType::PhysicalDefense:
+		BasePhysicalDefense = ClampedValue;
+		break;
+	case ECombatStatType::MagicalDefense:
+		BaseMagicalDefense = ClampedValue;
+		break;
+	case ECombatStatType::Speed:
+		BaseSpeed = ClampedValue;
+		break;
+	default:
+		return;
+	}
+
+	// Reapplies the active modifiers on top of the new base value and notifies the stat's channel.
+	RecalculateStat(CombatStatType);
+}
+
+void UStatComponent::ApplyDamageBatch(TArrayView<UStatComponent* const> Targets, TArrayView<const float> Damages, TArrayView<float> OutHealthLost)
+{
+	check(Targets.Num() == Damages.Num() && Targets.Num() == OutHealthLost.Num());
+
+	// Write every health value first so listeners of the first target already see the whole hit resolved.
+	for (int32 i = 0; i < Targets.Num(); i++)
+	{
+		UStatComponent* Target = Targets[i];
+		const float PreviousHealth = Target->Health;
+		Target->Health = FMath::Clamp(PreviousHealth - Damages[i] * Target->GetDerivedStat(EDerivedStat::IncomingDamageScale), 0.f, Target->GetHealthClampMax());
+		OutHealthLost[i] = PreviousHealth - Target->Health;
+	}
+
+	for (UStatComponent* Target : Targets)
+	{
+		Target->NotifyStatChanged(EStatChannel::Health);
+	}
+}
+
+void UStatComponent::HealBatch(TArrayView<UStatComponent* const> Targets, TArrayView<const float> Amounts, TArrayView<float> OutHealed)
+{
+	check(Targets.Num() == Amounts.Num() && Targets.Num() == OutHealed.Num());
+
+	for (int32 i = 0; i < Targets.Num(); i++)
+	{
+		UStatComponent* Target = Targets[i];
+		const float PreviousHealth = Target->Health;
+		Target->Health = FMath::Clamp(PreviousHealth + Amounts[i], 0.f, Target->GetHealthClampMax());
+		OutHealed[i] = Target->Health - PreviousHealth;
+	}
+
+	for (UStatComponent* Target : Targets)
+	{
+		Target->NotifyStatChanged(EStatChannel::Health);
+	}
 }
 
 void UStatComponent::ApplyStatModifier(ECombatStatType AffectedStat, float ModifierValue, EModifierType ModifierType, int32 DurationTurns)
@@ -156,30 +301,30 @@ void UStatComponent::RecalculateStat(ECombatStatType CombatStatType)
         }
     }
 
-    float NewValue = BaseValue * (1.f + PercentageSum) + FlatSum;
+    float NewValue = FMath::Min(BaseValue * (1.f + PercentageSum) + FlatSum, FCombatBalance::Get().MaxStatValue);
 
     // Update the stat and broadcast event if needed.
     switch (CombatStatType)
     {
     case ECombatStatType::PhysicalAttack:
         PhysicalAttack = NewValue;
-        OnPhysicalAttackChanged.Broadcast();
+        NotifyStatChanged(EStatChannel::PhysicalAttack);
         break;
     case ECombatStatType::MagicalAttack:
         MagicalAttack = NewValue;
-        OnMagicalAttackChanged.Broadcast();
+        NotifyStatChanged(EStatChannel::MagicalAttack);
         break;
     case ECombatStatType::PhysicalDefense:
         PhysicalDefense = NewValue;
-        OnPhysicalDefenseChanged.Broadcast();
+        NotifyStatChanged(EStatChannel::PhysicalDefense);
         break;
     case ECombatStatType::MagicalDefense:
         MagicalDefense = NewValue;
-        OnMagicalDefenseChanged.Broadcast();
+        NotifyStatChanged(EStatChannel::MagicalDefense);
         break;
     case ECombatStatType::Speed:
         Speed = NewValue;
-        OnSpeedChanged.Broadcast();
+        NotifyStatChanged(EStatChannel::Speed);
         break;
     default:
         break;
@@ -188,3 +333,260 @@ void UStatComponent::RecalculateStat(ECombatStatType CombatStatType)
     UE_LOG(LogTemp, Log, TEXT("RecalculateStat - BaseSpeed: %f, PercentageSum: %f, FlatSum: %f, NewValue: %f"), BaseValue, PercentageSum, FlatSum, NewValue);
 
 }
+
+void UStatComponent::ApplySkillModifiers(const USkillData* Skill)
+{
+	if (!Skill)
+	{
+		return;
+	}
+
+	if (Skill->AffectedStat != ECombatStatType::None)
+	{
+		ApplyStatModifier(Skill->AffectedStat, Skill->ModifierValue, Skill->ModifierType, Skill->Duration);
+	}
+
+	if (Skill->StatusEffect != EStatusEffectType::None)
+	{
+		ApplyStatusEffect(Skill->StatusEffect, Skill->StatusEffectMagnitude, Skill->StatusEffectDuration);
+	}
+}
+
+void UStatComponent::ApplyStatusEffect(EStatusEffectType EffectType, float Magnitude, int32 DurationTurns)
+{
+	UWorld* World = GetWorld();
+	if (UStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr)
+	{
+		StatusEffects->ApplyEffect(this, EffectType, Magnitude, DurationTurns);
+	}
+}
+
+bool UStatComponent::HasStatusEffect(EStatusEffectType EffectType) const
+{
+	return (StatusEffectFlags & (1u << static_cast<uint32>(EffectType))) != 0;
+}
+
+bool UStatComponent::ApplyShieldHit(int32 DamageTypeMask, int32 ShieldDamage)
+{
+	if (ShieldPoints <= 0 || IsBroken() || !IsWeakTo(DamageTypeMask))
+	{
+		return false;
+	}
+
+	ShieldPoints = FMath::Max(ShieldPoints - ShieldDamage, 0);
+	const bool bBroke = (ShieldPoints == 0);
+	if (bBroke)
+	{
+		// The rest of the current round counts as one round.
+		BreakRoundsRemaining = BreakRecoveryRounds + 1;
+		DerivedStats.InvalidateBroken();
+		UE_LOG(LogTemp, Log, TEXT("ApplyShieldHit - %s is broken"), *EntityName.ToString());
+	}
+
+	NotifyStatChanged(EStatChannel::ShieldPoints);
+	return bBroke;
+}
+
+int32 UStatComponent::ApplyShieldHits(TArrayView<UStatComponent* const> Targets, int32 DamageTypeMask, int32 ShieldDamage)
+{
+	int32 NumBroken = 0;
+	for (UStatComponent* Target : Targets)
+	{
+		// Most targets are either shieldless or resistant: reject them with the mask test before touching any state.
+		if (Target && Target->ShieldPoints > 0 && Target->IsWeakTo(DamageTypeMask))
+		{
+			NumBroken += Target->ApplyShieldHit(DamageTypeMask, ShieldDamage) ? 1 : 0;
+		}
+	}
+	return NumBroken;
+}
+
+void UStatComponent::ProcessBreakRoundEnd()
+{
+	if (!IsBroken())
+	{
+		return;
+	}
+
+	BreakRoundsRemaining--;
+	if (BreakRoundsRemaining == 0)
+	{
+		ShieldPoints = MaxShieldPoints;
+		DerivedStats.InvalidateBroken();
+		NotifyStatChanged(EStatChannel::ShieldPoints);
+		UE_LOG(LogTemp, Log, TEXT("ProcessBreakRoundEnd - %s recovered from break"), *EntityName.ToString());
+	}
+}
+
+void UStatComponent::CaptureSnapshot(FCombatantSnapshot& OutSnapshot) const
+{
+	OutSnapshot.Health = Health;
+	OutSnapshot.MaxHealth = MaxHealth;
+	OutSnapshot.TechniquePoints = TechniquePoints;
+	OutSnapshot.MaxTechniquePoints = MaxTechniquePoints;
+	OutSnapshot.PhysicalAttack = PhysicalAttack;
+	OutSnapshot.MagicalAttack = MagicalAttack;
+	OutSnapshot.PhysicalDefense = PhysicalDefense;
+	OutSnapshot.MagicalDefense = MagicalDefense;
+	OutSnapshot.Speed = Speed;
+
+	OutSnapshot.BasePhysicalAttack = BasePhysicalAttack;
+	OutSnapshot.BaseMagicalAttack = BaseMagicalAttack;
+	OutSnapshot.BasePhysicalDefense = BasePhysicalDefense;
+	OutSnapshot.BaseMagicalDefense = BaseMagicalDefense;
+	OutSnapshot.BaseSpeed = BaseSpeed;
+
+	OutSnapshot.DefenseReductionPercentage = DefenseReductionPercentage;
+	OutSnapshot.bIsDefending = bIsDefending;
+	OutSnapshot.bIsBoss = bIsBoss;
+	OutSnapshot.StatusEffectFlags = StatusEffectFlags;
+
+	OutSnapshot.WeaknessMask = WeaknessMask;
+	OutSnapshot.ShieldPoints = ShieldPoints;
+	OutSnapshot.MaxShieldPoints = MaxShieldPoints;
+	OutSnapshot.BreakRoundsRemaining = BreakRoundsRemaining;
+	OutSnapshot.BreakRecoveryRounds = BreakRecoveryRounds;
+	OutSnapshot.BrokenDamageMultiplier = BrokenDamageMultiplier;
+
+	if (ActiveModifiers.Num() > FCombatantSnapshot::MaxModifiers)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CaptureSnapshot - %s has %d modifiers, only %d are captured"),
+			*EntityName.ToString(), ActiveModifiers.Num(), FCombatantSnapshot::MaxModifiers);
+	}
+	OutSnapshot.NumModifiers = FMath::Min(ActiveModifiers.Num(), FCombatantSnapshot::MaxModifiers);
+	for (int32 i = 0; i < OutSnapshot.NumModifiers; i++)
+	{
+		const FActiveStatModifier& Modifier = ActiveModifiers[i];
+		FModifierSnapshot& ModifierSnapshot = OutSnapshot.Modifiers[i];
+		ModifierSnapshot.ModifierValue = Modifier.ModifierValue;
+		ModifierSnapshot.RemainingTurns = static_cast<int16>(Modifier.RemainingTurns);
+		ModifierSnapshot.AffectedStat = Modifier.AffectedStat;
+		ModifierSnapshot.ModifierType = Modifier.ModifierType;
+	}
+}
+
+void UStatComponent::RestoreSnapshot(const FCombatantSnapshot& Snapshot)
+{
+	Health = Snapshot.Health;
+	MaxHealth = Snapshot.MaxHealth;
+	TechniquePoints = Snapshot.TechniquePoints;
+	MaxTechniquePoints = Snapshot.MaxTechniquePoints;
+	PhysicalAttack = Snapshot.PhysicalAttack;
+	MagicalAttack = Snapshot.MagicalAttack;
+	PhysicalDefense = Snapshot.PhysicalDefense;
+	MagicalDefense = Snapshot.MagicalDefense;
+	Speed = Snapshot.Speed;
+
+	BasePhysicalAttack = Snapshot.BasePhysicalAttack;
+	BaseMagicalAttack = Snapshot.BaseMagicalAttack;
+	BasePhysicalDefense = Snapshot.BasePhysicalDefense;
+	BaseMagicalDefense = Snapshot.BaseMagicalDefense;
+	BaseSpeed = Snapshot.BaseSpeed;
+
+	bIsDefending = Snapshot.bIsDefending != 0;
+	bIsBoss = Snapshot.bIsBoss != 0;
+	StatusEffectFlags = Snapshot.StatusEffectFlags;
+	SetDefenseReductionPercentage(Snapshot.DefenseReductionPercentage);
+
+	WeaknessMask = Snapshot.WeaknessMask;
+	ShieldPoints = Snapshot.ShieldPoints;
+	MaxShieldPoints = Snapshot.MaxShieldPoints;
+	BreakRoundsRemaining = Snapshot.BreakRoundsRemaining;
+	BreakRecoveryRounds = Snapshot.BreakRecoveryRounds;
+	BrokenDamageMultiplier = Snapshot.BrokenDamageMultiplier;
+
+	ActiveModifiers.Reset();
+	for (int32 i = 0; i < Snapshot.NumModifiers; i++)
+	{
+		const FModifierSnapshot& ModifierSnapshot = Snapshot.Modifiers[i];
+		FActiveStatModifier& Modifier = ActiveModifiers.AddDefaulted_GetRef();
+		Modifier.AffectedStat = ModifierSnapshot.AffectedStat;
+		Modifier.ModifierValue = ModifierSnapshot.ModifierValue;
+		Modifier.ModifierType = ModifierSnapshot.ModifierType;
+		Modifier.RemainingTurns = ModifierSnapshot.RemainingTurns;
+	}
+
+	DerivedStats.InvalidateAll();
+
+	// Refresh every listener once.
+	NotifyStatChanged(EStatChannel::MaxHealth);
+	NotifyStatChanged(EStatChannel::Health);
+	NotifyStatChanged(EStatChannel::MaxTechniquePoints);
+	NotifyStatChanged(EStatChannel::TechniquePoints);
+	NotifyStatChanged(EStatChannel::PhysicalDefense);
+	NotifyStatChanged(EStatChannel::MagicalDefense);
+	NotifyStatChanged(EStatChannel::PhysicalAttack);
+	NotifyStatChanged(EStatChannel::MagicalAttack);
+	NotifyStatChanged(EStatChannel::Speed);
+	NotifyStatChanged(EStatChannel::ShieldPoints);
+}
+
+void UStatComponent::SetDefending(bool bNewDefending)
+{
+	if (bIsDefending != bNewDefending)
+	{
+		bIsDefending = bNewDefending;
+		DerivedStats.InvalidateDefending();
+		StatVersion++;
+	}
+}
+
+void UStatComponent::SetDefenseReductionPercentage(float NewPercentage)
+{
+	DefenseReductionPercentage = FMath::Clamp(NewPercentage, 0.f, 1.f);
+	// An override equal to the balance value would follow the next reload; any other value is kept.
+	DerivedStats.InvalidateDefending();
+	StatVersion++;
+}
+
+float UStatComponent::GetDerivedStat(EDerivedStat Stat) const
+{
+	return DerivedStats.Get(Stat, *this);
+}
+
+void UStatComponent::NotifyStatChanged(EStatChannel Channel)
+{
+	// Derived values depending on this stat are recomputed on their next read.
+	DerivedStats.InvalidateChannel(Channel);
+	StatVersion++;
+
+	// Native listeners first: plain C++ invocation list, no reflection.
+	OnStatChangedNative.Broadcast(this, Channel);
+
+	// Blueprint listeners.
+	switch (Channel)
+	{
+	case EStatChannel::Health:
+		OnHealthChanged.Broadcast();
+		break;
+	case EStatChannel::MaxHealth:
+		OnMaxHealthChanged.Broadcast();
+		break;
+	case EStatChannel::TechniquePoints:
+		OnTechniquePointsChanged.Broadcast();
+		break;
+	case EStatChannel::MaxTechniquePoints:
+		OnMaxTechniquePointsChanged.Broadcast();
+		break;
+	case EStatChannel::PhysicalDefense:
+		OnPhysicalDefenseChanged.Broadcast();
+		break;
+	case EStatChannel::MagicalDefense:
+		OnMagicalDefenseChanged.Broadcast();
+		break;
+	case EStatChannel::PhysicalAttack:
+		OnPhysicalAttackChanged.Broadcast();
+		break;
+	case EStatChannel::MagicalAttack:
+		OnMagicalAttackChanged.Broadcast();
+		break;
+	case EStatChannel::Speed:
+		OnSpeedChanged.Broadcast();
+		break;
+	case EStatChannel::ShieldPoints:
+		OnShieldPointsChanged.Broadcast();
+		break;
+	default:
+		break;
+	}
+}
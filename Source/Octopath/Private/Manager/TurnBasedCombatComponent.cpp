@@ -1,7 +1,13 @@
 ﻿#include "Manager/TurnBasedCombatComponent.h"
 #include "Manager/StatComponent.h"
 #include "Enemy/EnemyAbilityComponent.h"
+#include "Enemy/EnemyAIProfile.h"
 #include "Character/AllyAbilityComponent.h"
+#include "Combat/StatusEffectSubsystem.h"
+#include "Combat/CombatRandomSubsystem.h"
+#include "Combat/CombatSnapshot.h"
+#include "Combat/CombatBalance.h"
+#include "Manager/CombatManagerComponent.h"
 
 #include "Blueprint/UserWidget.h"
 #include "Widget/TurnOrderWidget.h"
@@ -9,6 +15,7 @@
 #include "Widget/PlayerStatsWidget.h"
 #include "Widget/PlayerAbilitiesMenuWidget.h"
 #include "Widget/EnemyIndicatorWidget.h"
+#include "Widget/DefeatMenuWidget.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
@@ -16,7 +23,17 @@
 #include "Game/HikariPlayerController.h"
 
 #include "Engine/Engine.h"
+#include "EngineUtils.h"
 #include "Components/TimelineComponent.h"
+#include "Components/MeshComponent.h"
+#include "Engine/PostProcessVolume.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Animation/AnimMontage.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+
+const TCHAR* UTurnBasedCombatComponent::DefaultSelectionHighlightMaterialPath = TEXT("/Game/VFX/Materials/PostProcess/M_SelectionOutline.M_SelectionOutline");
 
 UTurnBasedCombatComponent::UTurnBasedCombatComponent()
 {
@@ -24,6 +41,8 @@ UTurnBasedCombatComponent::UTurnBasedCombatComponent()
     CurrentTurnIndex = 0;
     EntityIndicatorTarget = nullptr;
     CurrentEnemyIndicatorWidget = nullptr;
+    SelectionHighlightVolume = nullptr;
+    SelectionFallbackMaterial = nullptr;
     bIsSelectingTarget = false;
     bTargetLocked = false;
     bWasLeftMouseDown = false;
@@ -39,6 +58,8 @@ UTurnBasedCombatComponent::UTurnBasedCombatComponent()
     PlayerAttackTimeline = nullptr;
     EnemyAttackTimeline = nullptr;
     AbilityCastingTimeline = nullptr;
+
+    DefeatMenuWidget = nullptr;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -103,10 +124,82 @@ void UTurnBasedCombatComponent::BeginPlay()
         }
     }
 
+    // One post-process pass draws the highlight of every selected combatant (see SetSelectionHighlight).
+    UMaterialInterface* HighlightMaterial = SelectionHighlightMaterial;
+    const UMaterial* HighlightBaseMaterial = IsValid(HighlightMaterial) ? HighlightMaterial->GetMaterial() : nullptr;
+    if (!HighlightBaseMaterial || HighlightBaseMaterial->MaterialDomain != MD_PostProcess)
+    {
+        // A surface material (set before the outline existed) is kept in case the default outline is missing.
+        SelectionFallbackMaterial = HighlightBaseMaterial ? HighlightMaterial : nullptr;
+        HighlightMaterial = LoadObject<UMaterialInterface>(nullptr, DefaultSelectionHighlightMaterialPath, nullptr, LOAD_NoWarn);
+    }
+    if (IsValid(HighlightMaterial))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        SelectionHighlightVolume = World->SpawnActor<APostProcessVolume>(SpawnParams);
+        if (IsValid(SelectionHighlightVolume))
+        {
+            // The outline compares the stencil against its StencilValue parameter (ignored by materials without one).
+            UMaterialInstanceDynamic* HighlightInstance = UMaterialInstanceDynamic::Create(HighlightMaterial, SelectionHighlightVolume);
+            HighlightInstance->SetScalarParameterValue(TEXT("StencilValue"), static_cast<float>(SelectionStencilValue));
+            SelectionHighlightVolume->bUnbound = true;
+            SelectionHighlightVolume->Settings.AddBlendable(HighlightInstance, 1.f);
+        }
+    }
+    else if (IsValid(SelectionFallbackMaterial))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BeginPlay - No outline material, swapping %s onto the selected meshes (run the SelectionOutline commandlet to build %s)"),
+            *SelectionFallbackMaterial->GetName(), DefaultSelectionHighlightMaterialPath);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BeginPlay - No selection highlight material (run the SelectionOutline commandlet to build %s)"), DefaultSelectionHighlightMaterialPath);
+    }
+
+    BalanceReloadedHandle = FCombatBalance::OnReloaded.AddUObject(this, &UTurnBasedCombatComponent::HandleBalanceReloaded);
+
+    // Keyboard and gamepad targeting through the combat mapping context.
+    if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
+    {
+        InputController = HPC;
+        CycleTargetHandle = HPC->OnCycleTarget.AddUObject(this, &UTurnBasedCombatComponent::CycleTarget);
+        ConfirmTargetHandle = HPC->OnConfirmTarget.AddUObject(this, &UTurnBasedCombatComponent::ConfirmTargetSelection);
+        CancelTargetHandle = HPC->OnCancelTarget.AddUObject(this, &UTurnBasedCombatComponent::CancelTargetSelection);
+    }
+
     StartCombat();
     UE_LOG(LogTemp, Log, TEXT("TurnBasedCombatComponent::BeginPlay - End"));
 }
 
+void UTurnBasedCombatComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    FCombatBalance::OnReloaded.Remove(BalanceReloadedHandle);
+    BalanceReloadedHandle.Reset();
+
+    if (AHikariPlayerController* HPC = InputController.Get())
+    {
+        HPC->OnCycleTarget.Remove(CycleTargetHandle);
+        HPC->OnConfirmTarget.Remove(ConfirmTargetHandle);
+        HPC->OnCancelTarget.Remove(CancelTargetHandle);
+    }
+    InputController.Reset();
+
+    if (IsValid(SelectionHighlightVolume))
+    {
+        SelectionHighlightVolume->Destroy();
+    }
+    SelectionHighlightVolume = nullptr;
+    OriginalMaterials.Empty();
+
+    IndicatorLayer.Reset();
+    IndicatorPool.Empty();
+    CurrentEnemyIndicatorWidget = nullptr;
+    MultiTargetIndicatorWidgets.Empty();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void UTurnBasedCombatComponent::StartCombat()
 {
     UE_LOG(LogTemp, Log, TEXT("StartCombat - Called"));
@@ -160,6 +253,36 @@ void UTurnBasedCombatComponent::StartCombat()
         Combatants.Add(Info.Combatant);
         UE_LOG(LogTemp, Log, TEXT("StartCombat - Sorted Combatant: %s"), *Info.Combatant->GetName());
     }
+    InvalidateTargetCache();
+    SkillPreviewCache.Reset();
+
+    // One indicator per combatant (All and Random skills) plus the single-target one, created up front.
+    IndicatorPool.Prewarm(PC, EnemyIndicatorWidgetClass, Combatants.Num() + 1);
+
+    // Reserve the status effect pools so applying effects during combat does not allocate.
+    if (UStatusEffectSubsystem* StatusEffects = World->GetSubsystem<UStatusEffectSubsystem>())
+    {
+        StatusEffects->ReservePools(Combatants.Num());
+    }
+
+    // Every combat roll comes from one stream so snapshots can capture it.
+    if (UCombatRandomSubsystem* CombatRandom = World->GetSubsystem<UCombatRandomSubsystem>())
+    {
+        CombatRandom->Reseed(FMath::Rand());
+    }
+
+    // Keep the opening state in memory so a defeat can be retried without reloading the level.
+    TArray<AActor*> SnapshotActors;
+    CaptureSnapshot(InitialSnapshot, SnapshotActors);
+    UCombatManagerComponent* CombatManager = FindCombatManager();
+    InitialSnapshotActors.Reset(SnapshotActors.Num());
+    InitialSnapshotEnemyIndices.Reset(SnapshotActors.Num());
+    for (AActor* Actor : SnapshotActors)
+    {
+        InitialSnapshotActors.Add(Actor);
+        InitialSnapshotEnemyIndices.Add(CombatManager ? CombatManager->GetSpawnedEnemies().IndexOfByKey(Actor) : INDEX_NONE);
+    }
+    bHasInitialSnapshot = true;
 
     if (IsValid(TurnOrderWidget))
     {
@@ -228,6 +351,12 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+    // One batched projection for every shown indicator; still widgets are not touched.
+    if (!IndicatorLayer.IsEmpty())
+    {
+        UpdateEnemyIndicatorPosition();
+    }
+
     // --- Ability Target Selection Mode ---
     if (bIsSelectingAbilityTarget && CurrentSelectedAbility)
     {
@@ -242,8 +371,8 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
             return;
         }
 
-        // For self or heal abilities, the target is always the player.
-        if (CurrentSelectedAbility->TargetType == ETargetType::Self || CurrentSelectedAbility->AbilityCategory == EAbilityCategory::Heal)
+        // For self-targeted abilities, the target is always the player.
+        if (FCombatTargetCache::TargetsCaster(CurrentSelectedAbility->TargetType))
         {
             AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
             if (IsValid(PlayerActor))
@@ -263,28 +392,19 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
         else
         {
             // For abilities targeting an enemy or an ally.
-            FHitResult Hit;
-            if (!PC->GetHitResultUnderCursorByChannel(ETraceTypeQuery::TraceTypeQuery1, true, Hit))
-            {
-                return;
-            }
-            AActor* HitActor = Hit.GetActor();
-            bool bValidTarget = false;
-            if (CurrentSelectedAbility->TargetType == ETargetType::Enemy)
-            {
-                bValidTarget = (IsValid(HitActor) && HitActor->ActorHasTag("Enemy"));
-            }
-            else if (CurrentSelectedAbility->TargetType == ETargetType::Ally)
-            {
-                bValidTarget = (IsValid(HitActor) && (HitActor->ActorHasTag("Player") || HitActor->ActorHasTag("Ally")));
-            }
-            if (bValidTarget)
+            // Only the targets computed for this kind of skill at the start of the turn can be picked under the cursor.
+            const FCombatTargetCache& Targets = GetTargetCache();
+            const int32 CasterSlot = Targets.FindSlot(UGameplayStatics::GetPlayerCharacter(World, 0));
+            AActor* HitActor = TargetPicker.GetActorUnderCursor(*PC, Targets, Targets.GetValidTargets(CasterSlot, *CurrentSelectedAbility));
+            if (IsValid(HitActor))
             {
+                const bool bClicked = PC->WasInputKeyJustPressed(EKeys::LeftMouseButton);
                 // For Single or Multiple modes (for All/Random, DefaultAbilityTargets is handled elsewhere)
                 if (CurrentSelectedAbility->TargetMode != ETargetMode::All &&
                     CurrentSelectedAbility->TargetMode != ETargetMode::Random)
                 {
-                    if (AbilityTarget != HitActor)
+                    // A still cursor keeps the target chosen with the keyboard or gamepad (see CycleTarget).
+                    if (AbilityTarget != HitActor && (TargetPicker.HasCursorMoved() || bClicked))
                     {
                         AbilityTarget = HitActor;
                         SetEntityIndicator(HitActor);
@@ -292,7 +412,7 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
                     }
                 }
                 // On click, launch the casting timeline to execute the ability.
-                if (PC->WasInputKeyJustPressed(EKeys::LeftMouseButton))
+                if (bClicked)
                 {
                     ConfirmAbilityCast();
                     // Let the timeline run; resetting will be handled in OnAbilityCastingTimelineFinished().
@@ -318,17 +438,15 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
     {
         return;
     }
-    FHitResult Hit;
-    if (!PCBasic->GetHitResultUnderCursorByChannel(ETraceTypeQuery::TraceTypeQuery1, true, Hit))
-    {
-        return;
-    }
-    AActor* HitActor = Hit.GetActor();
-    if (!IsValid(HitActor) || !HitActor->ActorHasTag("Enemy"))
+    const FCombatTargetCache& Targets = GetTargetCache();
+    const int32 PlayerSlot = Targets.FindSlot(UGameplayStatics::GetPlayerCharacter(WorldBasic, 0));
+    AActor* HitActor = TargetPicker.GetActorUnderCursor(*PCBasic, Targets, Targets.GetAttackTargets(PlayerSlot));
+    if (!IsValid(HitActor))
     {
         return;
     }
-    if (EntityIndicatorTarget != HitActor)
+    // A still cursor keeps the target chosen with the keyboard or gamepad (see CycleTarget).
+    if (EntityIndicatorTarget != HitActor && TargetPicker.HasCursorMoved())
     {
         if (IsValid(EntityIndicatorTarget))
         {
@@ -339,11 +457,6 @@ void UTurnBasedCombatComponent::TickComponent(float DeltaTime, ELevelTick TickTy
         bTargetLocked = true;
         UE_LOG(LogTemp, Log, TEXT("TickComponent - Target locked on enemy: %s"), *HitActor->GetName());
     }
-    else
-    {
-        UpdateEnemyIndicatorPosition();
-        UE_LOG(LogTemp, Log, TEXT("TickComponent - Updated enemy indicator position for: %s"), *HitActor->GetName());
-    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -363,73 +476,37 @@ void UTurnBasedCombatComponent::SetEntityIndicator(AActor* NewTarget)
     // In single-target mode, clear multi-target indicator widgets.
     if (!CurrentSelectedAbility || (CurrentSelectedAbility->TargetMode != ETargetMode::All && CurrentSelectedAbility->TargetMode != ETargetMode::Random))
     {
-        for (auto& Elem : MultiTargetIndicatorWidgets)
-        {
-            if (IsValid(Elem.Value))
-            {
-                Elem.Value->RemoveFromParent();
-            }
-        }
-        MultiTargetIndicatorWidgets.Empty();
+        ReleaseMultiTargetIndicatorWidgets();
     }
 
     EntityIndicatorTarget = NewTarget;
 
-    // If no widget exists for single-target mode, create one.
+    // If no widget is shown for single-target mode, take one from the pool.
     if (!IsValid(CurrentEnemyIndicatorWidget))
     {
-        UWorld* World = GetWorld();
-        APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
-        if (IsValid(PC) && IsValid(EnemyIndicatorWidgetClass))
-        {
-            CurrentEnemyIndicatorWidget = CreateWidget<UEnemyIndicatorWidget>(PC, EnemyIndicatorWidgetClass);
-            if (IsValid(CurrentEnemyIndicatorWidget))
-            {
-                CurrentEnemyIndicatorWidget->AddToViewport();
-                UE_LOG(LogTemp, Log, TEXT("SetEntityIndicator - Indicator widget created and added to viewport"));
-            }
-        }
+        CurrentEnemyIndicatorWidget = AcquireIndicatorWidget();
     }
 
+    // The layer only sets the name when the widget's target changes.
+    IndicatorLayer.Show(CurrentEnemyIndicatorWidget, NewTarget);
     UpdateEnemyIndicatorPosition();
     ApplyFeedbackToEntity(NewTarget);
 
     if (IsValid(CurrentEnemyIndicatorWidget) && IsValid(NewTarget))
     {
-        if (UStatComponent* StatComp = NewTarget->FindComponentByClass<UStatComponent>())
-        {
-            CurrentEnemyIndicatorWidget->SetEnemyName(StatComp->EntityName);
-            UE_LOG(LogTemp, Log, TEXT("SetEntityIndicator - Updated indicator name: %s"), *StatComp->EntityName.ToString());
-        }
+        // Called every frame while a self-targeted skill is pending: the preview is a cache lookup.
+        CurrentEnemyIndicatorWidget->SetPreview(bIsSelectingAbilityTarget ? GetSkillPreviewText(CurrentSelectedAbility, NewTarget) : FText::GetEmpty());
     }
 }
 
 void UTurnBasedCombatComponent::UpdateEnemyIndicatorPosition()
 {
-    UE_LOG(LogTemp, Log, TEXT("UpdateEnemyIndicatorPosition - Called"));
-    if (!IsValid(EntityIndicatorTarget) || !IsValid(CurrentEnemyIndicatorWidget))
-    {
-        return;
-    }
-
-    UWorld* World = GetWorld();
-    APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
+    APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
     if (!IsValid(PC))
     {
         return;
     }
-
-    FVector WorldLocation = EntityIndicatorTarget->GetActorLocation() + FVector(0.f, 0.f, IndicatorWorldVerticalOffset);
-    FVector2D ScreenPosition;
-    if (!PC->ProjectWorldLocationToScreen(WorldLocation, ScreenPosition))
-    {
-        return;
-    }
-
-    ScreenPosition += IndicatorScreenOffset;
-    CurrentEnemyIndicatorWidget->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
-    CurrentEnemyIndicatorWidget->SetPositionInViewport(ScreenPosition, false);
-    UE_LOG(LogTemp, Log, TEXT("UpdateEnemyIndicatorPosition - Updated indicator at screen position: X=%f, Y=%f"), ScreenPosition.X, ScreenPosition.Y);
+    IndicatorLayer.Update(*PC, IndicatorWorldVerticalOffset, IndicatorScreenOffset, IndicatorPixelThreshold);
 }
 
 void UTurnBasedCombatComponent::OnPlayerAttack()
@@ -445,15 +522,13 @@ void UTurnBasedCombatComponent::OnPlayerAttack()
     if (!bIsSelectingTarget)
     {
         bIsSelectingTarget = true;
-        for (AActor* Actor : Combatants)
+        TargetRing.Reset();
+        const FCombatTargetCache& Targets = GetTargetCache();
+        if (AActor* DefaultTarget = Targets.GetFirstActor(Targets.GetAttackTargets(Targets.FindSlot(PlayerActor))))
         {
-            if (IsValid(Actor) && !Actor->ActorHasTag("Player"))
-            {
-                SetEntityIndicator(Actor);
-                bTargetLocked = true;
-                UE_LOG(LogTemp, Log, TEXT("OnPlayerAttack - Default target auto-selected: %s"), *Actor->GetName());
-                break;
-            }
+            SetEntityIndicator(DefaultTarget);
+            bTargetLocked = true;
+            UE_LOG(LogTemp, Log, TEXT("OnPlayerAttack - Default target auto-selected: %s"), *DefaultTarget->GetName());
         }
         return;
     }
@@ -468,11 +543,7 @@ void UTurnBasedCombatComponent::OnPlayerAttack()
     bIsSelectingTarget = false;
     bTargetLocked = false;
     EntityIndicatorTarget = nullptr;
-    if (IsValid(CurrentEnemyIndicatorWidget))
-    {
-        CurrentEnemyIndicatorWidget->RemoveFromParent();
-        CurrentEnemyIndicatorWidget = nullptr;
-    }
+    ReleaseEnemyIndicatorWidget();
     ConfirmPlayerAttack();
 }
 
@@ -480,6 +551,18 @@ void UTurnBasedCombatComponent::ShowAbilitiesMenu()
 {
     UE_LOG(LogTemp, Log, TEXT("ShowAbilitiesMenu called"));
 
+    // A silenced player cannot open the abilities menu.
+    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+    if (IsValid(PlayerActor))
+    {
+        UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>();
+        if (PlayerStat && PlayerStat->HasStatusEffect(EStatusEffectType::Silence))
+        {
+            UE_LOG(LogTemp, Log, TEXT("ShowAbilitiesMenu - Player is silenced"));
+            return;
+        }
+    }
+
     // Adjust the main action menu opacity.
     if (IsValid(PlayerTurnMenuWidget))
     {
@@ -496,6 +579,7 @@ void UTurnBasedCombatComponent::ShowAbilitiesMenu()
             {
                 // Bind ability selection and back events.
                 PlayerAbilitiesMenuWidget->OnAbilitySelected.AddDynamic(this, &UTurnBasedCombatComponent::OnAbilitySelected);
+                PlayerAbilitiesMenuWidget->OnAbilityHovered.AddDynamic(this, &UTurnBasedCombatComponent::OnAbilityHovered);
                 PlayerAbilitiesMenuWidget->OnBackPressed.AddDynamic(this, &UTurnBasedCombatComponent::HideAbilitiesMenu);
 
                 PlayerAbilitiesMenuWidget->AddToViewport();
@@ -507,6 +591,7 @@ void UTurnBasedCombatComponent::ShowAbilitiesMenu()
     else if (IsValid(PlayerAbilitiesMenuWidget))
     {
         PlayerAbilitiesMenuWidget->SetVisibility(ESlateVisibility::Visible);
+        PlayerAbilitiesMenuWidget->StreamSkillIcons();
         UE_LOG(LogTemp, Log, TEXT("ShowAbilitiesMenu - PlayerAbilitiesMenuWidget set to visible"));
     }
 }
@@ -531,14 +616,7 @@ void UTurnBasedCombatComponent::OnAbilitySelected(USkillData* SelectedSkill)
             }
         }
         DefaultAbilityTargets.Empty();
-        for (auto& Elem : MultiTargetIndicatorWidgets)
-        {
-            if (IsValid(Elem.Value))
-            {
-                Elem.Value->RemoveFromParent();
-            }
-        }
-        MultiTargetIndicatorWidgets.Empty();
+        ReleaseMultiTargetIndicatorWidgets();
     }
 
     // Cache the player's character.
@@ -557,53 +635,53 @@ void UTurnBasedCombatComponent::OnAbilitySelected(USkillData* SelectedSkill)
         return;
     }
 
+    const FCombatTargetCache& Targets = GetTargetCache();
+    const int32 PlayerSlot = Targets.FindSlot(PlayerActor);
+    if (!Targets.CanAfford(PlayerSlot, SelectedSkill))
+    {
+        UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Not enough Technique Points for %s"), *SelectedSkill->SkillName.ToString());
+        return;
+    }
+    const FCombatTargetCache::FMask ValidTargets = Targets.GetValidTargets(PlayerSlot, *SelectedSkill);
+
     // Activate ability target selection mode.
     CurrentSelectedAbility = SelectedSkill;
     bIsSelectingAbilityTarget = true;
+    TargetRing.Reset();
 
-    // For Self or Heal abilities, default target is the player.
-    if (SelectedSkill->TargetType == ETargetType::Self || SelectedSkill->AbilityCategory == EAbilityCategory::Heal)
+    // For Self abilities, default target is the player.
+    if (FCombatTargetCache::TargetsCaster(SelectedSkill->TargetType))
     {
         SetEntityIndicator(PlayerActor);
         UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Self-target ability selection mode activated"));
     }
-    // For offensive or debuff abilities.
-    else if (SelectedSkill->AbilityCategory == EAbilityCategory::Offensive ||SelectedSkill->AbilityCategory == EAbilityCategory::Debuff)
+    // If TargetMode is All or Random, select every valid target by default (enemies or allies, depending on the skill).
+    else if (SelectedSkill->TargetMode == ETargetMode::All || SelectedSkill->TargetMode == ETargetMode::Random)
     {
-        // If TargetMode is All or Random, select all enemies by default.
-        if (SelectedSkill->TargetMode == ETargetMode::All || SelectedSkill->TargetMode == ETargetMode::Random)
+        DefaultAbilityTargets.Empty();
+        Targets.GetActors(ValidTargets, DefaultAbilityTargets);
+        for (AActor* Target : DefaultAbilityTargets)
         {
-            DefaultAbilityTargets.Empty();
-            TArray<AActor*> AllEnemies;
-            UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("Enemy"), AllEnemies);
-            for (AActor* Enemy : AllEnemies)
-            {
-                if (IsValid(Enemy))
-                {
-                    DefaultAbilityTargets.Add(Enemy);
-                    ApplyFeedbackToEntity(Enemy);
-                }
-            }
-            UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Default selection set to ALL enemies (%d found)"), DefaultAbilityTargets.Num());
+            ApplyFeedbackToEntity(Target);
         }
-        else
+        UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Default selection set to ALL valid targets (%d found)"), DefaultAbilityTargets.Num());
+    }
+    // For offensive or debuff abilities.
+    else if (SelectedSkill->AbilityCategory == EAbilityCategory::Offensive ||SelectedSkill->AbilityCategory == EAbilityCategory::Debuff)
+    {
+        // For Single or Multiple, auto-select the first enemy.
+        if (AActor* DefaultEnemy = Targets.GetFirstActor(ValidTargets))
         {
-            // For Single or Multiple, auto-select the first enemy.
-            TArray<AActor*> FoundEnemies;
-            UGameplayStatics::GetAllActorsWithTag(GetWorld(), FName("Enemy"), FoundEnemies);
-            if (FoundEnemies.Num() > 0)
-            {
-                AActor* DefaultEnemy = FoundEnemies[0];
-                SetEntityIndicator(DefaultEnemy);
-                AbilityTarget = DefaultEnemy;
-                UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Default target set to enemy: %s"), *DefaultEnemy->GetName());
-            }
+            SetEntityIndicator(DefaultEnemy);
+            AbilityTarget = DefaultEnemy;
+            UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Default target set to enemy: %s"), *DefaultEnemy->GetName());
         }
     }
     else if (SelectedSkill->TargetType == ETargetType::Ally)
     {
         // For ally-targeted abilities, default to the player.
         SetEntityIndicator(PlayerActor);
+        AbilityTarget = PlayerActor;
         UE_LOG(LogTemp, Log, TEXT("OnAbilitySelected - Ally-target ability selection mode activated (default set to self)"));
     }
     else
@@ -612,6 +690,53 @@ void UTurnBasedCombatComponent::OnAbilitySelected(USkillData* SelectedSkill)
     }
 }
 
+void UTurnBasedCombatComponent::OnAbilityHovered(USkillData* HoveredSkill)
+{
+    if (!HoveredSkill || !IsValid(PlayerAbilitiesMenuWidget))
+    {
+        return;
+    }
+
+    // One line per valid target; unchanged previews are map lookups.
+    const FCombatTargetCache& Targets = GetTargetCache();
+    TArray<AActor*> PreviewTargets;
+    Targets.GetActors(Targets.GetValidTargets(Targets.FindSlot(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0)), *HoveredSkill), PreviewTargets);
+
+    TArray<FText> Lines;
+    for (AActor* Target : PreviewTargets)
+    {
+        const FText Preview = GetSkillPreviewText(HoveredSkill, Target);
+        const UStatComponent* TargetStats = Target->FindComponentByClass<UStatComponent>();
+        if (!Preview.IsEmpty() && TargetStats)
+        {
+            Lines.Add(FText::Format(NSLOCTEXT("TurnBasedCombat", "TargetPreview", "{0}: {1}"), TargetStats->EntityName, Preview));
+        }
+    }
+    PlayerAbilitiesMenuWidget->SetSkillPreview(FText::Join(FText::FromString(TEXT("\n")), Lines));
+}
+
+bool UTurnBasedCombatComponent::GetSkillPreview(USkillData* Skill, AActor* Target, FSkillPreview& OutPreview)
+{
+    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+    const UStatComponent* CasterStats = IsValid(PlayerActor) ? PlayerActor->FindComponentByClass<UStatComponent>() : nullptr;
+    const UStatComponent* TargetStats = IsValid(Target) ? Target->FindComponentByClass<UStatComponent>() : nullptr;
+    if (!Skill || !CasterStats || !TargetStats)
+    {
+        return false;
+    }
+
+    const UAllyAbilityComponent* AllyAbilityComp = PlayerActor->FindComponentByClass<UAllyAbilityComponent>();
+    const FDamageTunables Tunables = AllyAbilityComp ? AllyAbilityComp->GetDamageTunables() : FDamageTunables::Get();
+    OutPreview = SkillPreviewCache.Get(*Skill, *CasterStats, *TargetStats, Tunables);
+    return true;
+}
+
+FText UTurnBasedCombatComponent::GetSkillPreviewText(USkillData* Skill, AActor* Target)
+{
+    FSkillPreview Preview;
+    return GetSkillPreview(Skill, Target, Preview) ? Preview.ToText() : FText::GetEmpty();
+}
+
 void UTurnBasedCombatComponent::OnPlayerDefense()
 {
     UE_LOG(LogTemp, Log, TEXT("OnPlayerDefense - Called"));
@@ -630,7 +755,7 @@ void UTurnBasedCombatComponent::OnPlayerDefense()
 
     if (UStatComponent* StatComp = PlayerActor->FindComponentByClass<UStatComponent>())
     {
-        StatComp->bIsDefending = true;
+        StatComp->SetDefending(true);
         UE_LOG(LogTemp, Log, TEXT("OnPlayerDefense - Player is defending (bIsDefending activated)"));
     }
     else
@@ -663,6 +788,8 @@ void UTurnBasedCombatComponent::OnEnemyTurn()
         return;
     }
 
+    ChooseEnemyAction(EnemyActor);
+
     if (EnemyAttackTimeline)
     {
         EnemyAttackTimeline->Stop();
@@ -674,7 +801,7 @@ void UTurnBasedCombatComponent::OnEnemyTurn()
     if (!EnemyAttackTimeline || !EnemyAttackCurve)
     {
         UE_LOG(LogTemp, Warning, TEXT("OnEnemyTurn - Failed to create timeline or EnemyAttackCurve not set"));
-        ExecuteEnemyDefaultAttack();
+        ExecuteEnemyAction();
         return;
     }
 
@@ -695,6 +822,113 @@ void UTurnBasedCombatComponent::OnEnemyTurn()
     EnemyAttackTimeline->PlayFromStart();
 }
 
+void UTurnBasedCombatComponent::CycleTarget(int32 Direction)
+{
+    const bool bAbilityMode = bIsSelectingAbilityTarget && CurrentSelectedAbility;
+    if ((!bAbilityMode && !bIsSelectingTarget) || IsAbilityCastPlaying())
+    {
+        return;
+    }
+    // Self-targeted, All and Random skills have no target to move.
+    if (bAbilityMode && (FCombatTargetCache::TargetsCaster(CurrentSelectedAbility->TargetType) ||
+        CurrentSelectedAbility->TargetMode == ETargetMode::All || CurrentSelectedAbility->TargetMode == ETargetMode::Random))
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
+    if (!IsValid(PC))
+    {
+        return;
+    }
+
+    // Same candidates as hovering in TickComponent; the ring is ordered once per selection.
+    const FCombatTargetCache& Targets = GetTargetCache();
+    const int32 PlayerSlot = Targets.FindSlot(UGameplayStatics::GetPlayerCharacter(World, 0));
+    const FCombatTargetCache::FMask Candidates = bAbilityMode ? Targets.GetValidTargets(PlayerSlot, *CurrentSelectedAbility) : Targets.GetAttackTargets(PlayerSlot);
+    if (!TargetRing.IsBuilt() || TargetRing.GetCandidates() != Candidates)
+    {
+        TargetPicker.Update(*PC, Targets);
+        TargetRing.Build(Candidates, TargetPicker);
+    }
+
+    AActor* CurrentTarget = bAbilityMode ? AbilityTarget : EntityIndicatorTarget;
+    AActor* NewTarget = Targets.GetActor(TargetRing.Step(Targets.FindSlot(CurrentTarget), Direction));
+    if (!IsValid(NewTarget) || NewTarget == CurrentTarget)
+    {
+        return;
+    }
+
+    SetEntityIndicator(NewTarget);
+    if (bAbilityMode)
+    {
+        AbilityTarget = NewTarget;
+    }
+    else
+    {
+        bTargetLocked = true;
+    }
+    UE_LOG(LogTemp, Log, TEXT("CycleTarget - Target locked: %s"), *NewTarget->GetName());
+}
+
+void UTurnBasedCombatComponent::ConfirmTargetSelection()
+{
+    if (IsAbilityCastPlaying())
+    {
+        return;
+    }
+
+    if (bIsSelectingAbilityTarget && CurrentSelectedAbility)
+    {
+        // Single and Multiple skills need a chosen target; the others already know theirs.
+        const bool bNeedsTarget = !FCombatTargetCache::TargetsCaster(CurrentSelectedAbility->TargetType) &&
+            CurrentSelectedAbility->TargetMode != ETargetMode::All && CurrentSelectedAbility->TargetMode != ETargetMode::Random;
+        if (bNeedsTarget && !IsValid(AbilityTarget))
+        {
+            UE_LOG(LogTemp, Log, TEXT("ConfirmTargetSelection - No target selected"));
+            return;
+        }
+        ConfirmAbilityCast();
+    }
+    else if (bIsSelectingTarget && bTargetLocked)
+    {
+        // Second call of OnPlayerAttack: confirms the locked target.
+        OnPlayerAttack();
+    }
+}
+
+void UTurnBasedCombatComponent::CancelTargetSelection()
+{
+    if (IsAbilityCastPlaying())
+    {
+        return;
+    }
+
+    if (bIsSelectingAbilityTarget)
+    {
+        HideAbilitiesMenu();
+    }
+    else if (bIsSelectingTarget)
+    {
+        bIsSelectingTarget = false;
+        bTargetLocked = false;
+        if (IsValid(EntityIndicatorTarget))
+        {
+            RemoveFeedbackFromEntity(EntityIndicatorTarget);
+            EntityIndicatorTarget = nullptr;
+        }
+        ReleaseEnemyIndicatorWidget();
+        UE_LOG(LogTemp, Log, TEXT("CancelTargetSelection - Default attack target selection cancelled"));
+    }
+    TargetRing.Reset();
+}
+
+bool UTurnBasedCombatComponent::IsAbilityCastPlaying() const
+{
+    return IsValid(AbilityCastingTimeline) && AbilityCastingTimeline->IsPlaying();
+}
+
 void UTurnBasedCombatComponent::HideAbilitiesMenu()
 {
     UE_LOG(LogTemp, Log, TEXT("HideAbilitiesMenu called, returning to main action menu"));
@@ -711,20 +945,9 @@ void UTurnBasedCombatComponent::HideAbilitiesMenu()
     CurrentSelectedAbility = nullptr;
     AbilityTarget = nullptr;
 
-    if (IsValid(CurrentEnemyIndicatorWidget))
-    {
-        CurrentEnemyIndicatorWidget->RemoveFromParent();
-        CurrentEnemyIndicatorWidget = nullptr;
-    }
+    ReleaseEnemyIndicatorWidget();
 
-    for (auto& Elem : MultiTargetIndicatorWidgets)
-    {
-        if (IsValid(Elem.Value))
-        {
-            Elem.Value->RemoveFromParent();
-        }
-    }
-    MultiTargetIndicatorWidgets.Empty();
+    ReleaseMultiTargetIndicatorWidgets();
 
     if (IsValid(EntityIndicatorTarget))
     {
@@ -822,6 +1045,33 @@ void UTurnBasedCombatComponent::ConfirmAbilityCast()
     FinishedFunction.BindUFunction(this, FName("OnAbilityCastingTimelineFinished"));
     AbilityCastingTimeline->SetTimelineFinishedFunc(FinishedFunction);
 
+    // Play the cast montage and effect only if they are already loaded (preloaded bundle or hover prefetch):
+    // casting must never wait on a synchronous load.
+    ACharacter* PlayerCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+    if (UAnimMontage* CastMontage = CurrentSelectedAbility->CastMontage.Get())
+    {
+        if (PlayerCharacter)
+        {
+            PlayerCharacter->PlayAnimMontage(CastMontage);
+        }
+    }
+    else if (!CurrentSelectedAbility->CastMontage.IsNull())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ConfirmAbilityCast - Cast montage of %s is not preloaded, skipped"), *CurrentSelectedAbility->GetName());
+    }
+    if (UNiagaraSystem* CastEffect = CurrentSelectedAbility->CastEffect.Get())
+    {
+        if (PlayerCharacter)
+        {
+            UNiagaraFunctionLibrary::SpawnSystemAttached(CastEffect, PlayerCharacter->GetRootComponent(), NAME_None,
+                FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget, true);
+        }
+    }
+    else if (!CurrentSelectedAbility->CastEffect.IsNull())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ConfirmAbilityCast - Cast effect of %s is not loaded yet, skipped"), *CurrentSelectedAbility->GetName());
+    }
+
     // Lancer la timeline.
     AbilityCastingTimeline->PlayFromStart();
 }
@@ -829,6 +1079,7 @@ void UTurnBasedCombatComponent::ConfirmAbilityCast()
 void UTurnBasedCombatComponent::NextTurn()
 {
     UE_LOG(LogTemp, Log, TEXT("NextTurn - Called. CurrentTurnIndex: %d, Total Combatants: %d"), CurrentTurnIndex, Combatants.Num());
+    InvalidateTargetCache();
 
     // Reset targeting variables.
     bIsSelectingTarget = false;
@@ -841,12 +1092,7 @@ void UTurnBasedCombatComponent::NextTurn()
         EntityIndicatorTarget = nullptr;
     }
 
-    if (IsValid(CurrentEnemyIndicatorWidget))
-    {
-        CurrentEnemyIndicatorWidget->RemoveFromParent();
-        CurrentEnemyIndicatorWidget = nullptr;
-        UE_LOG(LogTemp, Log, TEXT("NextTurn - Removed enemy indicator widget"));
-    }
+    ReleaseEnemyIndicatorWidget();
 
     ++CurrentTurnIndex;
     UE_LOG(LogTemp, Log, TEXT("NextTurn - Incremented turn index to: %d"), CurrentTurnIndex);
@@ -892,6 +1138,15 @@ void UTurnBasedCombatComponent::NextTurn()
 
     UpdateTurnOrderHUD();
 
+    // Stunned combatants lose their turn.
+    if (ShouldSkipTurn(Combatants[CurrentTurnIndex]))
+    {
+        UE_LOG(LogTemp, Log, TEXT("NextTurn - %s loses its turn"), *Combatants[CurrentTurnIndex]->GetName());
+        ConsumeSkippedTurn(Combatants[CurrentTurnIndex]);
+        NextTurn();
+        return;
+    }
+
     UWorld* World = GetWorld();
     AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
     if (!IsValid(PlayerActor))
@@ -931,6 +1186,7 @@ void UTurnBasedCombatComponent::NextTurn()
             HPC->EnableCombatInputMode();
             UE_LOG(LogTemp, Log, TEXT("NextTurn - Combat input mode enabled for player"));
         }
+        StartEnemySpeculation();
     }
     else // Enemy turn.
     {
@@ -962,15 +1218,23 @@ void UTurnBasedCombatComponent::EndRound()
         return;
     }
 
-    // Decrement modifiers on all combatants so expired buffs/debuffs are removed.
+    // Decrement modifiers on all combatants so expired buffs/debuffs are removed, and count down breaks.
     for (AActor* Combatant : Combatants)
     {
         if (UStatComponent* StatComp = Combatant->FindComponentByClass<UStatComponent>())
         {
             StatComp->DecrementStatModifiers();
+            StatComp->ProcessBreakRoundEnd();
         }
     }
 
+    // Tick and expire status effects in one batched pass (Poison/Regen may change Health before the checks below).
+    UStatusEffectSubsystem* StatusEffects = World->GetSubsystem<UStatusEffectSubsystem>();
+    if (StatusEffects)
+    {
+        StatusEffects->ProcessRoundEnd();
+    }
+
     ACharacter* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
     TArray<AActor*> NewCombatants;
     TArray<AActor*> AliveEnemies;
@@ -988,7 +1252,7 @@ void UTurnBasedCombatComponent::EndRound()
             else
             {
                 UE_LOG(LogTemp, Log, TEXT("EndRound - Player is defeated"));
-                UGameplayStatics::OpenLevel(World, OriginalMapName);
+                OnPlayerDefeated();
                 return;
             }
         }
@@ -1013,6 +1277,10 @@ void UTurnBasedCombatComponent::EndRound()
             else
             {
                 UE_LOG(LogTemp, Log, TEXT("EndRound - Enemy %s is defeated"), *Enemy->GetName());
+                if (StatusEffects)
+                {
+                    StatusEffects->RemoveAllEffects(StatComp);
+                }
                 Enemy->Destroy();
             }
         }
@@ -1106,45 +1374,14 @@ void UTurnBasedCombatComponent::EndRound()
     UpdateTurnOrderHUD();
     UE_LOG(LogTemp, Log, TEXT("EndRound - Turn order HUD updated"));
 
-    if (Combatants.Num() > 0)
+    StartCurrentTurn();
+
+    if (IsValid(PlayerActor))
     {
-        if (Combatants[0] == PlayerActor)
+        if (UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>())
         {
-            if (IsValid(PlayerTurnMenuWidget))
-            {
-                PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Visible);
-                UE_LOG(LogTemp, Log, TEXT("EndRound - PlayerTurnMenuWidget set to visible"));
-            }
-            APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
-            if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
-            {
-                HPC->EnableCombatInputMode();
-                UE_LOG(LogTemp, Log, TEXT("EndRound - Combat input mode enabled for player"));
-            }
-        }
-        else
-        {
-            if (IsValid(PlayerTurnMenuWidget))
-            {
-                PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Hidden);
-                UE_LOG(LogTemp, Log, TEXT("EndRound - PlayerTurnMenuWidget hidden for enemy turn"));
-            }
-            APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
-            if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
-            {
-                HPC->DisableCombatInputMode();
-                UE_LOG(LogTemp, Log, TEXT("EndRound - Combat input mode disabled for player"));
-            }
-            OnEnemyTurn();
-        }
-    }
-
-    if (IsValid(PlayerActor))
-    {
-        if (UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>())
-        {
-            PlayerStat->bIsDefending = false;
-            UE_LOG(LogTemp, Log, TEXT("EndRound - Player defense bonus cleared."));
+            PlayerStat->SetDefending(false);
+            UE_LOG(LogTemp, Log, TEXT("EndRound - Player defense bonus cleared."));
         }
     }
 
@@ -1154,6 +1391,56 @@ void UTurnBasedCombatComponent::EndRound()
     UE_LOG(LogTemp, Log, TEXT("EndRound - End"));
 }
 
+void UTurnBasedCombatComponent::StartCurrentTurn()
+{
+    InvalidateTargetCache();
+    if (!Combatants.IsValidIndex(CurrentTurnIndex))
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
+    AActor* Combatant = Combatants[CurrentTurnIndex];
+
+    if (ShouldSkipTurn(Combatant))
+    {
+        UE_LOG(LogTemp, Log, TEXT("StartCurrentTurn - %s loses its turn"), *Combatant->GetName());
+        ConsumeSkippedTurn(Combatant);
+        NextTurn();
+    }
+    else if (Combatant == PlayerActor)
+    {
+        if (IsValid(PlayerTurnMenuWidget))
+        {
+            PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Visible);
+            UE_LOG(LogTemp, Log, TEXT("StartCurrentTurn - PlayerTurnMenuWidget set to visible"));
+        }
+        APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
+        if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
+        {
+            HPC->EnableCombatInputMode();
+            UE_LOG(LogTemp, Log, TEXT("StartCurrentTurn - Combat input mode enabled for player"));
+        }
+        StartEnemySpeculation();
+    }
+    else
+    {
+        if (IsValid(PlayerTurnMenuWidget))
+        {
+            PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Hidden);
+            UE_LOG(LogTemp, Log, TEXT("StartCurrentTurn - PlayerTurnMenuWidget hidden for enemy turn"));
+        }
+        APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
+        if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
+        {
+            HPC->DisableCombatInputMode();
+            UE_LOG(LogTemp, Log, TEXT("StartCurrentTurn - Combat input mode disabled for player"));
+        }
+        OnEnemyTurn();
+    }
+}
+
 void UTurnBasedCombatComponent::UpdateTurnOrderHUD()
 {
     UE_LOG(LogTemp, Log, TEXT("UpdateTurnOrderHUD - Called"));
@@ -1204,6 +1491,7 @@ void UTurnBasedCombatComponent::OnPlayerFlee()
 {
     UE_LOG(LogTemp, Log, TEXT("OnPlayerFlee - Called"));
     bPlayerFled = true;
+    EnemySpeculation.Reset();
     if (IsValid(PlayerTurnMenuWidget))
     {
         PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Hidden);
@@ -1221,39 +1509,344 @@ void UTurnBasedCombatComponent::OnPlayerFlee()
 }
 
 //////////////////////////////////////////////////////////////////////////
-// Feedback Helper Functions
+// Defeat and Retry
 
-void UTurnBasedCombatComponent::ApplyFeedbackToEntity(AActor* Target)
+void UTurnBasedCombatComponent::OnPlayerDefeated()
 {
-    UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Called for target: %s"), IsValid(Target) ? *Target->GetName() : TEXT("None"));
-    if (!IsValid(Target) || !IsValid(EntityIndicatorLightFunctionMaterial))
+    UE_LOG(LogTemp, Log, TEXT("OnPlayerDefeated - Called"));
+    UWorld* World = GetWorld();
+    APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0);
+    if (!DefeatMenuWidgetClass || !bHasInitialSnapshot || !IsValid(PC))
+    {
+        UE_LOG(LogTemp, Log, TEXT("OnPlayerDefeated - No defeat menu, returning to base level"));
+        UGameplayStatics::OpenLevel(World, OriginalMapName);
+        return;
+    }
+
+    if (IsValid(PlayerTurnMenuWidget))
+    {
+        PlayerTurnMenuWidget->SetVisibility(ESlateVisibility::Hidden);
+    }
+
+    if (!IsValid(DefeatMenuWidget))
+    {
+        DefeatMenuWidget = CreateWidget<UDefeatMenuWidget>(PC, DefeatMenuWidgetClass);
+        if (IsValid(DefeatMenuWidget))
+        {
+            DefeatMenuWidget->AddToViewport();
+            DefeatMenuWidget->OnRetrySelected.AddDynamic(this, &UTurnBasedCombatComponent::RetryCombat);
+            DefeatMenuWidget->OnQuitSelected.AddDynamic(this, &UTurnBasedCombatComponent::OnDefeatQuit);
+            UE_LOG(LogTemp, Log, TEXT("OnPlayerDefeated - DefeatMenuWidget created and events bound"));
+        }
+    }
+    if (IsValid(DefeatMenuWidget))
+    {
+        DefeatMenuWidget->SetVisibility(ESlateVisibility::Visible);
+    }
+
+    // The defeat menu needs the mouse cursor.
+    if (AHikariPlayerController* HPC = Cast<AHikariPlayerController>(PC))
+    {
+        HPC->EnableCombatInputMode();
+    }
+}
+
+void UTurnBasedCombatComponent::OnDefeatQuit()
+{
+    UE_LOG(LogTemp, Log, TEXT("OnDefeatQuit - Returning to base level"));
+    UGameplayStatics::OpenLevel(GetWorld(), OriginalMapName);
+}
+
+void UTurnBasedCombatComponent::RetryCombat()
+{
+    UE_LOG(LogTemp, Log, TEXT("RetryCombat - Called"));
+    UWorld* World = GetWorld();
+    if (!IsValid(World))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RetryCombat - World is invalid"));
+        return;
+    }
+
+    if (!bHasInitialSnapshot)
     {
+        UE_LOG(LogTemp, Warning, TEXT("RetryCombat - No opening snapshot, reloading the level"));
+        UGameplayStatics::OpenLevel(World, OriginalMapName);
         return;
     }
 
-    // Retrieve the mesh (try skeletal first, then static).
-    UPrimitiveComponent* Mesh = Cast<UPrimitiveComponent>(Target->GetComponentByClass(USkeletalMeshComponent::StaticClass()));
-    if (!IsValid(Mesh))
+    if (IsValid(DefeatMenuWidget))
+    {
+        DefeatMenuWidget->SetVisibility(ESlateVisibility::Hidden);
+    }
+
+    // Clear any pending selection, indicator widgets and material feedback.
+    HideAbilitiesMenu();
+    bIsSelectingTarget = false;
+    bTargetLocked = false;
+    bTargetConfirmed = false;
+    bPlayerFled = false;
+
+    // Resolve the actor of every snapshot slot, respawning the enemies defeated since the opening turn.
+    UCombatManagerComponent* CombatManager = FindCombatManager();
+    TArray<AActor*> Actors;
+    Actors.Reserve(InitialSnapshotActors.Num());
+    for (int32 Slot = 0; Slot < InitialSnapshotActors.Num(); Slot++)
+    {
+        AActor* Actor = InitialSnapshotActors[Slot].Get();
+        const int32 EnemyIndex = InitialSnapshotEnemyIndices[Slot];
+        if (!IsValid(Actor) && CombatManager && EnemyIndex != INDEX_NONE)
+        {
+            Actor = CombatManager->RespawnEnemy(EnemyIndex);
+            InitialSnapshotActors[Slot] = Actor;
+        }
+        Actors.Add(Actor);
+    }
+
+    RestoreSnapshot(InitialSnapshot, Actors);
+
+    // Fresh rolls, so the retry does not replay the lost battle.
+    if (UCombatRandomSubsystem* CombatRandom = World->GetSubsystem<UCombatRandomSubsystem>())
+    {
+        CombatRandom->Reseed(FMath::Rand());
+    }
+
+    StartCurrentTurn();
+    UE_LOG(LogTemp, Log, TEXT("RetryCombat - End"));
+}
+
+UCombatManagerComponent* UTurnBasedCombatComponent::FindCombatManager() const
+{
+    if (UCombatManagerComponent* CombatManager = GetOwner()->FindComponentByClass<UCombatManagerComponent>())
+    {
+        return CombatManager;
+    }
+
+    for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+    {
+        if (UCombatManagerComponent* CombatManager = It->FindComponentByClass<UCombatManagerComponent>())
+        {
+            return CombatManager;
+        }
+    }
+    return nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Snapshots
+
+void UTurnBasedCombatComponent::CaptureSnapshot(FCombatSnapshot& OutSnapshot, TArray<AActor*>& OutActors) const
+{
+    OutActors.Reset();
+    OutSnapshot.NumCombatants = 0;
+
+    UWorld* World = GetWorld();
+    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
+    const UStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+
+    // Combatants is the turn queue: slot i is the i-th combatant to act this round.
+    // Actors without stats get no slot, so the turn index is remapped to the slot of the current actor
+    // (or of the next captured one if the current actor is not captured).
+    OutSnapshot.CurrentTurnIndex = INDEX_NONE;
+    for (int32 TurnIndex = 0; TurnIndex < Combatants.Num(); TurnIndex++)
+    {
+        AActor* Actor = Combatants[TurnIndex];
+        if (TurnIndex == CurrentTurnIndex)
+        {
+            OutSnapshot.CurrentTurnIndex = OutSnapshot.NumCombatants;
+        }
+        if (OutSnapshot.NumCombatants >= FCombatSnapshot::MaxCombatants)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CaptureSnapshot - More than %d combatants, the rest is not captured"), FCombatSnapshot::MaxCombatants);
+            break;
+        }
+
+        const UStatComponent* StatComp = IsValid(Actor) ? Actor->FindComponentByClass<UStatComponent>() : nullptr;
+        if (!StatComp)
+        {
+            continue;
+        }
+
+        const int32 Slot = OutSnapshot.NumCombatants++;
+        FCombatantSnapshot& CombatantSnapshot = OutSnapshot.Combatants[Slot];
+        StatComp->CaptureSnapshot(CombatantSnapshot);
+        CombatantSnapshot.bIsPlayer = (Actor == PlayerActor);
+
+        for (int32 Type = 0; Type < FCombatantSnapshot::NumStatusEffectTypes; Type++)
+        {
+            const FStatusEffectInstance* Effect = StatusEffects ? StatusEffects->FindEffect(StatComp, static_cast<EStatusEffectType>(Type)) : nullptr;
+            CombatantSnapshot.StatusEffects[Type].Magnitude = Effect ? Effect->Magnitude : 0.f;
+            CombatantSnapshot.StatusEffects[Type].RemainingTurns = Effect ? Effect->RemainingTurns : 0;
+        }
+
+        OutSnapshot.TurnOrder[Slot] = static_cast<int8>(Slot);
+        OutActors.Add(Actor);
+    }
+
+    OutSnapshot.NumTurns = OutSnapshot.NumCombatants;
+    if (OutSnapshot.CurrentTurnIndex == INDEX_NONE || OutSnapshot.CurrentTurnIndex > OutSnapshot.NumTurns)
+    {
+        // The round is over (or the current actor was past the captured ones).
+        OutSnapshot.CurrentTurnIndex = OutSnapshot.NumTurns;
+    }
+    OutSnapshot.bPlayerDefendedThisRound = bPlayerDefendedThisRound;
+    OutSnapshot.bDefenseConsumed = bDefenseConsumed;
+
+    const FRandomStream* CombatRandom = UCombatRandomSubsystem::GetStream(this);
+    OutSnapshot.RandomInitialSeed = CombatRandom ? CombatRandom->GetInitialSeed() : 0;
+    OutSnapshot.RandomSeed = CombatRandom ? CombatRandom->GetCurrentSeed() : 0;
+}
+
+void UTurnBasedCombatComponent::RestoreSnapshot(const FCombatSnapshot& Snapshot, const TArray<AActor*>& Actors)
+{
+    UWorld* World = GetWorld();
+    UStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+    if (StatusEffects)
+    {
+        StatusEffects->ResetPools();
+    }
+
+    for (int32 Slot = 0; Slot < Snapshot.NumCombatants && Slot < Actors.Num(); Slot++)
+    {
+        UStatComponent* StatComp = IsValid(Actors[Slot]) ? Actors[Slot]->FindComponentByClass<UStatComponent>() : nullptr;
+        if (!StatComp)
+        {
+            continue;
+        }
+
+        const FCombatantSnapshot& CombatantSnapshot = Snapshot.Combatants[Slot];
+        StatComp->RestoreSnapshot(CombatantSnapshot);
+
+        if (StatusEffects)
+        {
+            for (int32 Type = 0; Type < FCombatantSnapshot::NumStatusEffectTypes; Type++)
+            {
+                const FStatusEffectSnapshot& Effect = CombatantSnapshot.StatusEffects[Type];
+                if (Effect.RemainingTurns > 0)
+                {
+                    StatusEffects->ApplyEffect(StatComp, static_cast<EStatusEffectType>(Type), Effect.Magnitude, Effect.RemainingTurns);
+                }
+            }
+        }
+    }
+
+    // Rebuild the turn queue; the turn index follows the current actor if earlier entries are dropped.
+    Combatants.Reset();
+    CurrentTurnIndex = INDEX_NONE;
+    for (int32 i = 0; i < Snapshot.NumTurns; i++)
+    {
+        if (i == Snapshot.CurrentTurnIndex)
+        {
+            CurrentTurnIndex = Combatants.Num();
+        }
+        const int32 Slot = Snapshot.TurnOrder[i];
+        if (Actors.IsValidIndex(Slot) && IsValid(Actors[Slot]))
+        {
+            Combatants.Add(Actors[Slot]);
+        }
+    }
+    if (CurrentTurnIndex == INDEX_NONE)
+    {
+        CurrentTurnIndex = Combatants.Num();
+    }
+    InvalidateTargetCache();
+    bPlayerDefendedThisRound = Snapshot.bPlayerDefendedThisRound != 0;
+    bDefenseConsumed = Snapshot.bDefenseConsumed != 0;
+
+    if (UCombatRandomSubsystem* CombatRandom = World ? World->GetSubsystem<UCombatRandomSubsystem>() : nullptr)
+    {
+        CombatRandom->RestoreState(Snapshot.RandomInitialSeed, Snapshot.RandomSeed);
+    }
+
+    UpdateTurnOrderHUD();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Target Cache
+
+const FCombatTargetCache& UTurnBasedCombatComponent::GetTargetCache()
+{
+    if (TargetCache.IsBuilt())
+    {
+        return TargetCache;
+    }
+
+    for (const TWeakObjectPtr<UStatComponent>& Bound : TargetCacheBindings)
+    {
+        if (UStatComponent* StatComp = Bound.Get())
+        {
+            StatComp->OnStatChangedNative.RemoveAll(this);
+        }
+    }
+    TargetCacheBindings.Reset();
+
+    TargetCache.Build(Combatants, UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+    // Deaths and spent Technique Points update the table without waiting for the next turn.
+    for (int32 Slot = 0; Slot < TargetCache.Num(); Slot++)
+    {
+        if (UStatComponent* StatComp = TargetCache.GetStatComponent(Slot))
+        {
+            StatComp->OnStatChangedNative.AddUObject(this, &UTurnBasedCombatComponent::HandleCombatantStatChanged);
+            TargetCacheBindings.Add(StatComp);
+        }
+    }
+    return TargetCache;
+}
+
+void UTurnBasedCombatComponent::InvalidateTargetCache()
+{
+    TargetCache.Invalidate();
+}
+
+void UTurnBasedCombatComponent::HandleBalanceReloaded()
+{
+    // The next preview and the next enemy decision are computed with the new constants.
+    SkillPreviewCache.Reset();
+    EnemySpeculation.Reset();
+    SpeculationActors.Reset();
+    UE_LOG(LogTemp, Log, TEXT("HandleBalanceReloaded - Dropped cached previews and speculated decisions"));
+}
+
+void UTurnBasedCombatComponent::HandleCombatantStatChanged(UStatComponent* StatComponent, EStatChannel Channel)
+{
+    if (!TargetCache.IsBuilt() || !StatComponent)
     {
-        Mesh = Cast<UPrimitiveComponent>(Target->GetComponentByClass(UStaticMeshComponent::StaticClass()));
+        return;
     }
-    if (!IsValid(Mesh))
+
+    const int32 Slot = TargetCache.FindSlot(StatComponent->GetOwner());
+    if (Slot == INDEX_NONE)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ApplyFeedbackToEntity - Mesh not found for target: %s"), *Target->GetName());
         return;
     }
 
-    // Store original material if not already stored.
-    if (!OriginalMaterials.Contains(Target))
+    if (Channel == EStatChannel::Health)
     {
-        UMaterialInterface* OrigMat = Mesh->GetMaterial(0);
-        OriginalMaterials.Add(Target, OrigMat);
-        UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Original material stored for target: %s"), *Target->GetName());
+        const bool bWasAlive = (TargetCache.GetAliveMask() & (FCombatTargetCache::FMask(1) << Slot)) != 0;
+        if (bWasAlive != (StatComponent->Health > 0.f))
+        {
+            InvalidateTargetCache();
+        }
+    }
+    else if (Channel == EStatChannel::TechniquePoints)
+    {
+        TargetCache.RefreshAffordableSkills(Slot);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Feedback Helper Functions
+
+void UTurnBasedCombatComponent::ApplyFeedbackToEntity(AActor* Target)
+{
+    UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Called for target: %s"), IsValid(Target) ? *Target->GetName() : TEXT("None"));
+    if (!IsValid(Target))
+    {
+        return;
     }
 
-    // Apply feedback material.
-    Mesh->SetMaterial(0, EntityIndicatorLightFunctionMaterial);
-    UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Applied indicator material to target: %s"), *Target->GetName());
+    // A no-op when the target is already highlighted (self and heal skills re-select the player every tick).
+    SetSelectionHighlight(Target, true);
 
     // If in multi-target mode ("All"), manage individual widgets.
     if (CurrentSelectedAbility && (CurrentSelectedAbility->TargetMode == ETargetMode::All || 
@@ -1261,22 +1854,17 @@ void UTurnBasedCombatComponent::ApplyFeedbackToEntity(AActor* Target)
     {
         if (!MultiTargetIndicatorWidgets.Contains(Target))
         {
-            APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-            if (IsValid(PC) && IsValid(EnemyIndicatorWidgetClass))
+            if (UEnemyIndicatorWidget* IndicatorWidget = AcquireIndicatorWidget())
             {
-                UEnemyIndicatorWidget* IndicatorWidget = CreateWidget<UEnemyIndicatorWidget>(PC, EnemyIndicatorWidgetClass);
-                if (IsValid(IndicatorWidget))
-                {
-                    IndicatorWidget->AddToViewport();
-                    MultiTargetIndicatorWidgets.Add(Target, IndicatorWidget);
-                    UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Created indicator widget for target: %s"), *Target->GetName());
-                }
+                MultiTargetIndicatorWidgets.Add(Target, IndicatorWidget);
+                UE_LOG(LogTemp, Log, TEXT("ApplyFeedbackToEntity - Acquired indicator widget for target: %s"), *Target->GetName());
             }
         }
         if (UEnemyIndicatorWidget** pIndicatorWidget = MultiTargetIndicatorWidgets.Find(Target))
         {
             UEnemyIndicatorWidget* IndicatorWidget = *pIndicatorWidget;
             UpdateIndicatorWidgetForTarget(Target, IndicatorWidget);
+            IndicatorWidget->SetPreview(GetSkillPreviewText(CurrentSelectedAbility, Target));
         }
     }
     else
@@ -1297,23 +1885,68 @@ void UTurnBasedCombatComponent::RemoveFeedbackFromEntity(AActor* Enemy)
         return;
     }
 
-    UPrimitiveComponent* Mesh = Cast<UPrimitiveComponent>(Enemy->GetComponentByClass(USkeletalMeshComponent::StaticClass()));
-    if (!IsValid(Mesh))
-    {
-        Mesh = Cast<UPrimitiveComponent>(Enemy->GetComponentByClass(UStaticMeshComponent::StaticClass()));
-    }
-    if (!IsValid(Mesh))
+    SetSelectionHighlight(Enemy, false);
+}
+
+void UTurnBasedCombatComponent::SetSelectionHighlight(AActor* Target, bool bHighlighted)
+{
+    if (!IsValid(SelectionHighlightVolume) && IsValid(SelectionFallbackMaterial))
     {
-        UE_LOG(LogTemp, Warning, TEXT("RemoveFeedbackFromEntity - Mesh not found for enemy: %s"), *Enemy->GetName());
+        // Without an outline pass, the surface material replaces slot 0 of the first mesh while selected.
+        UMeshComponent* Mesh = Target->FindComponentByClass<UMeshComponent>();
+        if (!IsValid(Mesh))
+        {
+            return;
+        }
+        if (bHighlighted && !OriginalMaterials.Contains(Target))
+        {
+            OriginalMaterials.Add(Target, Mesh->GetMaterial(0));
+            Mesh->SetMaterial(0, SelectionFallbackMaterial);
+        }
+        else if (!bHighlighted)
+        {
+            UMaterialInterface* OriginalMaterial = nullptr;
+            if (OriginalMaterials.RemoveAndCopyValue(Target, OriginalMaterial))
+            {
+                Mesh->SetMaterial(0, OriginalMaterial);
+            }
+        }
         return;
     }
 
-    if (OriginalMaterials.Contains(Enemy))
+    // Both setters return early when the value is unchanged, so toggling costs no render state update.
+    Target->ForEachComponent<UMeshComponent>(false, [this, bHighlighted](UMeshComponent* Mesh)
+        {
+            if (bHighlighted)
+            {
+                Mesh->SetCustomDepthStencilValue(SelectionStencilValue);
+            }
+            Mesh->SetRenderCustomDepth(bHighlighted);
+        });
+}
+
+UEnemyIndicatorWidget* UTurnBasedCombatComponent::AcquireIndicatorWidget()
+{
+    // Normally prewarmed by StartCombat; this only binds the pool if combat UI is shown before that.
+    IndicatorPool.Prewarm(UGameplayStatics::GetPlayerController(GetWorld(), 0), EnemyIndicatorWidgetClass, 0);
+    return IndicatorPool.Acquire();
+}
+
+void UTurnBasedCombatComponent::ReleaseEnemyIndicatorWidget()
+{
+    IndicatorLayer.Hide(CurrentEnemyIndicatorWidget);
+    IndicatorPool.Release(CurrentEnemyIndicatorWidget);
+    CurrentEnemyIndicatorWidget = nullptr;
+}
+
+void UTurnBasedCombatComponent::ReleaseMultiTargetIndicatorWidgets()
+{
+    for (auto& Elem : MultiTargetIndicatorWidgets)
     {
-        Mesh->SetMaterial(0, OriginalMaterials[Enemy]);
-        OriginalMaterials.Remove(Enemy);
-        UE_LOG(LogTemp, Log, TEXT("RemoveFeedbackFromEntity - Restored original material for enemy: %s"), *Enemy->GetName());
+        IndicatorLayer.Hide(Elem.Value);
+        IndicatorPool.Release(Elem.Value);
     }
+    MultiTargetIndicatorWidgets.Reset();
 }
 
 void UTurnBasedCombatComponent::UpdateIndicatorWidgetForTarget(AActor* Target, UEnemyIndicatorWidget* IndicatorWidget)
@@ -1322,31 +1955,44 @@ void UTurnBasedCombatComponent::UpdateIndicatorWidgetForTarget(AActor* Target, U
     {
         return;
     }
-    APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    if (!IsValid(PC))
+    // Only this widget is placed right away (so one taken from the pool never shows at its previous position);
+    // the others are moved by the batched pass of the next tick.
+    IndicatorLayer.Show(IndicatorWidget, Target);
+    if (const APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0))
     {
-        return;
+        IndicatorLayer.Place(*PC, IndicatorWidget, IndicatorWorldVerticalOffset, IndicatorScreenOffset);
+    }
+}
+
+bool UTurnBasedCombatComponent::ShouldSkipTurn(AActor* Combatant) const
+{
+    if (!IsValid(Combatant))
+    {
+        return false;
     }
-    FVector WorldLocation = Target->GetActorLocation() + FVector(0.f, 0.f, IndicatorWorldVerticalOffset);
-    FVector2D ScreenPosition;
-    if (!PC->ProjectWorldLocationToScreen(WorldLocation, ScreenPosition))
+    // Stunned and broken combatants keep their slot in the turn order; only their action is skipped.
+    const UStatComponent* StatComp = Combatant->FindComponentByClass<UStatComponent>();
+    return StatComp && (StatComp->HasStatusEffect(EStatusEffectType::Stun) || StatComp->IsBroken());
+}
+
+void UTurnBasedCombatComponent::ConsumeSkippedTurn(AActor* Combatant)
+{
+    UStatComponent* StatComp = IsValid(Combatant) ? Combatant->FindComponentByClass<UStatComponent>() : nullptr;
+    if (!StatComp || !StatComp->HasStatusEffect(EStatusEffectType::Stun))
     {
         return;
     }
-    ScreenPosition += IndicatorScreenOffset;
-    IndicatorWidget->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
-    IndicatorWidget->SetPositionInViewport(ScreenPosition, false);
-    // Optionnel : mettre à jour le texte si Target a un StatComponent.
-    if (UStatComponent* StatComp = Target->FindComponentByClass<UStatComponent>())
+    // Stun durations count lost turns, so a stun applied after the target acted still costs its next turn.
+    if (UStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>())
     {
-        IndicatorWidget->SetEnemyName(StatComp->EntityName);
+        StatusEffects->ConsumeStunnedTurn(StatComp);
     }
 }
 
-float UTurnBasedCombatComponent::CalculateDamage(float BaseDamage, float TargetDefense) const
+float UTurnBasedCombatComponent::CalculateDamage(const UStatComponent& Attacker, const UStatComponent& Target) const
 {
-    float Damage = 0.8f * (BaseDamage - (TargetDefense * 0.5f));
-    return FMath::Max(Damage, 1.f);  // At least 1 damage is done
+    // Both sides come from the lazily evaluated derived caches; at least 1 damage is done.
+    return FDerivedCombatStats::BasicAttackDamage(Attacker.GetDerivedStats(), Attacker, Target.GetDerivedStats(), Target);
 }
 
 void UTurnBasedCombatComponent::OnPlayerAttackTimelineUpdate(float Value)
@@ -1373,7 +2019,7 @@ void UTurnBasedCombatComponent::OnEnemyAttackTimelineUpdate(float Value)
 void UTurnBasedCombatComponent::OnEnemyAttackTimelineFinished()
 {
     UE_LOG(LogTemp, Log, TEXT("Enemy Attack Timeline Finished"));
-    ExecuteEnemyDefaultAttack();
+    ExecuteEnemyAction();
 }
 
 void UTurnBasedCombatComponent::OnAbilityCastingTimelineUpdate(float Value)
@@ -1398,7 +2044,8 @@ void UTurnBasedCombatComponent::OnAbilityCastingTimelineFinished()
         {
             if (DefaultAbilityTargets.Num() > 0)
             {
-                int32 RandIndex = FMath::RandRange(0, DefaultAbilityTargets.Num() - 1);
+                FRandomStream* CombatRandom = UCombatRandomSubsystem::GetStream(this);
+                int32 RandIndex = CombatRandom ? CombatRandom->RandRange(0, DefaultAbilityTargets.Num() - 1) : FMath::RandRange(0, DefaultAbilityTargets.Num() - 1);
                 Targets.Add(DefaultAbilityTargets[RandIndex]);
             }
         }
@@ -1422,22 +2069,21 @@ void UTurnBasedCombatComponent::OnAbilityCastingTimelineFinished()
         }
 
         // Appeler ExecuteSkill pour appliquer la logique de l'ability.
-        float EffectResult = AllyAbilityComp->ExecuteSkill(CurrentSelectedAbility, Targets);
-        UE_LOG(LogTemp, Log, TEXT("OnAbilityCastingTimelineFinished: Ability executed with result: %f"), EffectResult);
+        // All targets are resolved in one batch; the UI gets every outcome in a single event.
+        TArray<FSkillHitResult> HitResults;
+        float EffectResult = AllyAbilityComp->ExecuteSkillWithResults(CurrentSelectedAbility, Targets, HitResults);
+        UE_LOG(LogTemp, Log, TEXT("OnAbilityCastingTimelineFinished: Ability executed with result: %f on %d target(s)"), EffectResult, HitResults.Num());
+        if (HitResults.Num() > 0)
+        {
+            OnMultiHitResolved.Broadcast(PlayerActor, CurrentSelectedAbility, HitResults);
+        }
 
         // Réinitialiser la sélection et supprimer les feedbacks.
         bIsSelectingAbilityTarget = false;
         CurrentSelectedAbility = nullptr;
         AbilityTarget = nullptr;
         DefaultAbilityTargets.Empty();
-        for (auto& Elem : MultiTargetIndicatorWidgets)
-        {
-            if (IsValid(Elem.Value))
-            {
-                Elem.Value->RemoveFromParent();
-            }
-        }
-        MultiTargetIndicatorWidgets.Empty();
+        ReleaseMultiTargetIndicatorWidgets();
         if (IsValid(PlayerTurnMenuWidget))
         {
             PlayerTurnMenuWidget->SetRenderOpacity(1.0f);
@@ -1463,15 +2109,15 @@ void UTurnBasedCombatComponent::ExecutePlayerDefaultAttack()
         return;
     }
 
-    float BaseDamage = AllyAbility->ExecuteDefaultAttack();
-    if (IsValid(EntityIndicatorTarget))
+    UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>();
+    if (IsValid(EntityIndicatorTarget) && PlayerStat)
     {
         if (UStatComponent* EnemyStat = EntityIndicatorTarget->FindComponentByClass<UStatComponent>())
         {
-            float EnemyDefense = EnemyStat->PhysicalDefense;
-            float CalculatedDamage = CalculateDamage(BaseDamage, EnemyDefense);
+            float CalculatedDamage = CalculateDamage(*PlayerStat, *EnemyStat);
             UE_LOG(LogTemp, Log, TEXT("ExecutePlayerDefaultAttack - Calculated damage: %f"), CalculatedDamage);
             EnemyStat->ApplyDamage(CalculatedDamage, false);
+            EnemyStat->ApplyShieldHit(PlayerStat->BasicAttackDamageTypeMask);
             // (Optional) Spawn attack FX and display a damage widget here.
             UE_LOG(LogTemp, Log, TEXT("ExecutePlayerDefaultAttack - Applied damage to enemy %s. New HP: %f/%f"),
                 *EntityIndicatorTarget->GetName(), EnemyStat->Health, EnemyStat->MaxHealth);
@@ -1480,15 +2126,275 @@ void UTurnBasedCombatComponent::ExecutePlayerDefaultAttack()
     NextTurn();
 }
 
-void UTurnBasedCombatComponent::ExecuteEnemyDefaultAttack()
+void UTurnBasedCombatComponent::ChooseEnemyAction(AActor* EnemyActor)
+{
+    PendingEnemySkill = nullptr;
+    PendingEnemyTargets.Reset();
+    EnemyLookahead.Reset();
+    EnemyDecisionActors.Reset();
+    EnemyDecisionSlot = INDEX_NONE;
+
+    UEnemyAbilityComponent* AbilityComp = EnemyActor->FindComponentByClass<UEnemyAbilityComponent>();
+    if (!AbilityComp || AbilityComp->Skills.Num() == 0)
+    {
+        return;
+    }
+
+    // Scoring reads a flat copy of the combat instead of the live components.
+    CaptureSnapshot(EnemyDecisionSnapshot, EnemyDecisionActors);
+    EnemyDecisionSlot = EnemyDecisionActors.IndexOfByKey(EnemyActor);
+    if (EnemyDecisionSlot == INDEX_NONE)
+    {
+        return;
+    }
+
+    // A decision speculated during the player's turn on this exact state is the one ChooseAction would return.
+    FSpeculatedDecision Speculated;
+    const bool bSpeculated = TakeSpeculatedDecision(Speculated);
+    SetPendingEnemyAction(*AbilityComp, bSpeculated ? Speculated.Action : AbilityComp->ChooseAction(EnemyDecisionSnapshot, EnemyDecisionSlot));
+
+    // Bosses refine the choice with a background search while their attack timeline plays.
+    const UEnemyAIProfile* Profile = AbilityComp->AIProfile ? AbilityComp->AIProfile : GetDefault<UEnemyAIProfile>();
+    if (EnemyDecisionSnapshot.Combatants[EnemyDecisionSlot].bIsBoss && Profile->LookaheadDepth > 0)
+    {
+        // A speculated search is only as good as the live one if it reached the full depth before its deadline.
+        if (bSpeculated && Speculated.Lookahead.CompletedDepth == Profile->LookaheadDepth)
+        {
+            UE_LOG(LogTemp, Log, TEXT("ChooseEnemyAction - Speculated search: depth %d, %d nodes in %.2f ms"),
+                Speculated.Lookahead.CompletedDepth, Speculated.Lookahead.NumNodes, Speculated.Lookahead.ElapsedSeconds * 1000.0);
+            SetPendingEnemyAction(*AbilityComp, Speculated.Lookahead.Action);
+            return;
+        }
+
+        FLookaheadRequest Request;
+        Request.Root.CopyFrom(EnemyDecisionSnapshot);
+        Request.SearcherSlot = EnemyDecisionSlot;
+        Request.MaxDepth = Profile->LookaheadDepth;
+        Request.BudgetSeconds = Profile->LookaheadBudgetMs / 1000.0;
+        CopyCombatantSkills(EnemyDecisionActors, Request.Skills, Request.Tunables);
+        // The other combatants are predicted with their own profile (the default one when they have none).
+        for (AActor* Actor : EnemyDecisionActors)
+        {
+            const UEnemyAbilityComponent* ActorAbilities = Actor->FindComponentByClass<UEnemyAbilityComponent>();
+            Request.Profiles.Add(ActorAbilities ? ActorAbilities->AIProfile : nullptr);
+        }
+        EnemyLookahead.Start(MoveTemp(Request));
+    }
+}
+
+void UTurnBasedCombatComponent::CopyCombatantSkills(const TArray<AActor*>& Actors, TArray<TArray<FUtilitySkill>>& OutSkills, TArray<FDamageTunables>& OutTunables) const
+{
+    // Skills are copied so the workers never read a UObject.
+    OutSkills.Reset(Actors.Num());
+    OutTunables.Reset(Actors.Num());
+    for (AActor* Actor : Actors)
+    {
+        TArray<FUtilitySkill>& Skills = OutSkills.AddDefaulted_GetRef();
+        FDamageTunables& Tunables = OutTunables.Add_GetRef(FDamageTunables::Get());
+        const TArray<USkillData*>* ActorSkills = nullptr;
+        if (const UEnemyAbilityComponent* EnemyAbilities = Actor->FindComponentByClass<UEnemyAbilityComponent>())
+        {
+            ActorSkills = &EnemyAbilities->Skills;
+            Tunables = EnemyAbilities->GetDamageTunables();
+        }
+        else if (const UAllyAbilityComponent* AllyAbilities = Actor->FindComponentByClass<UAllyAbilityComponent>())
+        {
+            ActorSkills = &AllyAbilities->Skills;
+            Tunables = AllyAbilities->GetDamageTunables();
+        }
+        if (ActorSkills)
+        {
+            for (const USkillData* ActorSkill : *ActorSkills)
+            {
+                // Empty entries keep their index but can never be afforded.
+                FUtilitySkill& Copy = Skills.Emplace_GetRef();
+                if (ActorSkill)
+                {
+                    Copy = FUtilitySkill(*ActorSkill);
+                }
+                else
+                {
+                    Copy.TechniqueCost = MAX_flt;
+                }
+            }
+        }
+    }
+}
+
+void UTurnBasedCombatComponent::StartEnemySpeculation()
+{
+    EnemySpeculation.Reset();
+    SpeculationActors.Reset();
+
+    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+    const UStatComponent* PlayerStat = IsValid(PlayerActor) ? PlayerActor->FindComponentByClass<UStatComponent>() : nullptr;
+    if (!PlayerStat)
+    {
+        return;
+    }
+
+    FSpeculationRequest Request;
+    CaptureSnapshot(Request.Root, SpeculationActors);
+    Request.PlayerSlot = SpeculationActors.IndexOfByKey(PlayerActor);
+    if (Request.PlayerSlot == INDEX_NONE)
+    {
+        return;
+    }
+    Request.PlayerBasicAttackDamageTypeMask = PlayerStat->BasicAttackDamageTypeMask;
+    CopyCombatantSkills(SpeculationActors, Request.Skills, Request.Tunables);
+
+    // Same profiles as ChooseEnemyAction; enemies without skills always use their default attack and are not speculated.
+    for (AActor* Actor : SpeculationActors)
+    {
+        const UEnemyAbilityComponent* AbilityComp = Actor->FindComponentByClass<UEnemyAbilityComponent>();
+        const bool bChoosesAction = AbilityComp && AbilityComp->Skills.Num() > 0;
+        Request.Profiles.Add(bChoosesAction ? (AbilityComp->AIProfile ? AbilityComp->AIProfile : GetDefault<UEnemyAIProfile>()) : nullptr);
+    }
+
+    EnemySpeculation.Start(MoveTemp(Request));
+}
+
+bool UTurnBasedCombatComponent::TakeSpeculatedDecision(FSpeculatedDecision& OutDecision)
+{
+    if (!EnemySpeculation.IsActive())
+    {
+        return false;
+    }
+
+    TArray<int32, TInlineAllocator<FCombatSnapshot::MaxCombatants>> RootSlots;
+    for (AActor* Actor : EnemyDecisionActors)
+    {
+        RootSlots.Add(SpeculationActors.IndexOfByKey(Actor));
+    }
+
+    // Never waits: a branch still running counts as a miss and the enemy decides now.
+    const bool bFound = EnemySpeculation.TryGetDecision(EnemyDecisionSnapshot, RootSlots, OutDecision);
+    EnemySpeculation.Reset();
+    SpeculationActors.Reset();
+    UE_LOG(LogTemp, Log, TEXT("TakeSpeculatedDecision - %s"), bFound ? TEXT("Using the decision speculated during the player's turn") : TEXT("No speculated state matches, deciding now"));
+    return bFound;
+}
+
+void UTurnBasedCombatComponent::SetPendingEnemyAction(const UEnemyAbilityComponent& AbilityComp, const FEnemyAction& Action)
+{
+    PendingEnemySkill = nullptr;
+    PendingEnemyTargets.Reset();
+
+    AActor* EnemyActor = AbilityComp.GetOwner();
+    if (Action.IsDefaultAttack() || !AbilityComp.Skills.IsValidIndex(Action.SkillIndex) || !AbilityComp.Skills[Action.SkillIndex])
+    {
+        // Keep the opponent the attack was scored against.
+        if (Action.IsDefaultAttack() && EnemyDecisionActors.IsValidIndex(Action.TargetSlot))
+        {
+            PendingEnemyTargets.Add(EnemyDecisionActors[Action.TargetSlot]);
+        }
+        UE_LOG(LogTemp, Log, TEXT("SetPendingEnemyAction - Enemy %s chose its default attack on %s (score %f)"),
+            *GetNameSafe(EnemyActor), PendingEnemyTargets.Num() > 0 ? *GetNameSafe(PendingEnemyTargets[0]) : TEXT("the player"), Action.Score);
+        return;
+    }
+
+    USkillData* Skill = AbilityComp.Skills[Action.SkillIndex];
+    if (Action.TargetSlot != INDEX_NONE)
+    {
+        if (EnemyDecisionActors.IsValidIndex(Action.TargetSlot))
+        {
+            PendingEnemyTargets.Add(EnemyDecisionActors[Action.TargetSlot]);
+        }
+    }
+    else
+    {
+        const FEnemyUtilityAI::FMask Targets = FEnemyUtilityAI::GetValidTargets(EnemyDecisionSnapshot, EnemyDecisionSlot, Skill->TargetType, Skill->AbilityCategory);
+        for (FEnemyUtilityAI::FMask Mask = Targets; Mask != 0; Mask &= Mask - 1)
+        {
+            PendingEnemyTargets.Add(EnemyDecisionActors[FMath::CountTrailingZeros64(Mask)]);
+        }
+    }
+    PendingEnemySkill = Skill;
+    UE_LOG(LogTemp, Log, TEXT("SetPendingEnemyAction - Enemy %s chose %s on %d target(s) (score %f)"),
+        *GetNameSafe(EnemyActor), *Skill->SkillName.ToString(), PendingEnemyTargets.Num(), Action.Score);
+}
+
+void UTurnBasedCombatComponent::ApplyEnemyLookaheadResult()
+{
+    // Never waits: an unfinished search leaves the utility choice in place.
+    FLookaheadResult Result;
+    const bool bFinished = EnemyLookahead.TryGetResult(Result);
+    const bool bWasRunning = EnemyLookahead.IsRunning();
+    EnemyLookahead.Reset();
+    if (!bFinished)
+    {
+        if (bWasRunning)
+        {
+            UE_LOG(LogTemp, Log, TEXT("ApplyEnemyLookaheadResult - Search still running, keeping the utility choice"));
+        }
+        return;
+    }
+    if (!EnemyDecisionActors.IsValidIndex(EnemyDecisionSlot))
+    {
+        return;
+    }
+
+    AActor* EnemyActor = EnemyDecisionActors[EnemyDecisionSlot];
+    const UEnemyAbilityComponent* AbilityComp = IsValid(EnemyActor) ? EnemyActor->FindComponentByClass<UEnemyAbilityComponent>() : nullptr;
+    if (!AbilityComp || Result.CompletedDepth == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ApplyEnemyLookaheadResult - No depth completed in %.2f ms, keeping the utility choice"), Result.ElapsedSeconds * 1000.0);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ApplyEnemyLookaheadResult - Depth %d, %d nodes in %.2f ms"), Result.CompletedDepth, Result.NumNodes, Result.ElapsedSeconds * 1000.0);
+    SetPendingEnemyAction(*AbilityComp, Result.Action);
+}
+
+void UTurnBasedCombatComponent::ExecuteEnemyAction()
+{
+    ApplyEnemyLookaheadResult();
+
+    USkillData* Skill = PendingEnemySkill;
+    TArray<AActor*> Targets = MoveTemp(PendingEnemyTargets);
+    PendingEnemySkill = nullptr;
+    PendingEnemyTargets.Reset();
+
+    AActor* EnemyActor = Combatants.IsValidIndex(CurrentTurnIndex) ? Combatants[CurrentTurnIndex] : nullptr;
+    UEnemyAbilityComponent* AbilityComp = IsValid(EnemyActor) ? EnemyActor->FindComponentByClass<UEnemyAbilityComponent>() : nullptr;
+    Targets.RemoveAll([](AActor* Target) { return !IsValid(Target); });
+    if (!Skill)
+    {
+        ExecuteEnemyDefaultAttack(Targets.Num() > 0 ? Targets[0] : nullptr);
+        return;
+    }
+    if (!AbilityComp || Targets.Num() == 0)
+    {
+        ExecuteEnemyDefaultAttack();
+        return;
+    }
+
+    if (Skill->TargetMode == ETargetMode::Random)
+    {
+        // Same roll as the player's random skills.
+        FRandomStream* CombatRandom = UCombatRandomSubsystem::GetStream(this);
+        const int32 RandIndex = CombatRandom ? CombatRandom->RandRange(0, Targets.Num() - 1) : FMath::RandRange(0, Targets.Num() - 1);
+        AActor* RandomTarget = Targets[RandIndex];
+        Targets.Reset();
+        Targets.Add(RandomTarget);
+    }
+
+    const float EffectResult = AbilityComp->ExecuteSkillOnTargets(Skill, Targets);
+    UE_LOG(LogTemp, Log, TEXT("ExecuteEnemyAction - Enemy %s cast %s with result: %f on %d target(s)"),
+        *EnemyActor->GetName(), *Skill->SkillName.ToString(), EffectResult, Targets.Num());
+    NextTurn();
+}
+
+void UTurnBasedCombatComponent::ExecuteEnemyDefaultAttack(AActor* Target)
 {
     UWorld* World = GetWorld();
     AActor* EnemyActor = Combatants.IsValidIndex(CurrentTurnIndex) ? Combatants[CurrentTurnIndex] : nullptr;
-    AActor* PlayerActor = UGameplayStatics::GetPlayerCharacter(World, 0);
+    // The target scored by the AI; the player when none was scored.
+    AActor* TargetActor = IsValid(Target) ? Target : UGameplayStatics::GetPlayerCharacter(World, 0);
 
-    if (!IsValid(EnemyActor) || !IsValid(PlayerActor))
+    if (!IsValid(EnemyActor) || !IsValid(TargetActor))
     {
-        UE_LOG(LogTemp, Warning, TEXT("ExecuteEnemyDefaultAttack - Invalid enemy or player actor"));
+        UE_LOG(LogTemp, Warning, TEXT("ExecuteEnemyDefaultAttack - Invalid enemy or target actor"));
         NextTurn();
         return;
     }
@@ -1496,11 +2402,11 @@ void UTurnBasedCombatComponent::ExecuteEnemyDefaultAttack()
     float DamageValue = 0.f;
     if (UEnemyAbilityComponent* AbilityComp = EnemyActor->FindComponentByClass<UEnemyAbilityComponent>())
     {
-        float BaseDamage = AbilityComp->ExecuteDefaultAttack();
-        if (UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>())
+        UStatComponent* EnemyStat = EnemyActor->FindComponentByClass<UStatComponent>();
+        UStatComponent* TargetStat = TargetActor->FindComponentByClass<UStatComponent>();
+        if (EnemyStat && TargetStat)
         {
-            float PlayerDefense = PlayerStat->PhysicalDefense;
-            DamageValue = CalculateDamage(BaseDamage, PlayerDefense);
+            DamageValue = CalculateDamage(*EnemyStat, *TargetStat);
             UE_LOG(LogTemp, Log, TEXT("ExecuteEnemyDefaultAttack - Enemy %s calculated attack damage: %f"),
                 *EnemyActor->GetName(), DamageValue);
         }
@@ -1510,17 +2416,17 @@ void UTurnBasedCombatComponent::ExecuteEnemyDefaultAttack()
         UE_LOG(LogTemp, Warning, TEXT("ExecuteEnemyDefaultAttack - Enemy %s has no EnemyAbilityComponent"), *EnemyActor->GetName());
     }
 
-    if (IsValid(PlayerActor))
+    if (IsValid(TargetActor))
     {
-        if (UStatComponent* PlayerStat = PlayerActor->FindComponentByClass<UStatComponent>())
+        if (UStatComponent* TargetStat = TargetActor->FindComponentByClass<UStatComponent>())
         {
-            PlayerStat->ApplyDamage(DamageValue, false);
-            UE_LOG(LogTemp, Log, TEXT("ExecuteEnemyDefaultAttack - Damage applied. Player HP: %f/%f"),
-                PlayerStat->Health, PlayerStat->MaxHealth);
+            TargetStat->ApplyDamage(DamageValue, false);
+            UE_LOG(LogTemp, Log, TEXT("ExecuteEnemyDefaultAttack - Damage applied. %s HP: %f/%f"),
+                *TargetActor->GetName(), TargetStat->Health, TargetStat->MaxHealth);
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("ExecuteEnemyDefaultAttack - Player StatComponent not found"));
+            UE_LOG(LogTemp, Warning, TEXT("ExecuteEnemyDefaultAttack - Target StatComponent not found"));
         }
     }
     NextTurn();
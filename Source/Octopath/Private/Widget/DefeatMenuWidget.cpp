@@ -0,0 +1,28 @@
+#include "Widget/DefeatMenuWidget.h"
+
+void UDefeatMenuWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// Bind the OnMyClicked delegate from our custom buttons to our handler functions
+	if (RetryButton)
+	{
+		RetryButton->OnMyClicked.AddDynamic(this, &UDefeatMenuWidget::HandleRetryClicked);
+	}
+	if (QuitButton)
+	{
+		QuitButton->OnMyClicked.AddDynamic(this, &UDefeatMenuWidget::HandleQuitClicked);
+	}
+}
+
+void UDefeatMenuWidget::HandleRetryClicked(UMyCommonButton* Button)
+{
+	// Broadcast that the Retry option was selected
+	OnRetrySelected.Broadcast();
+}
+
+void UDefeatMenuWidget::HandleQuitClicked(UMyCommonButton* Button)
+{
+	// Broadcast that the Quit option was selected
+	OnQuitSelected.Broadcast();
+}
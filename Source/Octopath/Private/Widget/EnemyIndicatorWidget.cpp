@@ -9,3 +9,12 @@ void UEnemyIndicatorWidget::SetEnemyName(const FText& NewName)
         EnemyNameText->SetText(NewName);
     }
 }
+
+void UEnemyIndicatorWidget::SetPreview(const FText& NewPreview)
+{
+    if (PreviewText)
+    {
+        PreviewText->SetText(NewPreview);
+        PreviewText->SetVisibility(NewPreview.IsEmpty() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+    }
+}
@@ -0,0 +1,235 @@
+#include "Widget/IndicatorLayer.h"
+#include "Widget/EnemyIndicatorWidget.h"
+#include "Manager/StatComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "SceneView.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/VectorRegister.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogIndicatorLayer, Log, All);
+
+void FIndicatorLayer::Show(UEnemyIndicatorWidget* Widget, AActor* Target)
+{
+	if (!IsValid(Widget))
+	{
+		return;
+	}
+
+	FMarker* Marker = Markers.FindByPredicate([Widget](const FMarker& Entry) { return Entry.Widget.Get() == Widget; });
+	if (!Marker)
+	{
+		Marker = &Markers.AddDefaulted_GetRef();
+		Marker->Widget = Widget;
+		Widget->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
+	}
+	if (Marker->Target.Get() != Target)
+	{
+		Marker->Target = Target;
+		Marker->bPlaced = false;
+		if (const UStatComponent* StatComp = IsValid(Target) ? Target->FindComponentByClass<UStatComponent>() : nullptr)
+		{
+			Widget->SetEnemyName(StatComp->EntityName);
+		}
+	}
+}
+
+void FIndicatorLayer::Hide(UEnemyIndicatorWidget* Widget)
+{
+	Markers.RemoveAllSwap([Widget](const FMarker& Entry) { return Entry.Widget.Get() == Widget; });
+}
+
+int32 FIndicatorLayer::Update(const APlayerController& PC, float WorldVerticalOffset, const FVector2D& ScreenOffset, float PixelThreshold)
+{
+	Markers.RemoveAllSwap([](const FMarker& Entry) { return !Entry.Widget.IsValid() || !Entry.Target.IsValid(); });
+	if (Markers.Num() == 0)
+	{
+		return 0;
+	}
+
+	// Same view as APlayerController::ProjectWorldLocationToScreen, fetched once for every marker.
+	const ULocalPlayer* LocalPlayer = PC.GetLocalPlayer();
+	if (!LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return 0;
+	}
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return 0;
+	}
+	const FMatrix44f RelativeViewProjection(ProjectionData.ViewRotationMatrix * ProjectionData.ProjectionMatrix);
+	const FVector ViewOrigin = ProjectionData.ViewOrigin;
+
+	const int32 Num = Markers.Num();
+	const int32 NumPadded = Align(Num, 4);
+	Scratch.SetNumUninitialized(NumPadded * 6, EAllowShrinking::No);
+	float* X = Scratch.GetData();
+	float* Y = X + NumPadded;
+	float* Z = Y + NumPadded;
+	float* ScreenX = Z + NumPadded;
+	float* ScreenY = ScreenX + NumPadded;
+	float* ScreenW = ScreenY + NumPadded;
+
+	for (int32 i = 0; i < NumPadded; i++)
+	{
+		const FVector Anchor = i < Num
+			? Markers[i].Target->GetActorLocation() + FVector(0.f, 0.f, WorldVerticalOffset) - ViewOrigin
+			: FVector::ZeroVector;
+		X[i] = static_cast<float>(Anchor.X);
+		Y[i] = static_cast<float>(Anchor.Y);
+		Z[i] = static_cast<float>(Anchor.Z);
+	}
+
+	ProjectAnchors(RelativeViewProjection, ProjectionData.GetConstrainedViewRect(), NumPadded, X, Y, Z, ScreenX, ScreenY, ScreenW);
+
+	int32 NumMoved = 0;
+	for (int32 i = 0; i < Num; i++)
+	{
+		// Behind the camera: the widget keeps its last position.
+		if (ScreenW[i] <= 0.f)
+		{
+			continue;
+		}
+		FMarker& Marker = Markers[i];
+		const FVector2D Position = FVector2D(ScreenX[i], ScreenY[i]) + ScreenOffset;
+		if (Marker.bPlaced && FMath::Abs(Position.X - Marker.Position.X) <= PixelThreshold && FMath::Abs(Position.Y - Marker.Position.Y) <= PixelThreshold)
+		{
+			continue;
+		}
+		Marker.Widget->SetPositionInViewport(Position, false);
+		Marker.Position = Position;
+		Marker.bPlaced = true;
+		NumMoved++;
+	}
+	return NumMoved;
+}
+
+bool FIndicatorLayer::Place(const APlayerController& PC, const UEnemyIndicatorWidget* Widget, float WorldVerticalOffset, const FVector2D& ScreenOffset)
+{
+	FMarker* Marker = Markers.FindByPredicate([Widget](const FMarker& Entry) { return Entry.Widget.Get() == Widget; });
+	if (!Marker || !Marker->Widget.IsValid() || !Marker->Target.IsValid())
+	{
+		return false;
+	}
+
+	// One marker: a single projection is cheaper than fetching the view for the batched pass.
+	FVector2D ScreenPosition;
+	if (!PC.ProjectWorldLocationToScreen(Marker->Target->GetActorLocation() + FVector(0.f, 0.f, WorldVerticalOffset), ScreenPosition, false))
+	{
+		return false;
+	}
+	Marker->Position = ScreenPosition + ScreenOffset;
+	Marker->Widget->SetPositionInViewport(Marker->Position, false);
+	Marker->bPlaced = true;
+	return true;
+}
+
+void FIndicatorLayer::ProjectAnchors(const FMatrix44f& M, const FIntRect& ViewRect, int32 NumPadded,
+	const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutW)
+{
+	check(NumPadded % 4 == 0);
+
+	// Clip = [X Y Z 1] * M (row vectors); only the X, Y and W columns are needed.
+	const VectorRegister4Float M00 = VectorSetFloat1(M.M[0][0]), M10 = VectorSetFloat1(M.M[1][0]), M20 = VectorSetFloat1(M.M[2][0]), M30 = VectorSetFloat1(M.M[3][0]);
+	const VectorRegister4Float M01 = VectorSetFloat1(M.M[0][1]), M11 = VectorSetFloat1(M.M[1][1]), M21 = VectorSetFloat1(M.M[2][1]), M31 = VectorSetFloat1(M.M[3][1]);
+	const VectorRegister4Float M03 = VectorSetFloat1(M.M[0][3]), M13 = VectorSetFloat1(M.M[1][3]), M23 = VectorSetFloat1(M.M[2][3]), M33 = VectorSetFloat1(M.M[3][3]);
+
+	// Normalized device coordinates to viewport pixels (Y points down), as FSceneView::ProjectWorldToScreen.
+	const float HalfWidth = 0.5f * ViewRect.Width();
+	const float HalfHeight = 0.5f * ViewRect.Height();
+	const VectorRegister4Float ScaleX = VectorSetFloat1(HalfWidth);
+	const VectorRegister4Float ScaleY = VectorSetFloat1(-HalfHeight);
+	const VectorRegister4Float CenterX = VectorSetFloat1(ViewRect.Min.X + HalfWidth);
+	const VectorRegister4Float CenterY = VectorSetFloat1(ViewRect.Min.Y + HalfHeight);
+
+	for (int32 i = 0; i < NumPadded; i += 4)
+	{
+		const VectorRegister4Float PX = VectorLoad(X + i);
+		const VectorRegister4Float PY = VectorLoad(Y + i);
+		const VectorRegister4Float PZ = VectorLoad(Z + i);
+
+		const VectorRegister4Float ClipX = VectorMultiplyAdd(PX, M00, VectorMultiplyAdd(PY, M10, VectorMultiplyAdd(PZ, M20, M30)));
+		const VectorRegister4Float ClipY = VectorMultiplyAdd(PX, M01, VectorMultiplyAdd(PY, M11, VectorMultiplyAdd(PZ, M21, M31)));
+		const VectorRegister4Float ClipW = VectorMultiplyAdd(PX, M03, VectorMultiplyAdd(PY, M13, VectorMultiplyAdd(PZ, M23, M33)));
+
+		// Lanes with W <= 0 produce garbage here and are skipped by the caller.
+		const VectorRegister4Float InvW = VectorReciprocalAccurate(ClipW);
+		VectorStore(VectorMultiplyAdd(VectorMultiply(ClipX, InvW), ScaleX, CenterX), OutX + i);
+		VectorStore(VectorMultiplyAdd(VectorMultiply(ClipY, InvW), ScaleY, CenterY), OutY + i);
+		VectorStore(ClipW, OutW + i);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Octopath.Bench.Indicators [Markers]
+ *
+ * Projects Markers anchors around the player once with one ProjectWorldLocationToScreen call each (the per-widget
+ * path) and once with a batched FIndicatorLayer::ProjectAnchors pass (view fetch included), and logs both costs.
+ */
+static FAutoConsoleCommandWithWorldAndArgs GIndicatorLayerBenchmarkCommand(
+	TEXT("Octopath.Bench.Indicators"),
+	TEXT("Times per-marker vs batched indicator projection. Usage: Octopath.Bench.Indicators [Markers]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const int32 NumMarkers = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+			const APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+			const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+			if (!LocalPlayer || !LocalPlayer->ViewportClient)
+			{
+				UE_LOG(LogIndicatorLayer, Warning, TEXT("Octopath.Bench.Indicators needs a local player with a viewport"));
+				return;
+			}
+
+			const APawn* Pawn = PC->GetPawn();
+			const FVector Center = Pawn ? Pawn->GetActorLocation() : FVector::ZeroVector;
+			TArray<FVector> Anchors;
+			for (int32 i = 0; i < NumMarkers; i++)
+			{
+				Anchors.Add(Center + FVector(FMath::Cos(i * 0.7f) * 500.f, FMath::Sin(i * 0.7f) * 500.f, 150.f));
+			}
+
+			// Per-marker path: one full view setup per projection.
+			double StartTime = FPlatformTime::Seconds();
+			FVector2D Sum = FVector2D::ZeroVector;
+			for (const FVector& Anchor : Anchors)
+			{
+				FVector2D ScreenPosition;
+				if (PC->ProjectWorldLocationToScreen(Anchor, ScreenPosition, false))
+				{
+					Sum += ScreenPosition;
+				}
+			}
+			const double PerMarkerSeconds = FPlatformTime::Seconds() - StartTime;
+
+			// Batched path.
+			StartTime = FPlatformTime::Seconds();
+			FSceneViewProjectionData ProjectionData;
+			LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData);
+			const FMatrix44f RelativeViewProjection(ProjectionData.ViewRotationMatrix * ProjectionData.ProjectionMatrix);
+			const int32 NumPadded = Align(NumMarkers, 4);
+			TArray<float> Scratch;
+			Scratch.SetNumZeroed(NumPadded * 6);
+			float* X = Scratch.GetData();
+			for (int32 i = 0; i < NumMarkers; i++)
+			{
+				const FVector Relative = Anchors[i] - ProjectionData.ViewOrigin;
+				X[i] = static_cast<float>(Relative.X);
+				X[NumPadded + i] = static_cast<float>(Relative.Y);
+				X[2 * NumPadded + i] = static_cast<float>(Relative.Z);
+			}
+			FIndicatorLayer::ProjectAnchors(RelativeViewProjection, ProjectionData.GetConstrainedViewRect(), NumPadded,
+				X, X + NumPadded, X + 2 * NumPadded, X + 3 * NumPadded, X + 4 * NumPadded, X + 5 * NumPadded);
+			const double BatchedSeconds = FPlatformTime::Seconds() - StartTime;
+
+			UE_LOG(LogIndicatorLayer, Display, TEXT("Indicators (%d markers): per-marker %.2f us (%.1f ns/marker), batched %.2f us (%.1f ns/marker), checksum %.1f"),
+				NumMarkers, PerMarkerSeconds * 1.0e6, PerMarkerSeconds * 1.0e9 / NumMarkers, BatchedSeconds * 1.0e6, BatchedSeconds * 1.0e9 / NumMarkers, Sum.X + Sum.Y);
+		}));
+
+#endif // !UE_BUILD_SHIPPING
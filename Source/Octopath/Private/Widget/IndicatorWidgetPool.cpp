@@ -0,0 +1,86 @@
+#include "Widget/IndicatorWidgetPool.h"
+#include "Widget/EnemyIndicatorWidget.h"
+#include "Blueprint/UserWidget.h"
+#include "GameFramework/PlayerController.h"
+
+void FIndicatorWidgetPool::Prewarm(APlayerController* InOwningPlayer, TSubclassOf<UEnemyIndicatorWidget> InWidgetClass, int32 Count)
+{
+	if (OwningPlayer.Get() != InOwningPlayer || WidgetClass != InWidgetClass)
+	{
+		Empty();
+		OwningPlayer = InOwningPlayer;
+		WidgetClass = InWidgetClass;
+	}
+
+	while (Widgets.Num() < Count)
+	{
+		if (!CreatePooledWidget())
+		{
+			break;
+		}
+	}
+}
+
+UEnemyIndicatorWidget* FIndicatorWidgetPool::Acquire()
+{
+	UEnemyIndicatorWidget* Widget = nullptr;
+	while (FreeWidgets.Num() > 0 && !IsValid(Widget))
+	{
+		Widget = FreeWidgets.Pop(EAllowShrinking::No);
+	}
+	if (!IsValid(Widget))
+	{
+		Widget = CreatePooledWidget();
+		if (!Widget)
+		{
+			return nullptr;
+		}
+		FreeWidgets.Pop(EAllowShrinking::No);
+	}
+
+	// Indicators never take the mouse: target picking is done in screen space by the combat component.
+	Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+	return Widget;
+}
+
+void FIndicatorWidgetPool::Release(UEnemyIndicatorWidget* Widget)
+{
+	if (!IsValid(Widget))
+	{
+		return;
+	}
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	FreeWidgets.AddUnique(Widget);
+}
+
+void FIndicatorWidgetPool::Empty()
+{
+	for (UEnemyIndicatorWidget* Widget : Widgets)
+	{
+		if (IsValid(Widget))
+		{
+			Widget->RemoveFromParent();
+		}
+	}
+	Widgets.Empty();
+	FreeWidgets.Empty();
+}
+
+UEnemyIndicatorWidget* FIndicatorWidgetPool::CreatePooledWidget()
+{
+	APlayerController* PC = OwningPlayer.Get();
+	if (!IsValid(PC) || !IsValid(WidgetClass))
+	{
+		return nullptr;
+	}
+	UEnemyIndicatorWidget* Widget = CreateWidget<UEnemyIndicatorWidget>(PC, WidgetClass);
+	if (!IsValid(Widget))
+	{
+		return nullptr;
+	}
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Widget->AddToViewport();
+	Widgets.Add(Widget);
+	FreeWidgets.Add(Widget);
+	return Widget;
+}
@@ -1,4 +1,5 @@
 #include "Widget/MyCommonButtonText.h"
+#include "Components/Image.h"
 #include "Engine/Engine.h"
 
 void UMyCommonButtonText::NativeOnClicked()
@@ -32,4 +33,13 @@ void UMyCommonButtonText::SetButtonText(const FText& InText)
     {
         ButtonTextBlock->SetText(InText);
     }
+}
+
+void UMyCommonButtonText::SetButtonIcon(UTexture2D* InIcon)
+{
+    if (ButtonIcon)
+    {
+        ButtonIcon->SetBrushFromTexture(InIcon);
+        ButtonIcon->SetVisibility(InIcon ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Hidden);
+    }
 }
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "Character/AllyAbilityComponent.h"
 #include "GameFramework/Character.h"
 #include "Widget/SkillDescriptionWidget.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/Texture2D.h"
 
 // Define a custom log category for this widget.
 DEFINE_LOG_CATEGORY_STATIC(LogPlayerAbilitiesMenu, Log, All);
@@ -22,6 +25,12 @@ void UPlayerAbilitiesMenuWidget::NativeConstruct()
 	}
 }
 
+void UPlayerAbilitiesMenuWidget::NativeDestruct()
+{
+	ReleaseStreamedAssets();
+	Super::NativeDestruct();
+}
+
 void UPlayerAbilitiesMenuWidget::PopulateAbilitiesMenu()
 {
 	// Clear any existing children in the ScrollBox and the map.
@@ -30,6 +39,7 @@ void UPlayerAbilitiesMenuWidget::PopulateAbilitiesMenu()
 		AbilitiesScrollBox->ClearChildren();
 	}
 	AbilityButtonMap.Empty();
+	ReleaseStreamedAssets();
 
 	// Remove any existing description widget.
 	if (CurrentSkillDescriptionWidget)
@@ -87,8 +97,9 @@ void UPlayerAbilitiesMenuWidget::PopulateAbilitiesMenu()
 			UE_LOG(LogPlayerAbilitiesMenu, Warning, TEXT("PopulateAbilitiesMenu: Failed to create AbilityButton"));
 			continue;
 		}
-		// Set the button's display text to the skill's name.
+		// Set the button's display text to the skill's name; the icon is streamed in below.
 		AbilityButton->SetButtonText(Skill->SkillName);
+		AbilityButton->SetButtonIcon(PlaceholderIcon);
 		UE_LOG(LogPlayerAbilitiesMenu, Log, TEXT("PopulateAbilitiesMenu: Created button for skill: %s"), *Skill->SkillName.ToString());
 
 		// Bind the button's click event.
@@ -107,6 +118,103 @@ void UPlayerAbilitiesMenuWidget::PopulateAbilitiesMenu()
 		// Map this button to the corresponding skill.
 		AbilityButtonMap.Add(AbilityButton, Skill);
 	}
+
+	StreamSkillIcons();
+}
+
+void UPlayerAbilitiesMenuWidget::StreamSkillIcons()
+{
+	if (IconHandles.Num() > 0)
+	{
+		return;
+	}
+
+	FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+	for (const TPair<UMyCommonButtonText*, USkillData*>& Pair : AbilityButtonMap)
+	{
+		UMyCommonButtonText* AbilityButton = Pair.Key;
+		USkillData* Skill = Pair.Value;
+		if (!AbilityButton || !Skill || Skill->Icon.IsNull())
+		{
+			continue;
+		}
+
+		// Already in memory (e.g. preloaded with the "Menu" bundle): no request needed.
+		if (UTexture2D* Icon = Skill->Icon.Get())
+		{
+			AbilityButton->SetButtonIcon(Icon);
+			continue;
+		}
+
+		TWeakObjectPtr<UMyCommonButtonText> WeakButton = AbilityButton;
+		TSoftObjectPtr<UTexture2D> IconPtr = Skill->Icon;
+		TSharedPtr<FStreamableHandle> Handle = Streamable.RequestAsyncLoad(IconPtr.ToSoftObjectPath(),
+			FStreamableDelegate::CreateWeakLambda(this, [WeakButton, IconPtr]()
+			{
+				UTexture2D* Icon = IconPtr.Get();
+				if (WeakButton.IsValid() && Icon)
+				{
+					WeakButton->SetButtonIcon(Icon);
+				}
+			}));
+		if (Handle.IsValid())
+		{
+			IconHandles.Add(Handle);
+		}
+	}
+	UE_LOG(LogPlayerAbilitiesMenu, Log, TEXT("StreamSkillIcons: Requested %d icons"), IconHandles.Num());
+}
+
+void UPlayerAbilitiesMenuWidget::ReleaseStreamedAssets()
+{
+	for (const TSharedPtr<FStreamableHandle>& Handle : IconHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+	IconHandles.Reset();
+
+	if (CastPrefetchHandle.IsValid())
+	{
+		CastPrefetchHandle->ReleaseHandle();
+		CastPrefetchHandle.Reset();
+	}
+	PrefetchedSkill.Reset();
+}
+
+void UPlayerAbilitiesMenuWidget::PrefetchCastAssets(USkillData* Skill)
+{
+	if (!Skill || PrefetchedSkill.Get() == Skill)
+	{
+		return;
+	}
+
+	// Only the last hovered skill is kept: the cast assets of skills the player skips over stay unloaded.
+	if (CastPrefetchHandle.IsValid())
+	{
+		CastPrefetchHandle->ReleaseHandle();
+		CastPrefetchHandle.Reset();
+	}
+	PrefetchedSkill = Skill;
+
+	TArray<FSoftObjectPath> Paths;
+	if (!Skill->CastMontage.IsNull() && !Skill->CastMontage.Get())
+	{
+		Paths.Add(Skill->CastMontage.ToSoftObjectPath());
+	}
+	if (!Skill->CastEffect.IsNull() && !Skill->CastEffect.Get())
+	{
+		Paths.Add(Skill->CastEffect.ToSoftObjectPath());
+	}
+	if (Paths.Num() == 0)
+	{
+		return;
+	}
+
+	CastPrefetchHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	UE_LOG(LogPlayerAbilitiesMenu, Log, TEXT("PrefetchCastAssets: Prefetching cast assets of %s"), *Skill->GetName());
 }
 
 void UPlayerAbilitiesMenuWidget::OnAbilityButtonClicked(UMyCommonButtonText* ClickedButton)
@@ -159,6 +267,8 @@ void UPlayerAbilitiesMenuWidget::OnAbilityButtonHovered(UMyCommonButtonText* Hov
 		return;
 	}
 
+	PrefetchCastAssets(Skill);
+
 	// Create the description widget if it doesn't already exist.
 	if (!CurrentSkillDescriptionWidget && SkillDescriptionWidgetClass)
 	{
@@ -189,6 +299,18 @@ void UPlayerAbilitiesMenuWidget::OnAbilityButtonHovered(UMyCommonButtonText* Hov
 		CurrentSkillDescriptionWidget->SetAnchorsInViewport(FAnchors(0.5f, 0.f, 0.5f, 0.f));
 		CurrentSkillDescriptionWidget->SetAlignmentInViewport(FVector2D(0.5f, 1.f));
 		CurrentSkillDescriptionWidget->SetPositionInViewport(DescriptionWidgetFixedPosition, false);
+		CurrentSkillDescriptionWidget->SetPreview(FText::GetEmpty());
+	}
+
+	// Listeners fill the preview (see SetSkillPreview).
+	OnAbilityHovered.Broadcast(Skill);
+}
+
+void UPlayerAbilitiesMenuWidget::SetSkillPreview(const FText& PreviewText)
+{
+	if (CurrentSkillDescriptionWidget)
+	{
+		CurrentSkillDescriptionWidget->SetPreview(PreviewText);
 	}
 }
 
@@ -8,3 +8,12 @@ void USkillDescriptionWidget::SetDescription(const FText& InDescription)
 		DescriptionText->SetText(InDescription);
 	}
 }
+
+void USkillDescriptionWidget::SetPreview(const FText& InPreview)
+{
+	if (PreviewText)
+	{
+		PreviewText->SetText(InPreview);
+		PreviewText->SetVisibility(InPreview.IsEmpty() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+	}
+}
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Manager/SkillData.h"
+#include "Combat/SkillHitResult.h"
 #include "AllyAbilityComponent.generated.h"
 
 /**
@@ -29,36 +30,35 @@ public:
 	float ExecuteDefaultAttack();
 
 	/**
-	 * Executes a custom skill.
+	 * Executes a custom skill by running its compiled program (see FSkillProgram).
 	 *
-	 * For offensive or healing skills, it calculates and returns the damage/healing value.
+	 * For offensive or healing skills, it applies and returns the damage/healing value.
 	 * For buff/debuff skills, it applies the modifier to the affected stat.
 	 *
-	 * This function deducts the TechniqueCost from the owner's StatComponent before execution.
+	 * The program deducts the TechniqueCost from the owner's StatComponent before applying the effects.
 	 *
 	 * @param Skill - The skill data asset to execute.
+	 * @param Targets - The actors targeted by the skill.
 	 * @return The resulting effect value (e.g., damage, healing, or modifier value).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Ally Abilities")
 	float ExecuteSkill(USkillData* Skill, const TArray<AActor*>& Targets);
 
+	/**
+	 * Same as ExecuteSkill, also reporting the outcome on each target (used by the combat component
+	 * to fire a single OnMultiHitResolved event for skills hitting several enemies).
+	 *
+	 * @param OutResults - Receives one entry per valid target, in targeting order.
+	 */
+	float ExecuteSkillWithResults(USkillData* Skill, const TArray<AActor*>& Targets, TArray<FSkillHitResult>& OutResults);
+
+	/** Returns the damage formula constants of this character's skills (Ally Skills of the combat balance settings). */
+	const FDamageTunables& GetDamageTunables() const;
+
 public :
 
 	/** Array of skills available to this allied character */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ally Abilities")
 	TArray<USkillData*> Skills;
 
-	// Damage formula settings
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage Settings")
-	float DamageDefenceRatio = 100.f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage Settings")
-	float DamageDefenceDivisor = 2.f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage Settings")
-	float RandomMultiplierMin = 0.98f;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage Settings")
-	float RandomMultiplierMax = 1.02f;
-
 };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Combat/DamagePipeline.h"
+#include "CombatBalance.generated.h"
+
+/** Skill damage constants of one side of the combat */
+USTRUCT(BlueprintType)
+struct OCTOPATH_API FSkillDamageSettings
+{
+	GENERATED_BODY()
+
+	/** Skills subtract Defense * DefenceRatio / DefenceDivisor */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	float DefenceRatio = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage", meta = (ClampMin = "0.01"))
+	float DefenceDivisor = 2.f;
+
+	/** Range of the random multiplier rolled for skills */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	float VarianceMin = 0.98f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Damage")
+	float VarianceMax = 1.02f;
+
+	/** Returns the base tunables with the skill constants replaced by these. */
+	FDamageTunables ApplyTo(const FDamageTunables& Base) const;
+};
+
+/**
+ * Immutable snapshot of the combat balance constants.
+ *
+ * Every reload publishes a new snapshot with a higher Version and swaps it in atomically, so readers (including
+ * the lookahead and speculation workers) pay a single pointer load and never see a half-written set of values.
+ * The last few superseded snapshots are kept alive, since a worker may still hold a reference to one; a search
+ * lasts milliseconds while reloads are manual, so the older ones are freed.
+ */
+struct OCTOPATH_API FCombatBalance
+{
+	/** Bumped on every reload (0 for the built-in defaults used before the settings are loaded) */
+	uint32 Version = 0;
+
+	/** Global tunables (default attack, minimum damage, and skills of casters without an ability component) */
+	FDamageTunables Damage;
+
+	/** Tunables of the allies' skills (UAllyAbilityComponent) */
+	FDamageTunables AllyDamage;
+
+	/** Tunables of the enemies' skills (UEnemyAbilityComponent) */
+	FDamageTunables EnemyDamage;
+
+	/** Fraction of incoming damage removed while defending */
+	float DefendingDamageReduction = 0.3f;
+
+	/** Health cap of non-boss characters */
+	float NonBossMaxHealth = 10000.f;
+
+	/** Cap of the effective PhysicalAttack, MagicalAttack, PhysicalDefense, MagicalDefense and Speed */
+	float MaxStatValue = 1000.f;
+
+	/** Returns the current snapshot; lock-free, callable from any thread. */
+	static const FCombatBalance& Get();
+
+	/** Broadcast on the game thread after a new snapshot is published. */
+	static FSimpleMulticastDelegate OnReloaded;
+};
+
+/**
+ * UCombatBalanceSettings
+ *
+ * Combat balance constants, edited in Project Settings > Game > Combat Balance and saved to DefaultGame.ini.
+ * Changing a value in the editor publishes a new FCombatBalance right away; "Octopath.Balance.Reload" re-reads
+ * DefaultGame.ini from disk and publishes it during a running combat, so the next action uses the new values.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Combat Balance"))
+class OCTOPATH_API UCombatBalanceSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UCombatBalanceSettings();
+
+	virtual void PostInitProperties() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Re-reads the Game config from disk into the settings and publishes them. */
+	void ReloadFromDisk();
+
+	/** Publishes the current values as a new FCombatBalance snapshot. */
+	void Publish() const;
+
+	/** Default attack formula, minimum damage, and skill constants of casters without an ability component */
+	UPROPERTY(Config, EditAnywhere, Category = "Damage")
+	FDamageTunables Damage;
+
+	/** Skill constants of the allies */
+	UPROPERTY(Config, EditAnywhere, Category = "Damage")
+	FSkillDamageSettings AllySkills;
+
+	/** Skill constants of the enemies */
+	UPROPERTY(Config, EditAnywhere, Category = "Damage")
+	FSkillDamageSettings EnemySkills;
+
+	/** Fraction of incoming damage removed while defending */
+	UPROPERTY(Config, EditAnywhere, Category = "Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float DefendingDamageReduction;
+
+	/** Health cap of non-boss characters (bosses are only capped by their MaxHealth) */
+	UPROPERTY(Config, EditAnywhere, Category = "Stats", meta = (ClampMin = "1.0"))
+	float NonBossMaxHealth;
+
+	/** Cap of the effective attack, defense and speed stats, modifiers included */
+	UPROPERTY(Config, EditAnywhere, Category = "Stats", meta = (ClampMin = "1.0"))
+	float MaxStatValue;
+};
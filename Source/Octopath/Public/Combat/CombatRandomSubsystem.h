@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatRandomSubsystem.generated.h"
+
+/**
+ * UCombatRandomSubsystem
+ *
+ * Owns the random stream used by every combat roll (damage variance, random targets).
+ * Keeping all rolls on one stream lets combat snapshots capture and restore the RNG state,
+ * so simulations branching from a snapshot roll exactly what the live combat would.
+ */
+UCLASS()
+class OCTOPATH_API UCombatRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Re-seeds the stream (called when combat starts). */
+	void Reseed(int32 NewSeed) { Stream.Initialize(NewSeed); }
+
+	/**
+	 * Puts the stream back in a captured state (e.g. from a combat snapshot).
+	 * @param InitialSeed - Seed the stream was started with (what Reset returns to).
+	 * @param CurrentSeed - Position of the stream when it was captured.
+	 */
+	void RestoreState(int32 InitialSeed, int32 CurrentSeed);
+
+	/** The combat random stream. */
+	FRandomStream& GetStream() { return Stream; }
+	const FRandomStream& GetStream() const { return Stream; }
+
+	/** Returns the combat stream of a world, or nullptr if the world has no such subsystem. */
+	static FRandomStream* GetStream(const UObject* WorldContextObject);
+
+private:
+	FRandomStream Stream;
+};
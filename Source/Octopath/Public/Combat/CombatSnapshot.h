@@ -0,0 +1,340 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Manager/SkillData.h"
+#include "Combat/CombatBalance.h"
+#include <type_traits>
+
+/**
+ * Flat, trivially copyable snapshot of a whole combat.
+ *
+ * The snapshot holds no UObject pointers: slot i of FCombatSnapshot::Combatants corresponds to the i-th actor
+ * returned alongside it by UTurnBasedCombatComponent::CaptureSnapshot. Copying a snapshot is a single memcpy,
+ * and the helpers below let AI lookahead, damage previews and simulations branch on copies without touching
+ * the live UStatComponents (no UObject allocation, no delegate broadcast).
+ */
+
+/** One active stat modifier (mirror of FActiveStatModifier) */
+struct FModifierSnapshot
+{
+	float ModifierValue;
+	int16 RemainingTurns;
+	ECombatStatType AffectedStat;
+	EModifierType ModifierType;
+};
+
+/** One active status effect (at most one per effect type and combatant) */
+struct FStatusEffectSnapshot
+{
+	float Magnitude;
+	int32 RemainingTurns;
+};
+
+/** Complete state of one combatant */
+struct FCombatantSnapshot
+{
+	static constexpr int32 MaxModifiers = 8;
+	static constexpr int32 NumStatusEffectTypes = static_cast<int32>(EStatusEffectType::Count);
+
+	// --- Current stats ---
+	float Health;
+	float MaxHealth;
+	float TechniquePoints;
+	float MaxTechniquePoints;
+	float PhysicalAttack;
+	float MagicalAttack;
+	float PhysicalDefense;
+	float MagicalDefense;
+	float Speed;
+
+	// --- Base stats (used when modifiers expire) ---
+	float BasePhysicalAttack;
+	float BaseMagicalAttack;
+	float BasePhysicalDefense;
+	float BaseMagicalDefense;
+	float BaseSpeed;
+
+	// --- Defense ---
+	float DefenseReductionPercentage;
+	uint8 bIsDefending;
+
+	// --- Flags ---
+	uint8 bIsBoss;
+	uint8 bIsPlayer;
+	uint8 StatusEffectFlags;
+
+	// --- Break ---
+	int32 WeaknessMask;
+	int32 ShieldPoints;
+	int32 MaxShieldPoints;
+	int32 BreakRoundsRemaining;
+	int32 BreakRecoveryRounds;
+	float BrokenDamageMultiplier;
+
+	// --- Modifiers and status effects ---
+	int32 NumModifiers;
+	FModifierSnapshot Modifiers[MaxModifiers];
+	FStatusEffectSnapshot StatusEffects[NumStatusEffectTypes];
+
+	bool IsAlive() const { return Health > 0.f; }
+
+	bool IsBroken() const { return BreakRoundsRemaining > 0; }
+
+	bool IsWeakTo(int32 DamageTypeMask) const { return (WeaknessMask & DamageTypeMask) != 0; }
+
+	/** Same rules as UStatComponent::ApplyShieldHit without broadcasting. */
+	bool ApplyShieldHit(int32 DamageTypeMask, int32 ShieldDamage)
+	{
+		if (ShieldPoints <= 0 || IsBroken() || !IsWeakTo(DamageTypeMask))
+		{
+			return false;
+		}
+		ShieldPoints = FMath::Max(ShieldPoints - ShieldDamage, 0);
+		if (ShieldPoints == 0)
+		{
+			BreakRoundsRemaining = BreakRecoveryRounds + 1;
+			return true;
+		}
+		return false;
+	}
+
+	bool HasStatusEffect(EStatusEffectType EffectType) const
+	{
+		return (StatusEffectFlags & (1u << static_cast<uint32>(EffectType))) != 0;
+	}
+
+	/** Same value as the IncomingDamageScale derived stat (defending reduction, break multiplier). */
+	float GetIncomingDamageScale() const
+	{
+		const float DefendingScale = bIsDefending ? 1.f - DefenseReductionPercentage : 1.f;
+		return IsBroken() ? DefendingScale * BrokenDamageMultiplier : DefendingScale;
+	}
+
+	/** Same rules as UStatComponent::ApplyDamage (defending reduction, break multiplier, clamping) without broadcasting. */
+	void ApplyDamage(float DamageAmount)
+	{
+		Health = FMath::Clamp(Health - DamageAmount * GetIncomingDamageScale(), 0.f, GetHealthClampMax());
+	}
+
+	/** Same rules as UStatComponent::Heal without broadcasting. */
+	void Heal(float Amount)
+	{
+		Health = FMath::Clamp(Health + Amount, 0.f, GetHealthClampMax());
+	}
+
+	/** Same rules as UStatComponent::UseTechniquePoints without broadcasting. */
+	void UseTechniquePoints(float Amount)
+	{
+		TechniquePoints = FMath::Clamp(TechniquePoints - Amount, 0.f, MaxTechniquePoints);
+	}
+
+	float GetHealthClampMax() const { return bIsBoss ? MaxHealth : FMath::Min(MaxHealth, FCombatBalance::Get().NonBossMaxHealth); }
+
+	/** Same rules as UStatComponent::ApplyStatModifier without broadcasting (dropped when all slots are used). */
+	void ApplyStatModifier(ECombatStatType AffectedStat, float ModifierValue, EModifierType ModifierType, int32 DurationTurns)
+	{
+		if (NumModifiers >= MaxModifiers)
+		{
+			return;
+		}
+		FModifierSnapshot& Modifier = Modifiers[NumModifiers++];
+		Modifier.ModifierValue = ModifierValue;
+		Modifier.RemainingTurns = static_cast<int16>(DurationTurns);
+		Modifier.AffectedStat = AffectedStat;
+		Modifier.ModifierType = ModifierType;
+		RecalculateStat(AffectedStat);
+	}
+
+	/** Same rules as UStatComponent::DecrementStatModifiers without broadcasting. */
+	void DecrementStatModifiers()
+	{
+		for (int32 i = NumModifiers - 1; i >= 0; i--)
+		{
+			if (--Modifiers[i].RemainingTurns <= 0)
+			{
+				const ECombatStatType AffectedStat = Modifiers[i].AffectedStat;
+				Modifiers[i] = Modifiers[--NumModifiers];
+				RecalculateStat(AffectedStat);
+			}
+		}
+	}
+
+	/** Same rules as UStatComponent::RecalculateStat without broadcasting. */
+	void RecalculateStat(ECombatStatType CombatStatType)
+	{
+		float* Stat = nullptr;
+		float BaseValue = 0.f;
+		switch (CombatStatType)
+		{
+		case ECombatStatType::PhysicalAttack:  Stat = &PhysicalAttack;  BaseValue = BasePhysicalAttack;  break;
+		case ECombatStatType::MagicalAttack:   Stat = &MagicalAttack;   BaseValue = BaseMagicalAttack;   break;
+		case ECombatStatType::PhysicalDefense: Stat = &PhysicalDefense; BaseValue = BasePhysicalDefense; break;
+		case ECombatStatType::MagicalDefense:  Stat = &MagicalDefense;  BaseValue = BaseMagicalDefense;  break;
+		case ECombatStatType::Speed:           Stat = &Speed;           BaseValue = BaseSpeed;           break;
+		default:
+			return;
+		}
+
+		float PercentageSum = 0.f;
+		float FlatSum = 0.f;
+		for (int32 i = 0; i < NumModifiers; i++)
+		{
+			if (Modifiers[i].AffectedStat == CombatStatType)
+			{
+				(Modifiers[i].ModifierType == EModifierType::Percentage ? PercentageSum : FlatSum) += Modifiers[i].ModifierValue;
+			}
+		}
+		*Stat = FMath::Min(BaseValue * (1.f + PercentageSum) + FlatSum, FCombatBalance::Get().MaxStatValue);
+	}
+
+	/** Same rules as UStatusEffectSubsystem::ApplyEffect (an existing instance is refreshed, not stacked). */
+	void ApplyStatusEffect(EStatusEffectType EffectType, float Magnitude, int32 DurationTurns)
+	{
+		const int32 Type = static_cast<int32>(EffectType);
+		if (Type <= 0 || Type >= NumStatusEffectTypes || DurationTurns <= 0)
+		{
+			return;
+		}
+		FStatusEffectSnapshot& Effect = StatusEffects[Type];
+		Effect.Magnitude = Magnitude;
+		Effect.RemainingTurns = HasStatusEffect(EffectType) ? FMath::Max(Effect.RemainingTurns, DurationTurns) : DurationTurns;
+		StatusEffectFlags |= static_cast<uint8>(1u << Type);
+	}
+
+	/** Same rules as UStatusEffectSubsystem::ProcessRoundEnd for this combatant (ticks, then durations; Stun excluded). */
+	void ProcessStatusEffectsRoundEnd()
+	{
+		if (HasStatusEffect(EStatusEffectType::Poison))
+		{
+			ApplyDamage(StatusEffects[static_cast<int32>(EStatusEffectType::Poison)].Magnitude);
+		}
+		if (HasStatusEffect(EStatusEffectType::Regen))
+		{
+			Heal(StatusEffects[static_cast<int32>(EStatusEffectType::Regen)].Magnitude);
+		}
+		for (int32 Type = 1; Type < NumStatusEffectTypes; Type++)
+		{
+			if (Type != static_cast<int32>(EStatusEffectType::Stun)
+				&& HasStatusEffect(static_cast<EStatusEffectType>(Type)) && --StatusEffects[Type].RemainingTurns <= 0)
+			{
+				StatusEffectFlags &= static_cast<uint8>(~(1u << Type));
+			}
+		}
+	}
+
+	/** Same rules as UStatusEffectSubsystem::ConsumeStunnedTurn: a skipped turn counts down the stun. */
+	void ConsumeStunnedTurn()
+	{
+		constexpr int32 Type = static_cast<int32>(EStatusEffectType::Stun);
+		if (HasStatusEffect(EStatusEffectType::Stun) && --StatusEffects[Type].RemainingTurns <= 0)
+		{
+			StatusEffectFlags &= static_cast<uint8>(~(1u << Type));
+		}
+	}
+
+	/** Same rules as UStatComponent::ProcessBreakRoundEnd without broadcasting. */
+	void ProcessBreakRoundEnd()
+	{
+		if (IsBroken() && --BreakRoundsRemaining == 0)
+		{
+			ShieldPoints = MaxShieldPoints;
+		}
+	}
+
+	/** Returns true if both snapshots hold bit-identical state (unused modifier and status effect entries are ignored). */
+	bool IsIdentical(const FCombatantSnapshot& Other) const
+	{
+		if (FMemory::Memcmp(this, &Other, STRUCT_OFFSET(FCombatantSnapshot, Modifiers)) != 0
+			|| FMemory::Memcmp(Modifiers, Other.Modifiers, NumModifiers * sizeof(FModifierSnapshot)) != 0)
+		{
+			return false;
+		}
+		for (int32 Type = 1; Type < NumStatusEffectTypes; Type++)
+		{
+			if (HasStatusEffect(static_cast<EStatusEffectType>(Type))
+				&& FMemory::Memcmp(&StatusEffects[Type], &Other.StatusEffects[Type], sizeof(FStatusEffectSnapshot)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+// IsIdentical compares the fields before Modifiers as raw bytes: they must not contain padding.
+static_assert(STRUCT_OFFSET(FCombatantSnapshot, Modifiers) == 23 * sizeof(int32), "FCombatantSnapshot fields before Modifiers must be tightly packed");
+
+/** Complete state of a combat: combatants, turn queue, round flags and random stream */
+struct FCombatSnapshot
+{
+	static constexpr int32 MaxCombatants = 32;
+
+	/** Number of used entries in Combatants */
+	int32 NumCombatants;
+
+	/** Index in TurnOrder of the combatant whose turn it is */
+	int32 CurrentTurnIndex;
+
+	/** Number of used entries in TurnOrder (combatants still in the turn queue) */
+	int32 NumTurns;
+
+	/** Turn queue: combatant slots in acting order */
+	int8 TurnOrder[MaxCombatants];
+
+	/** Round flags of UTurnBasedCombatComponent */
+	uint8 bPlayerDefendedThisRound;
+	uint8 bDefenseConsumed;
+
+	/** State of the combat random stream */
+	int32 RandomInitialSeed;
+	int32 RandomSeed;
+
+	FCombatantSnapshot Combatants[MaxCombatants];
+
+	/** Copies another snapshot (one memcpy). */
+	void CopyFrom(const FCombatSnapshot& Other)
+	{
+		FMemory::Memcpy(this, &Other, sizeof(FCombatSnapshot));
+	}
+
+	/** Returns a random stream positioned where the live combat stream was captured. */
+	FRandomStream MakeRandomStream() const
+	{
+		FRandomStream Stream(RandomSeed);
+		return Stream;
+	}
+
+	/** Stores the current position of a random stream (e.g. after a speculative roll). */
+	void StoreRandomStream(const FRandomStream& Stream)
+	{
+		RandomSeed = Stream.GetCurrentSeed();
+	}
+
+	/** Returns true if both snapshots hold the same combatants, turn queue, round flags and random stream. */
+	bool IsIdentical(const FCombatSnapshot& Other) const
+	{
+		if (NumCombatants != Other.NumCombatants || CurrentTurnIndex != Other.CurrentTurnIndex || NumTurns != Other.NumTurns
+			|| FMemory::Memcmp(TurnOrder, Other.TurnOrder, NumTurns) != 0
+			|| bPlayerDefendedThisRound != Other.bPlayerDefendedThisRound || bDefenseConsumed != Other.bDefenseConsumed
+			|| RandomInitialSeed != Other.RandomInitialSeed || RandomSeed != Other.RandomSeed)
+		{
+			return false;
+		}
+		for (int32 Slot = 0; Slot < NumCombatants; Slot++)
+		{
+			if (!Combatants[Slot].IsIdentical(Other.Combatants[Slot]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Returns the combatant acting now, or nullptr if the turn queue is exhausted. */
+	FCombatantSnapshot* GetCurrentCombatant()
+	{
+		return (CurrentTurnIndex >= 0 && CurrentTurnIndex < NumTurns) ? &Combatants[TurnOrder[CurrentTurnIndex]] : nullptr;
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FCombatSnapshot>, "FCombatSnapshot must stay trivially copyable (restored with a single memcpy)");
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Manager/SkillData.h"
+
+class UStatComponent;
+
+/**
+ * Per-turn table of valid skill targets.
+ *
+ * Built once from the combatant list (tags, stat components and skill lists are read only here), it stores
+ * one bit per combatant slot for every (caster side, ETargetType, EAbilityCategory) pair, plus one bit per
+ * skill for the skills each combatant can afford. Hover validation, default target choice, AI action
+ * enumeration and affordability checks then become bit tests instead of tag lookups and world scans.
+ *
+ * The owner invalidates the table when a combatant dies or joins; the next query rebuilds it.
+ */
+struct OCTOPATH_API FCombatTargetCache
+{
+	using FMask = uint64;
+
+	/** Combatants and skills per combatant beyond this are ignored */
+	static constexpr int32 MaxSlots = 64;
+
+	/** Side of a combatant: the player's team or the enemies */
+	enum class ESide : uint8
+	{
+		Friendly,
+		Hostile,
+
+		Count
+	};
+
+	/** Targeting rule shared by the player and the AI: only self-targeted skills target the caster alone (heals follow their target type). */
+	static bool TargetsCaster(ETargetType TargetType)
+	{
+		return TargetType == ETargetType::Self;
+	}
+
+	/** Rebuilds the table from the combatants (the player actor is always on the friendly side). */
+	void Build(TConstArrayView<AActor*> Combatants, const AActor* PlayerActor);
+
+	/** Marks the table stale; IsBuilt() returns false until the next Build. */
+	void Invalidate() { bBuilt = false; }
+
+	bool IsBuilt() const { return bBuilt; }
+
+	/** Recomputes the affordable skills of one slot (call after its Technique Points change). */
+	void RefreshAffordableSkills(int32 Slot);
+
+	/** Returns the slot of an actor, or INDEX_NONE if it is not a combatant. */
+	int32 FindSlot(const AActor* Actor) const;
+
+	/** Returns the actor in a slot, or nullptr if it is gone. */
+	AActor* GetActor(int32 Slot) const;
+
+	/** Returns the stat component of the actor in a slot. */
+	UStatComponent* GetStatComponent(int32 Slot) const { return Slots.IsValidIndex(Slot) ? Slots[Slot].StatComponent.Get() : nullptr; }
+
+	/** Returns the combatants a skill of the given kind may target when cast from CasterSlot. */
+	FMask GetValidTargets(int32 CasterSlot, ETargetType TargetType, EAbilityCategory Category) const;
+
+	/** Returns the combatants a skill may target when cast from CasterSlot. */
+	FMask GetValidTargets(int32 CasterSlot, const USkillData& Skill) const { return GetValidTargets(CasterSlot, Skill.TargetType, Skill.AbilityCategory); }
+
+	/** Returns the living opponents of CasterSlot (targets of the default attack). */
+	FMask GetAttackTargets(int32 CasterSlot) const;
+
+	/** Returns true if an actor is in a mask. */
+	bool Contains(FMask Mask, const AActor* Actor) const
+	{
+		const int32 Slot = FindSlot(Actor);
+		return Slot != INDEX_NONE && (Mask & (FMask(1) << Slot)) != 0;
+	}
+
+	/** Returns the actor of the lowest slot in a mask, or nullptr if the mask is empty. */
+	AActor* GetFirstActor(FMask Mask) const;
+
+	/** Appends the actors of a mask in slot order. */
+	void GetActors(FMask Mask, TArray<AActor*>& OutActors) const;
+
+	/** Returns the bits of the skills (indices in the caster's skill list) the combatant in a slot can afford. */
+	FMask GetAffordableSkills(int32 Slot) const { return Slots.IsValidIndex(Slot) ? Slots[Slot].AffordableSkills : 0; }
+
+	/** Returns true if the combatant in a slot can afford a skill of its list. */
+	bool CanAfford(int32 Slot, const USkillData* Skill) const;
+
+	/** Returns the skill list of the combatant in a slot (ally or enemy ability component). */
+	TConstArrayView<USkillData*> GetSkills(int32 Slot) const;
+
+	FMask GetAliveMask() const { return AliveMask; }
+
+	int32 Num() const { return Slots.Num(); }
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<UStatComponent> StatComponent;
+		TWeakObjectPtr<UActorComponent> AbilityComponent;
+		FMask AffordableSkills = 0;
+		ESide Side = ESide::Friendly;
+	};
+
+	static constexpr int32 NumTargetTypes = static_cast<int32>(ETargetType::Self) + 1;
+	static constexpr int32 NumCategories = static_cast<int32>(EAbilityCategory::Utility) + 1;
+	static constexpr int32 NumSides = static_cast<int32>(ESide::Count);
+
+	TArray<FSlot, TInlineAllocator<8>> Slots;
+
+	/** Living combatants */
+	FMask AliveMask = 0;
+
+	/** Living combatants of each side */
+	FMask SideMasks[NumSides] = {};
+
+	/**
+	 * Valid targets per caster side, target type and category. Entries of self-targeted kinds are 0:
+	 * they resolve to the caster's own bit.
+	 */
+	FMask TargetMasks[NumSides][NumTargetTypes][NumCategories] = {};
+
+	bool bBuilt = false;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Manager/SkillData.h"
+#include <type_traits>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Flat, versioned binary table of every skill, built from the USkillData assets by USkillTableCommandlet.
+ *
+ * File layout (little endian, offsets from the start of the file):
+ *   FCookedSkillTableHeader
+ *   uint32 Displacements[NumBuckets]      - hash-and-displace perfect hash of the skill ids
+ *   FCookedSkillRecord Records[NumSkills] - one record per skill, stored at its perfect hash slot
+ *   UTF-8 string pool                     - names, descriptions and formulas referenced by the records
+ *
+ * At runtime the file is memory-mapped and read in place: looking up a skill id is two hashes and one
+ * compare, and no UObject is created. The data assets remain the authoring format.
+ */
+
+/** String stored in the table's UTF-8 string pool (not null-terminated) */
+struct FCookedSkillString
+{
+	uint32 Offset;
+	uint32 Length;
+};
+
+/** One skill, laid out exactly as in the file (fields named as on USkillData) */
+struct FCookedSkillRecord
+{
+	/** FCookedSkillTable::MakeSkillId of the asset name */
+	uint32 SkillId;
+
+	/** FCookedSkillTable::MakeContentHash of the asset when the table was built */
+	uint32 ContentHash;
+
+	float Damage;
+	float TechniqueCost;
+	float CastingTime;
+	float ModifierValue;
+	float StatusEffectMagnitude;
+	int32 Duration;
+	int32 StatusEffectDuration;
+	int32 DamageTypeMask;
+	int32 ShieldDamage;
+
+	EAttackType AttackType;
+	ETargetMode TargetMode;
+	ETargetType TargetType;
+	EAbilityCategory AbilityCategory;
+	ECombatStatType AffectedStat;
+	EModifierType ModifierType;
+	EStatusEffectType StatusEffect;
+	uint8 Padding;
+
+	FCookedSkillString AssetName;
+	FCookedSkillString SkillName;
+	FCookedSkillString Description;
+	FCookedSkillString DamageFormula;
+	FCookedSkillString HealFormula;
+};
+
+static_assert(std::is_trivially_copyable_v<FCookedSkillRecord>, "FCookedSkillRecord is read in place from the mapped file");
+
+struct FCookedSkillTableHeader
+{
+	/** "OSKT" */
+	static constexpr uint32 ExpectedMagic = 0x544B534F;
+
+	/** Bump when the layout or the hash functions change */
+	static constexpr uint32 CurrentVersion = 2;
+
+	uint32 Magic;
+	uint32 Version;
+	/** sizeof(FCookedSkillRecord) when the table was built, catching layout changes without a version bump */
+	uint32 RecordSize;
+	uint32 NumSkills;
+	uint32 NumBuckets;
+	uint32 DisplacementsOffset;
+	uint32 RecordsOffset;
+	uint32 StringsOffset;
+	uint32 StringsSize;
+	/** CRC of everything after the header */
+	uint32 PayloadCrc;
+};
+
+/**
+ * FCookedSkillTable
+ *
+ * Read-only view over a cooked skill table, either memory-mapped from disk or owning a buffer
+ * (platforms without mapping support, or a table just built in memory).
+ */
+class OCTOPATH_API FCookedSkillTable
+{
+public:
+	FCookedSkillTable();
+	~FCookedSkillTable();
+	UE_NONCOPYABLE(FCookedSkillTable);
+
+	/** Default location of the cooked table (staged as a loose file so it can be mapped). */
+	static FString GetDefaultFilename();
+
+	/** Stable id of a skill: case-insensitive hash of its asset name (e.g. DA_Skill_Hikari_01). */
+	static uint32 MakeSkillId(FName AssetName);
+
+	/**
+	 * Hash of every field of a skill stored in its record. A record whose ContentHash differs from the
+	 * hash of the loaded asset is stale (the asset was edited after the table was built).
+	 */
+	static uint32 MakeContentHash(const USkillData& Skill);
+
+	/**
+	 * Packs skills into a table.
+	 * @param Skills - The skills to pack. Their asset names must hash to distinct ids.
+	 * @param OutBytes - Receives the file contents.
+	 * @param OutError - Receives the reason of a failure.
+	 * @return True on success.
+	 */
+	static bool Build(TConstArrayView<const USkillData*> Skills, TArray<uint8>& OutBytes, FString& OutError);
+
+	/** Maps a table file (falls back to reading it when mapping is not supported). Returns false if it is missing or invalid. */
+	bool LoadFromFile(const FString& Filename);
+
+	/** Takes ownership of a table held in memory. Returns false if it is invalid. */
+	bool LoadFromMemory(TArray<uint8>&& Bytes);
+
+	/** Unmaps or frees the table. */
+	void Reset();
+
+	bool IsLoaded() const { return Header != nullptr; }
+
+	int32 Num() const { return Header ? static_cast<int32>(Header->NumSkills) : 0; }
+
+	/** Returns the record of a skill id, or nullptr. */
+	const FCookedSkillRecord* Find(uint32 SkillId) const;
+
+	/** Returns the record of a skill asset name, or nullptr. */
+	const FCookedSkillRecord* Find(FName AssetName) const { return Find(MakeSkillId(AssetName)); }
+
+	/** Every record, in slot order. */
+	TConstArrayView<FCookedSkillRecord> GetRecords() const { return TConstArrayView<FCookedSkillRecord>(Records, Num()); }
+
+	/** Returns a string of a record without copying it (empty if it points outside the string pool). */
+	FUtf8StringView GetStringView(const FCookedSkillString& String) const
+	{
+		// Shipping builds skip the checksum, so a corrupted record must not read past the pool.
+		if (!Header || static_cast<uint64>(String.Offset) + String.Length > Header->StringsSize)
+		{
+			return FUtf8StringView();
+		}
+		return FUtf8StringView(Strings + String.Offset, String.Length);
+	}
+
+	/** Returns a string of a record converted to FString. */
+	FString GetString(const FCookedSkillString& String) const { return FString(GetStringView(String)); }
+
+private:
+	/** Validates the header and binds the section pointers to the buffer. */
+	bool Bind(const uint8* Data, int64 Size, const FString& SourceName);
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> OwnedBytes;
+
+	const FCookedSkillTableHeader* Header = nullptr;
+	const uint32* Displacements = nullptr;
+	const FCookedSkillRecord* Records = nullptr;
+	const UTF8CHAR* Strings = nullptr;
+};
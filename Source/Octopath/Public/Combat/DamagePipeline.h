@@ -0,0 +1,191 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DamagePipeline.generated.h"
+
+/**
+ * Constants of the damage formulas.
+ * The values come from the combat balance settings (UCombatBalanceSettings), which also hold the skill constants
+ * of the allies and of the enemies (see the ability components' GetDamageTunables).
+ */
+USTRUCT(BlueprintType)
+struct OCTOPATH_API FDamageTunables
+{
+	GENERATED_BODY()
+
+	/** Scale applied to the whole default attack formula */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Basic Attack")
+	float BasicAttackScale = 0.8f;
+
+	/** Fraction of the target's defense subtracted by the default attack */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Basic Attack")
+	float BasicAttackDefenseFactor = 0.5f;
+
+	/** Skills subtract Defense * SkillDefenceRatio / SkillDefenceDivisor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Skill")
+	float SkillDefenceRatio = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Skill")
+	float SkillDefenceDivisor = 2.f;
+
+	/** Range of the random multiplier rolled for skills */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Skill")
+	float VarianceMin = 0.98f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage|Skill")
+	float VarianceMax = 1.02f;
+
+	/** Every hit deals at least this much damage */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
+	float MinimumDamage = 1.f;
+
+	/** Global tunables of the current combat balance (FCombatBalance::Get().Damage). */
+	static const FDamageTunables& Get();
+};
+
+/**
+ * Damage pipeline built from policies, one per stage:
+ *   attack type (which attack/defense stats) -> mitigation (formula) -> variance -> minimum -> defending reduction
+ *   -> break multiplier.
+ *
+ * Every (physical/magical x basic/skill) combination is a distinct instantiation, so the formula
+ * is fully specialized at compile time and inlines into hot loops. The stats type is a template parameter too:
+ * the same pipeline runs on live UStatComponents and on FCombatantSnapshots in simulations.
+ */
+namespace DamagePipeline
+{
+	// --- Attack type policies ---
+
+	struct FPhysicalAttack
+	{
+		template<typename StatsType> static FORCEINLINE float Attack(const StatsType& Stats) { return Stats.PhysicalAttack; }
+		template<typename StatsType> static FORCEINLINE float Defense(const StatsType& Stats) { return Stats.PhysicalDefense; }
+		static constexpr bool bIsMagical = false;
+	};
+
+	struct FMagicalAttack
+	{
+		template<typename StatsType> static FORCEINLINE float Attack(const StatsType& Stats) { return Stats.MagicalAttack; }
+		template<typename StatsType> static FORCEINLINE float Defense(const StatsType& Stats) { return Stats.MagicalDefense; }
+		static constexpr bool bIsMagical = true;
+	};
+
+	// --- Mitigation policies ---
+
+	/** Default attack: Scale * (Attack - Defense * DefenseFactor), split in two halves cached by FDerivedCombatStats */
+	struct FBasicAttackMitigation
+	{
+		static FORCEINLINE float Output(float Attack, const FDamageTunables& Tunables) { return Tunables.BasicAttackScale * Attack; }
+		static FORCEINLINE float Reduction(float Defense, const FDamageTunables& Tunables) { return Tunables.BasicAttackScale * Tunables.BasicAttackDefenseFactor * Defense; }
+		static FORCEINLINE float Mitigate(float Attack, float Defense, const FDamageTunables& Tunables) { return Output(Attack, Tunables) - Reduction(Defense, Tunables); }
+	};
+
+	/** Skills: Attack - Defense * Ratio / Divisor */
+	struct FSkillMitigation
+	{
+		static FORCEINLINE float Mitigate(float Attack, float Defense, const FDamageTunables& Tunables)
+		{
+			return Attack - (Defense * Tunables.SkillDefenceRatio / Tunables.SkillDefenceDivisor);
+		}
+	};
+
+	// --- Variance policies ---
+
+	struct FNoVariance
+	{
+		static FORCEINLINE float Roll(FRandomStream* Random, const FDamageTunables& Tunables) { return 1.f; }
+	};
+
+	struct FRandomVariance
+	{
+		static FORCEINLINE float Roll(FRandomStream* Random, const FDamageTunables& Tunables)
+		{
+			return Random ? Random->FRandRange(Tunables.VarianceMin, Tunables.VarianceMax) : FMath::FRandRange(Tunables.VarianceMin, Tunables.VarianceMax);
+		}
+	};
+
+	// --- Defending and break policies ---
+
+	/** Defending targets (whatever the side) take DefenseReductionPercentage less damage */
+	struct FApplyDefending
+	{
+		template<typename StatsType> static FORCEINLINE float Scale(const StatsType& Target, float Damage)
+		{
+			return Target.bIsDefending ? Damage * (1.f - Target.DefenseReductionPercentage) : Damage;
+		}
+	};
+
+	/** Broken targets take BrokenDamageMultiplier times the damage (whatever the side) */
+	struct FApplyBreak
+	{
+		template<typename StatsType> static FORCEINLINE float Scale(const StatsType& Target, float Damage)
+		{
+			return Target.IsBroken() ? Damage * Target.BrokenDamageMultiplier : Damage;
+		}
+	};
+
+	// --- Pipeline ---
+
+	template<typename AttackTypePolicy, typename MitigationPolicy, typename VariancePolicy>
+	struct TDamagePipeline
+	{
+		using AttackType = AttackTypePolicy;
+
+		/** Rolls the variance multiplier of one hit. */
+		static FORCEINLINE float RollVariance(FRandomStream* Random, const FDamageTunables& Tunables)
+		{
+			return VariancePolicy::Roll(Random, Tunables);
+		}
+
+		/**
+		 * Damage passed to ApplyDamage (the target still applies its own defending / break scale).
+		 * @param BaseDamage - Added to the attacker's attack (the skill's Damage, 0 for the default attack).
+		 */
+		template<typename StatsType>
+		static FORCEINLINE float Raw(const StatsType& Attacker, const StatsType& Target, float BaseDamage, float Variance, const FDamageTunables& Tunables)
+		{
+			const float Attack = BaseDamage + AttackTypePolicy::Attack(Attacker);
+			const float Mitigated = MitigationPolicy::Mitigate(Attack, AttackTypePolicy::Defense(Target), Tunables);
+			return FMath::Max(Mitigated * Variance, Tunables.MinimumDamage);
+		}
+
+		/**
+		 * Raw damage of one attack against many targets (skills hitting all enemies).
+		 * The caster's attack is read once and the targets' defenses are passed as a flat array,
+		 * so the per-target formula is a branch-free loop over contiguous floats that the compiler vectorizes.
+		 * @param Defenses - Defense of each target for this attack type (see AttackType::Defense).
+		 * @param Variances - Variance multiplier of each target.
+		 * @param OutDamage - Receives the raw damage of each target (same size as Defenses).
+		 */
+		template<typename StatsType>
+		static void RawBatch(const StatsType& Attacker, float BaseDamage, TArrayView<const float> Defenses, TArrayView<const float> Variances,
+			TArrayView<float> OutDamage, const FDamageTunables& Tunables)
+		{
+			check(Defenses.Num() == Variances.Num() && Defenses.Num() == OutDamage.Num());
+			const float Attack = BaseDamage + AttackTypePolicy::Attack(Attacker);
+			const float* RESTRICT DefenseData = Defenses.GetData();
+			const float* RESTRICT VarianceData = Variances.GetData();
+			float* RESTRICT OutData = OutDamage.GetData();
+			for (int32 i = 0; i < OutDamage.Num(); i++)
+			{
+				OutData[i] = FMath::Max(MitigationPolicy::Mitigate(Attack, DefenseData[i], Tunables) * VarianceData[i], Tunables.MinimumDamage);
+			}
+		}
+
+		/**
+		 * Health lost by the target, defending reduction and break multiplier included (previews and simulations).
+		 * Same scale as the target's IncomingDamageScale applied by UStatComponent::ApplyDamage.
+		 */
+		template<typename StatsType>
+		static FORCEINLINE float Final(const StatsType& Attacker, const StatsType& Target, float BaseDamage, float Variance, const FDamageTunables& Tunables)
+		{
+			return FApplyBreak::Scale(Target, FApplyDefending::Scale(Target, Raw(Attacker, Target, BaseDamage, Variance, Tunables)));
+		}
+	};
+
+	template<typename AttackTypePolicy>
+	using TBasicAttackPipeline = TDamagePipeline<AttackTypePolicy, FBasicAttackMitigation, FNoVariance>;
+
+	template<typename AttackTypePolicy>
+	using TSkillPipeline = TDamagePipeline<AttackTypePolicy, FSkillMitigation, FRandomVariance>;
+}
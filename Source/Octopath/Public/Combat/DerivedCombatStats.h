@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DerivedCombatStats.generated.h"
+
+class UStatComponent;
+enum class EStatChannel : uint8;
+
+/**
+ * Derived combat values cached per combatant.
+ * Nodes are listed so that a node only depends on stats and on nodes declared before it.
+ */
+UENUM(BlueprintType)
+enum class EDerivedStat : uint8
+{
+	/** Attacker side of the default attack formula (scaled physical attack) */
+	BasicAttackOutput       UMETA(DisplayName = "Basic Attack Output"),
+	/** Target side of the default attack formula (scaled physical defense) */
+	BasicAttackMitigation   UMETA(DisplayName = "Basic Attack Mitigation"),
+	/** Multiplier applied to incoming damage (1 - DefenseReductionPercentage while defending, times BrokenDamageMultiplier while broken) */
+	IncomingDamageScale     UMETA(DisplayName = "Incoming Damage Scale"),
+	/** Health / MaxHealth */
+	HealthFraction          UMETA(DisplayName = "Health Fraction"),
+	/** Raw damage needed to bring Health to 0, taking the incoming damage scale into account */
+	EffectiveHealth         UMETA(DisplayName = "Effective Health"),
+
+	Count                   UMETA(Hidden)
+};
+
+/**
+ * FDerivedCombatStats
+ *
+ * Small dependency graph of derived combat values for one UStatComponent.
+ * Each node is recomputed lazily on read, and only after one of its inputs (a stat channel,
+ * the defending flag, the broken state, or another node) was invalidated. Reading a clean node is an array load.
+ */
+struct OCTOPATH_API FDerivedCombatStats
+{
+public:
+	static constexpr int32 NumNodes = static_cast<int32>(EDerivedStat::Count);
+
+	/** Returns the value of a node, recomputing it (and its dirty inputs) from Owner if needed. */
+	float Get(EDerivedStat Stat, const UStatComponent& Owner) const;
+
+	/** Marks every node that depends on the given stat channel as dirty. */
+	void InvalidateChannel(EStatChannel Channel);
+
+	/** Marks every node that depends on the defending state as dirty. */
+	void InvalidateDefending();
+
+	/** Marks every node that depends on the broken state as dirty. */
+	void InvalidateBroken();
+
+	/** Marks every node as dirty (e.g. after stats were written directly). */
+	void InvalidateAll() { DirtyMask = AllNodesMask; }
+
+	/** Combines the attacker and target caches into the default attack damage (before the incoming damage scale). */
+	static float BasicAttackDamage(const FDerivedCombatStats& Attacker, const UStatComponent& AttackerOwner, const FDerivedCombatStats& Target, const UStatComponent& TargetOwner);
+
+private:
+	static constexpr uint32 AllNodesMask = (1u << NumNodes) - 1u;
+
+	/** Computes a node from its inputs. */
+	float Evaluate(EDerivedStat Stat, const UStatComponent& Owner) const;
+
+	/** Cached node values (refreshed lazily by Get) */
+	mutable float Values[NumNodes] = {};
+
+	/** One bit per node; set when the cached value is stale */
+	mutable uint32 DirtyMask = AllNodesMask;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Variables readable by formulas. Names in formulas: Caster.<Stat>, Target.<Stat>, Skill.Damage,
+ * Skill.ModifierValue, Skill.TechniqueCost and Variance, where <Stat> is one of Health, MaxHealth,
+ * TechniquePoints, MaxTechniquePoints, PhysicalAttack, MagicalAttack, PhysicalDefense, MagicalDefense, Speed.
+ */
+enum class EFormulaVariable : uint8
+{
+	CasterHealth,
+	CasterMaxHealth,
+	CasterTechniquePoints,
+	CasterMaxTechniquePoints,
+	CasterPhysicalAttack,
+	CasterMagicalAttack,
+	CasterPhysicalDefense,
+	CasterMagicalDefense,
+	CasterSpeed,
+
+	TargetHealth,
+	TargetMaxHealth,
+	TargetTechniquePoints,
+	TargetMaxTechniquePoints,
+	TargetPhysicalAttack,
+	TargetMagicalAttack,
+	TargetPhysicalDefense,
+	TargetMagicalDefense,
+	TargetSpeed,
+
+	SkillDamage,
+	SkillModifierValue,
+	SkillTechniqueCost,
+
+	Variance,
+
+	Count
+};
+
+/** Values of every formula variable for one evaluation (plain floats: safe to fill and read on any thread) */
+struct FFormulaVariables
+{
+	static constexpr int32 NumVariables = static_cast<int32>(EFormulaVariable::Count);
+
+	float Values[NumVariables] = {};
+
+	/** Copies the caster stats (works with UStatComponent and FCombatantSnapshot). */
+	template<typename StatsType>
+	void SetCaster(const StatsType& Stats) { WriteStats(&Values[static_cast<int32>(EFormulaVariable::CasterHealth)], Stats); }
+
+	/** Copies the target stats (works with UStatComponent and FCombatantSnapshot). */
+	template<typename StatsType>
+	void SetTarget(const StatsType& Stats) { WriteStats(&Values[static_cast<int32>(EFormulaVariable::TargetHealth)], Stats); }
+
+	void Set(EFormulaVariable Variable, float Value) { Values[static_cast<int32>(Variable)] = Value; }
+
+private:
+	template<typename StatsType>
+	static void WriteStats(float* Dest, const StatsType& Stats)
+	{
+		Dest[0] = Stats.Health;
+		Dest[1] = Stats.MaxHealth;
+		Dest[2] = Stats.TechniquePoints;
+		Dest[3] = Stats.MaxTechniquePoints;
+		Dest[4] = Stats.PhysicalAttack;
+		Dest[5] = Stats.MagicalAttack;
+		Dest[6] = Stats.PhysicalDefense;
+		Dest[7] = Stats.MagicalDefense;
+		Dest[8] = Stats.Speed;
+	}
+};
+
+/** Register machine operations */
+enum class EFormulaOp : uint8
+{
+	LoadConst,  // R[Dst] = Constants[A]
+	LoadVar,    // R[Dst] = Variables[A]
+	Add,        // R[Dst] = R[A] + R[B]
+	Sub,        // R[Dst] = R[A] - R[B]
+	Mul,        // R[Dst] = R[A] * R[B]
+	Div,        // R[Dst] = R[A] / R[B] (0 when R[B] is 0)
+	Min,        // R[Dst] = min(R[A], R[B])
+	Max,        // R[Dst] = max(R[A], R[B])
+	Neg         // R[Dst] = -R[A]
+};
+
+struct FFormulaInstruction
+{
+	EFormulaOp Op;
+	uint8 Dst;
+	uint8 A;
+	uint8 B;
+};
+
+/**
+ * FCompiledFormula
+ *
+ * Designer formula such as "(Skill.Damage + Caster.MagicalAttack - Target.MagicalDefense * 0.5) * Variance",
+ * compiled once into register bytecode. Constant sub-expressions are folded at compile time.
+ * Supports + - * /, unary -, parentheses, numbers, the variables above, min(a, b), max(a, b) and clamp(x, lo, hi).
+ *
+ * Evaluate only reads the instruction list and the given variables, so a compiled formula can be shared by
+ * worker threads running simulations.
+ */
+struct OCTOPATH_API FCompiledFormula
+{
+public:
+	static constexpr int32 MaxRegisters = 16;
+
+	/**
+	 * Compiles a formula, replacing the previous program.
+	 * @param Source - The formula text.
+	 * @param OutError - Receives the error message (with the character position) if compilation fails.
+	 * @return True on success. On failure the formula is left empty.
+	 */
+	bool Compile(const FString& Source, FString* OutError = nullptr);
+
+	/** Empties the program. */
+	void Reset();
+
+	/** Returns true if a formula was compiled successfully. */
+	bool IsValid() const { return Code.Num() > 0; }
+
+	/** Returns true if the formula reads the given variable. */
+	bool UsesVariable(EFormulaVariable Variable) const { return (VariableMask & (1u << static_cast<uint32>(Variable))) != 0; }
+
+	/** Runs the program. Must only be called on a valid formula. */
+	float Evaluate(const FFormulaVariables& Variables) const;
+
+	const TArray<FFormulaInstruction>& GetCode() const { return Code; }
+
+private:
+	TArray<FFormulaInstruction> Code;
+	TArray<float> Constants;
+
+	/** One bit per EFormulaVariable read by the program */
+	uint32 VariableMask = 0;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/CombatTargetCache.h"
+
+class APlayerController;
+
+/**
+ * Screen-space picking of the combatant under the cursor.
+ *
+ * The collision bounds of every combatant of a FCombatTargetCache are projected once to a screen rectangle and
+ * binned in a coarse grid of slot masks. The rectangles are only projected again when the camera, the viewport
+ * or one of the combatants moved (the combat camera is static, so usually once per turn), and the combatant
+ * under the cursor is only searched again when the cursor moved: hovering costs no physics query, and a frame
+ * with a still cursor only compares a few transforms.
+ *
+ * Unlike a cursor trace, rectangles ignore occlusion by the level; among overlapping rectangles of candidate
+ * combatants, the one nearest to the camera wins.
+ */
+class OCTOPATH_API FScreenTargetPicker
+{
+public:
+	using FMask = FCombatTargetCache::FMask;
+
+	/**
+	 * Returns the candidate combatant under the cursor, or nullptr if there is none (or no mouse).
+	 * @param PC - Player controller owning the viewport and the cursor.
+	 * @param Targets - Combatant slots; the rectangles are rebuilt when its actors change.
+	 * @param Candidates - Slots that may be picked (e.g. the valid targets of the selected skill).
+	 */
+	AActor* GetActorUnderCursor(const APlayerController& PC, const FCombatTargetCache& Targets, FMask Candidates);
+
+	/** Returns true if the cursor moved between the last two GetActorUnderCursor calls. */
+	bool HasCursorMoved() const { return bCursorMoved; }
+
+	/** Projects the rectangles again if the camera, the viewport or a combatant moved since the last projection. */
+	void Update(const APlayerController& PC, const FCombatTargetCache& Targets);
+
+	/** Returns the center of a slot's screen rectangle; false if the slot is not on screen. */
+	bool GetScreenCenter(int32 Slot, FVector2D& OutCenter) const;
+
+	/** Returns the slot of the candidate whose rectangle contains a viewport position, nearest to the camera first. */
+	int32 Pick(const FVector2D& ScreenPosition, FMask Candidates) const;
+
+	/** Forces the rectangles to be projected again on the next query. */
+	void Invalidate() { bBuilt = false; }
+
+private:
+	/** Screen rectangles are binned in GridSize x GridSize cells over the viewport */
+	static constexpr int32 GridSize = 8;
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Actor transform the rectangle was projected from */
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+
+		FBox2D Rect = FBox2D(ForceInit);
+
+		/** Distance from the camera to the bounds' center */
+		float Depth = 0.f;
+	};
+
+	/** Returns true if the camera, the viewport or a combatant moved since the rectangles were projected. */
+	bool IsStale(const APlayerController& PC, const FCombatTargetCache& Targets) const;
+
+	/** Projects every combatant's bounds and fills the grid. */
+	void Build(const APlayerController& PC, const FCombatTargetCache& Targets);
+
+	static void GetView(const APlayerController& PC, FVector& OutLocation, FRotator& OutRotation, float& OutFOV, FIntPoint& OutViewportSize);
+
+	TArray<FEntry, TInlineAllocator<8>> Entries;
+
+	/** Slots whose rectangle overlaps each cell */
+	FMask Cells[GridSize * GridSize] = {};
+
+	// View the rectangles were projected with
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation = FRotator::ZeroRotator;
+	float ViewFOV = 0.f;
+	FIntPoint ViewportSize = FIntPoint::ZeroValue;
+
+	// Inputs and result of the last pick
+	FVector2D LastCursor = FVector2D(-1.f, -1.f);
+	FMask LastCandidates = 0;
+	int32 LastPickedSlot = INDEX_NONE;
+	bool bHasPick = false;
+	bool bCursorMoved = false;
+
+	bool bBuilt = false;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkillHitResult.generated.h"
+
+class USkillData;
+
+/** Outcome of a skill on one of its targets */
+USTRUCT(BlueprintType)
+struct OCTOPATH_API FSkillHitResult
+{
+	GENERATED_BODY()
+
+	/** The actor hit */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	AActor* Target = nullptr;
+
+	/** Health actually lost (after defending, break and clamping) */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	float Damage = 0.f;
+
+	/** Health actually recovered */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	float Healing = 0.f;
+
+	/** Health left after the skill */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	float RemainingHealth = 0.f;
+
+	/** The skill hit one of the target's weaknesses */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	bool bWeaknessHit = false;
+
+	/** The skill broke the target's shield */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	bool bBroken = false;
+
+	/** The target's health reached 0 */
+	UPROPERTY(BlueprintReadOnly, Category = "Skill|Result")
+	bool bDefeated = false;
+};
+
+/** Fired once per skill cast with the outcome on every target, in targeting order (damage numbers, hit VFX) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnMultiHitResolved, AActor*, Caster, USkillData*, Skill, const TArray<FSkillHitResult>&, Results);
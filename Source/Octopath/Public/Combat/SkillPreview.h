@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Combat/DamagePipeline.h"
+#include "SkillPreview.generated.h"
+
+class USkillData;
+class UStatComponent;
+
+/** Expected outcome of a skill on one target, from the lowest to the highest variance roll */
+USTRUCT(BlueprintType)
+struct OCTOPATH_API FSkillPreview
+{
+	GENERATED_BODY()
+
+	/** Damage dealt with the lowest variance roll (after the target's defending and break multipliers) */
+	UPROPERTY(BlueprintReadOnly, Category = "Preview")
+	float MinDamage = 0.f;
+
+	/** Damage dealt with the highest variance roll */
+	UPROPERTY(BlueprintReadOnly, Category = "Preview")
+	float MaxDamage = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Preview")
+	float MinHealing = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Preview")
+	float MaxHealing = 0.f;
+
+	/** Whether the skill hits one of the target's weaknesses */
+	UPROPERTY(BlueprintReadOnly, Category = "Preview")
+	bool bWeaknessHit = false;
+
+	bool HasDamage() const { return MaxDamage > 0.f; }
+	bool HasHealing() const { return MaxHealing > 0.f; }
+
+	/** Formats the preview for the UI (e.g. "120-125 damage", "+40 HP"); empty if the skill neither damages nor heals. */
+	FText ToText() const;
+};
+
+/**
+ * FSkillPreviewCache
+ *
+ * Previews keyed by (skill, caster, target). An entry stores the stat versions of the caster and the target it
+ * was computed from (UStatComponent::GetStatVersion) and is only re-evaluated once one of them changed, so
+ * hovering back and forth across targets costs one map lookup per hover.
+ * Damage tunables are not part of the key: call Reset after changing them.
+ */
+class OCTOPATH_API FSkillPreviewCache
+{
+public:
+	/** Returns the preview of a skill cast by Caster on Target, evaluating it only if a relevant stat changed. */
+	const FSkillPreview& Get(const USkillData& Skill, const UStatComponent& Caster, const UStatComponent& Target, const FDamageTunables& Tunables);
+
+	/** Drops every entry (e.g. when the combat ends). */
+	void Reset() { Entries.Reset(); }
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	struct FKey
+	{
+		TObjectKey<USkillData> Skill;
+		TObjectKey<UStatComponent> Caster;
+		TObjectKey<UStatComponent> Target;
+
+		bool operator==(const FKey& Other) const { return Skill == Other.Skill && Caster == Other.Caster && Target == Other.Target; }
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Skill), GetTypeHash(Key.Caster)), GetTypeHash(Key.Target));
+		}
+	};
+
+	struct FEntry
+	{
+		uint32 CasterVersion = 0;
+		uint32 TargetVersion = 0;
+		FSkillPreview Preview;
+	};
+
+	TMap<FKey, FEntry> Entries;
+};
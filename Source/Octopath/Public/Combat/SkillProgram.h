@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/DamagePipeline.h"
+#include "Combat/FormulaExpression.h"
+
+class USkillData;
+class UStatComponent;
+class FCookedSkillTable;
+struct FCookedSkillRecord;
+struct FSkillHitResult;
+struct FSkillPreview;
+struct FCombatantSnapshot;
+struct FCombatSnapshot;
+
+/** Operations of a compiled skill program */
+enum class ESkillOp : uint8
+{
+	/** Caster spends Value technique points */
+	SpendTechniquePoints,
+	/** Rolls one damage variance multiplier per target */
+	RollVariance,
+	/** Deals Value + caster attack to every target, or the skill's damage formula (Arg0: EAttackType) */
+	Damage,
+	/** Heals every target by Value, or by the skill's heal formula */
+	Heal,
+	/** Applies a stat modifier (Arg0: ECombatStatType, Arg1: EModifierType, Value, IntValue: turns) */
+	ApplyModifier,
+	/** Applies a status effect (Arg0: EStatusEffectType, Value: magnitude, IntValue: rounds) */
+	ApplyStatusEffect,
+	/** Hits every target's shield in one batched pass (Arg0: shield damage, IntValue: EDamageType mask) */
+	ShieldHit
+};
+
+/** One operation of a skill program (12 bytes) */
+struct FSkillOp
+{
+	ESkillOp Code;
+	uint8 Arg0 = 0;
+	uint8 Arg1 = 0;
+	/** Applies the operation to the caster instead of the targets */
+	uint8 bOnCaster = 0;
+	float Value = 0.f;
+	int32 IntValue = 0;
+};
+
+/** Inputs of one skill cast */
+struct FSkillExecutionContext
+{
+	/** Stats of the caster (never null) */
+	UStatComponent* Caster = nullptr;
+
+	/** Stats of the targets, in targeting order */
+	TArrayView<UStatComponent* const> Targets;
+
+	/** Stream used for the variance rolls (falls back to FMath when null) */
+	FRandomStream* Random = nullptr;
+
+	/** Damage formula constants (skill fields overridden by the caster's ability component) */
+	FDamageTunables Tunables = FDamageTunables::Get();
+
+	/** Optional: receives the outcome on each target, in the order of Targets */
+	TArray<FSkillHitResult>* OutResults = nullptr;
+};
+
+/**
+ * FSkillProgram
+ *
+ * Flat list of operations compiled once from a USkillData (on load and on edit), so casting a skill runs
+ * the operations in order instead of re-branching on the skill category, target type and attack type.
+ * The same interpreter executes ally and enemy skills, and a skill can chain effects (e.g. damage + debuff).
+ * Each op resolves all its targets in one pass: outcomes are computed into flat arrays, every health value is
+ * written, then each target broadcasts once.
+ */
+struct OCTOPATH_API FSkillProgram
+{
+public:
+	/** Rebuilds the operation list from the skill's properties. */
+	void Compile(const USkillData& Skill);
+
+	/** Rebuilds the operation list from a record of the cooked skill table. */
+	void Compile(const FCookedSkillTable& Table, const FCookedSkillRecord& Record);
+
+	/** Returns true if the caster can cast the skill (not silenced, enough technique points). */
+	bool CanExecute(const UStatComponent& Caster) const;
+
+	/**
+	 * Runs the operations against the context.
+	 * @return Total damage dealt, minus healing done, plus modifier values applied (0 if the skill could not be cast).
+	 */
+	float Execute(const FSkillExecutionContext& Context) const;
+
+	/**
+	 * Computes the damage and healing the operations would do to one target at both ends of the variance range,
+	 * with the same formulas as Execute. Nothing is rolled or applied.
+	 */
+	void Preview(const UStatComponent& Caster, const UStatComponent& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const;
+
+	/** Same as above on snapshot data (AI scoring and simulations, no component access). */
+	void Preview(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const;
+
+	/**
+	 * Runs the operations against a snapshot exactly as Execute runs them against the live components: same rolls
+	 * drawn from Random in the same order, same values written (speculation). Nothing is broadcast.
+	 * @param TargetSlots - Slots of the targets in State, in targeting order.
+	 * @return Same value as Execute.
+	 */
+	float Simulate(FCombatSnapshot& State, int32 CasterSlot, TConstArrayView<int32> TargetSlots, FRandomStream& Random, const FDamageTunables& Tunables) const;
+
+	const TArray<FSkillOp>& GetOps() const { return Ops; }
+
+private:
+	/** Shared by both Compile overloads (FCookedSkillRecord mirrors the USkillData field names). */
+	template<typename SkillType>
+	void CompileFrom(const SkillType& Skill, const FString& InDebugName, const FString& DamageFormulaSource, const FString& HealFormulaSource);
+
+	/** Shared by both Preview overloads. */
+	template<typename StatsType>
+	void PreviewFrom(const StatsType& Caster, const StatsType& Target, const FDamageTunables& Tunables, FSkillPreview& OutPreview) const;
+
+	TArray<FSkillOp> Ops;
+
+	/** Designer formulas (empty when the skill uses the built-in ones) */
+	FCompiledFormula DamageFormula;
+	FCompiledFormula HealFormula;
+
+	/** Skill fields readable by the formulas */
+	float SkillDamage = 0.f;
+	float SkillModifierValue = 0.f;
+
+	/** Technique points cost, checked before running the operations */
+	float TechniqueCost = 0.f;
+
+	/** Skill name, for logs */
+	FString DebugName;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Combat/CookedSkillTable.h"
+#include "SkillTableSubsystem.generated.h"
+
+/**
+ * USkillTableSubsystem
+ *
+ * Maps the cooked skill table (see FCookedSkillTable) once per game instance, so skills can be looked up
+ * by id in O(1) and read in place without loading a USkillData per skill.
+ * Each record is compiled into an FSkillProgram when the table is mapped, and USkillData::GetProgram returns it
+ * as long as the record's content hash matches the asset (a stale record falls back to the asset's own program).
+ * The table is optional: when it has not been built, IsAvailable returns false and callers keep using the assets.
+ */
+UCLASS()
+class OCTOPATH_API USkillTableSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Returns true if the cooked table was found and is valid. */
+	bool IsAvailable() const { return Table.IsLoaded(); }
+
+	/** The mapped table. */
+	const FCookedSkillTable& GetTable() const { return Table; }
+
+	/** Returns the record of a skill id (see FCookedSkillTable::MakeSkillId), or nullptr. */
+	const FCookedSkillRecord* FindSkill(uint32 SkillId) const { return Table.Find(SkillId); }
+
+	/** Returns the record of a skill asset, or nullptr. */
+	const FCookedSkillRecord* FindSkill(const USkillData* Skill) const { return Skill ? Table.Find(Skill->GetFName()) : nullptr; }
+
+	/** Returns the program compiled from the record of a skill asset, or nullptr if there is none or it is stale. */
+	const FSkillProgram* FindProgram(const USkillData& Skill) const;
+
+	/** FindProgram on the subsystem of the running game instance (nullptr outside of a game). */
+	static const FSkillProgram* FindActiveProgram(const USkillData& Skill);
+
+	/** Re-maps the table from disk (after rebuilding it with the SkillTable commandlet). */
+	bool Reload();
+
+private:
+	FCookedSkillTable Table;
+
+	/** Programs compiled from the records, by skill id */
+	TMap<uint32, FSkillProgram> Programs;
+
+	/** Subsystem of the last initialized game instance, read by USkillData::GetProgram (game thread only) */
+	static USkillTableSubsystem* ActiveSubsystem;
+};
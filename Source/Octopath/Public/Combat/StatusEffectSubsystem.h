@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Manager/SkillData.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class UStatComponent;
+
+/**
+ * One active status effect on one combatant.
+ */
+struct FStatusEffectInstance
+{
+	/** The combatant affected by the effect */
+	TWeakObjectPtr<UStatComponent> Target;
+
+	/** Damage (Poison) or healing (Regen) per round */
+	float Magnitude = 0.f;
+
+	/** Number of rounds remaining */
+	int32 RemainingTurns = 0;
+};
+
+/**
+ * UStatusEffectSubsystem
+ *
+ * Stores every active status effect of the combat in one contiguous pool per effect type
+ * and processes them in a single batched pass at the end of each round.
+ * - Pools are reserved for the combatant count when combat starts, so applying an effect does not allocate
+ *   (a combatant holds at most one instance per type; re-applying refreshes it).
+ * - Round processing walks each pool once: its cost follows the number of active effects, not combatants x effects.
+ * - Stun and Silence are mirrored as bit flags on UStatComponent, so turn and skill checks are O(1).
+ * - Stun durations count the turns the combatant loses, not rounds: a stun always costs at least one turn,
+ *   even when applied after the target already acted this round.
+ */
+UCLASS()
+class OCTOPATH_API UStatusEffectSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumEffectTypes = static_cast<int32>(EStatusEffectType::Count);
+
+	/**
+	 * Reserves every pool for the given number of combatants (called when combat starts).
+	 * @param MaxCombatants - Number of combatants taking part in the combat.
+	 */
+	void ReservePools(int32 MaxCombatants);
+
+	/**
+	 * Applies or refreshes a status effect on a combatant.
+	 * @param Target - The affected combatant.
+	 * @param EffectType - The effect to apply.
+	 * @param Magnitude - Damage or healing per round (Poison / Regen).
+	 * @param DurationTurns - Duration of the effect in rounds.
+	 */
+	void ApplyEffect(UStatComponent* Target, EStatusEffectType EffectType, float Magnitude, int32 DurationTurns);
+
+	/** Removes every effect applied to a combatant (e.g. when it is defeated). */
+	void RemoveAllEffects(UStatComponent* Target);
+
+	/**
+	 * Batched round pass: ticks Poison and Regen, then decrements and expires every effect but Stun.
+	 * Called from UTurnBasedCombatComponent::EndRound.
+	 */
+	void ProcessRoundEnd();
+
+	/**
+	 * Counts down the stun of a combatant whose turn was skipped, expiring it at 0.
+	 * Called from UTurnBasedCombatComponent when a stunned combatant loses its turn.
+	 */
+	void ConsumeStunnedTurn(UStatComponent* Target);
+
+	/** Removes every effect and clears all pools (keeps the reserved memory). */
+	void ResetPools();
+
+	/** Returns the instance of an effect on a combatant, or nullptr if the effect is not active. */
+	const FStatusEffectInstance* FindEffect(const UStatComponent* Target, EStatusEffectType EffectType) const;
+
+	/** Read-only access to the pool of a given effect type. */
+	const TArray<FStatusEffectInstance>& GetPool(EStatusEffectType EffectType) const;
+
+private:
+	/** Updates the status flag of the target for the given effect type. */
+	static void SetTargetFlag(UStatComponent* Target, EStatusEffectType EffectType, bool bActive);
+
+	/** One contiguous pool per effect type (index 0 is EStatusEffectType::None and stays empty) */
+	TArray<FStatusEffectInstance> Pools[NumEffectTypes];
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/CombatTargetCache.h"
+
+class FScreenTargetPicker;
+
+/**
+ * Valid targets of one selection ordered left to right on screen, for keyboard and gamepad cycling.
+ *
+ * Built once per selection from a target cache mask and the picker's projected rectangles (ties are broken
+ * top to bottom, and targets off screen come last in slot order). Stepping from any slot of the ring, including
+ * one chosen with the mouse in between, is a table lookup: no trace, no projection.
+ */
+struct OCTOPATH_API FTargetRing
+{
+	using FMask = FCombatTargetCache::FMask;
+
+	/** Orders the candidate slots by the center of their screen rectangle (the picker must be up to date). */
+	void Build(FMask InCandidates, const FScreenTargetPicker& Picker);
+
+	/** Forgets the ring; the next selection builds it again. */
+	void Reset();
+
+	bool IsBuilt() const { return bBuilt; }
+
+	/** Mask the ring was built from */
+	FMask GetCandidates() const { return Candidates; }
+
+	/**
+	 * Returns the slot Direction positions away from CurrentSlot, wrapping around.
+	 * A slot outside the ring steps from the ring's start (to its first or last slot); INDEX_NONE if the ring is empty.
+	 */
+	int32 Step(int32 CurrentSlot, int32 Direction) const;
+
+private:
+	/** Candidate slots in screen order */
+	TArray<int32, TInlineAllocator<8>> Slots;
+
+	/** Position in Slots of every slot, INDEX_NONE when not a candidate */
+	int8 RingIndices[FCombatTargetCache::MaxSlots];
+
+	FMask Candidates = 0;
+
+	bool bBuilt = false;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "EnemyAIProfile.generated.h"
+
+class UCurveFloat;
+
+/** Inputs scored by the enemy utility AI, each normalized to 0-1 */
+UENUM(BlueprintType)
+enum class EUtilityConsideration : uint8
+{
+	ExpectedDamage  UMETA(DisplayName = "Expected Damage"),
+	KillChance      UMETA(DisplayName = "Kill Chance"),
+	HealNeed        UMETA(DisplayName = "Heal Need"),
+	BuffUptime      UMETA(DisplayName = "Buff Uptime"),
+
+	Count           UMETA(Hidden)
+};
+
+/** Response curve of one consideration */
+USTRUCT(BlueprintType)
+struct OCTOPATH_API FUtilityCurve
+{
+	GENERATED_BODY()
+
+	/** Maps the normalized input (0-1) to a utility; the input is used as is when no curve is set */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	UCurveFloat* Curve = nullptr;
+
+	/** Multiplier applied to the curve output */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility", meta = (ClampMin = "0.0"))
+	float Weight = 1.f;
+};
+
+/**
+ * UEnemyAIProfile
+ *
+ * Data asset tuning how an enemy scores its options (see FEnemyUtilityAI).
+ * Every (skill, target) pair is scored by summing the weighted curves of the considerations it touches:
+ * - Expected Damage: average damage dealt, as a fraction of the target's remaining Health
+ * - Kill Chance: probability that the hit brings the target to 0 Health
+ * - Heal Need: missing Health of the healed target, as a fraction of its MaxHealth
+ * - Buff Uptime: share of the modifier duration not already covered by the same modifier on the target
+ *
+ * Bosses additionally plan a few actions ahead on a background task (see FEnemyLookahead) and only fall back
+ * to the utility choice when the search does not finish within its budget.
+ *
+ * An enemy without a profile uses the class defaults (linear curves, weight 1).
+ */
+UCLASS(BlueprintType)
+class OCTOPATH_API UEnemyAIProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Returns the weighted utility of a consideration for a normalized input. */
+	float Evaluate(EUtilityConsideration Consideration, float Input) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	FUtilityCurve ExpectedDamage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	FUtilityCurve KillChance;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	FUtilityCurve HealNeed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	FUtilityCurve BuffUptime;
+
+	/** Added to the score of the default attack (negative values make the enemy favor its skills) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility")
+	float DefaultAttackBias = 0.f;
+
+	/** Multiplier applied to the score of skills hitting every valid target, on top of the per-target sum */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Utility", meta = (ClampMin = "0.0"))
+	float AreaSkillWeight = 1.f;
+
+	/** Number of actions (the boss's and everyone else's) a boss plans ahead; 0 disables the search */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lookahead", meta = (ClampMin = "0", ClampMax = "8"))
+	int32 LookaheadDepth = 4;
+
+	/** Wall clock budget of the search in milliseconds; past it the boss keeps its utility choice */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lookahead", meta = (ClampMin = "0.1"))
+	float LookaheadBudgetMs = 5.f;
+};
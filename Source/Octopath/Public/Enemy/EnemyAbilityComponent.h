@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Enemy/EnemyUtilityAI.h"
 #include "EnemyAbilityComponent.generated.h"
 
 class USkillData;
+class UEnemyAIProfile;
+struct FCombatSnapshot;
 
 /**
  * UEnemyAbilityComponent
@@ -27,13 +30,38 @@ public:
 
 	/**
 	 * Executes a custom skill.
+	 * Kept for existing Blueprint call sites: forwards to ExecuteSkillOnTargets, targeting the owner for
+	 * self-targeted skills and nobody otherwise (the cost and the caster-side effects still apply).
 	 * @param Skill - The skill to execute.
 	 * @return The resulting effect value.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Enemy Abilities")
 	float ExecuteSkill(USkillData* Skill);
 
+	/**
+	 * Executes a custom skill by running its compiled program (the same interpreter as the allies' skills).
+	 * @param Skill - The skill to execute.
+	 * @param Targets - The actors targeted by the skill.
+	 * @return The resulting effect value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Abilities")
+	float ExecuteSkillOnTargets(USkillData* Skill, const TArray<AActor*>& Targets);
+
+	/**
+	 * Chooses the enemy's action by utility scoring (see FEnemyUtilityAI).
+	 * @param Snapshot - State of the combat, captured by UTurnBasedCombatComponent::CaptureSnapshot.
+	 * @param SelfSlot - Slot of the owner in the snapshot.
+	 */
+	FEnemyAction ChooseAction(const FCombatSnapshot& Snapshot, int32 SelfSlot) const;
+
+	/** Returns the damage constants of this enemy's skills (Enemy Skills of the combat balance settings). */
+	const FDamageTunables& GetDamageTunables() const;
+
 	/** Array of skills available to this enemy. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Enemy Abilities")
 	TArray<USkillData*> Skills;
+
+	/** Response curves used to pick skills and targets (class defaults when not set) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Enemy Abilities|AI")
+	UEnemyAIProfile* AIProfile = nullptr;
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Combat/CombatSnapshot.h"
+#include "Enemy/EnemyUtilityAI.h"
+
+class USkillData;
+
+/**
+ * Synthetic combat shared by the enemy AI benchmarks (Octopath.Bench.EnemyAI, Octopath.Bench.Lookahead and
+ * Octopath.Bench.Speculation), so they all measure the same skills and stats. Each benchmark only adjusts
+ * what it is about (a boss, the turn order, varied health).
+ */
+namespace EnemyBenchFixture
+{
+	/**
+	 * Creates transient skills covering every scored consideration: single, multiple, area and random damage
+	 * alternating physical and magical, a self heal every fifth skill and an ally buff the skill after it.
+	 */
+	TArray<USkillData*> MakeSkills(int32 NumSkills);
+
+	/** MakeSkills copied for the searches running off the game thread. */
+	TArray<FUtilitySkill> MakeUtilitySkills(int32 NumSkills);
+
+	/**
+	 * Fills a snapshot with the player in slot 0 followed by enemies: full health, the same attack and defense,
+	 * speed decreasing with the slot, turns in slot order and a fixed random seed.
+	 */
+	void MakeSnapshot(int32 NumCombatants, FCombatSnapshot& OutSnapshot);
+}
+
+#endif // !UE_BUILD_SHIPPING
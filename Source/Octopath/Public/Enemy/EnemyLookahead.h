@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/CombatSnapshot.h"
+#include "Enemy/EnemyUtilityAI.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+class UEnemyAIProfile;
+
+/** Inputs of one lookahead search, copied on the game thread so the workers never touch a UObject */
+struct FLookaheadRequest
+{
+	/** State of the combat when the searcher's turn begins */
+	FCombatSnapshot Root;
+
+	/** Slot of the planning combatant in Root */
+	int32 SearcherSlot = INDEX_NONE;
+
+	/** Skills of every slot, in the order of their ability component (indices match FEnemyAction::SkillIndex) */
+	TArray<TArray<FUtilitySkill>> Skills;
+
+	/** Damage constants of every slot */
+	TArray<FDamageTunables> Tunables;
+
+	/** Profile of every slot, predicting the other combatants' actions (null: the default profile; kept alive by Start) */
+	TArray<const UEnemyAIProfile*> Profiles;
+
+	/** Maximum number of actions searched ahead */
+	int32 MaxDepth = 4;
+
+	/** Wall clock budget in seconds, counted from the moment the search is started */
+	double BudgetSeconds = 0.005;
+};
+
+/** Outcome of a lookahead search */
+struct FLookaheadResult
+{
+	/** Best action of the deepest completed iteration (Score: expected value of the resulting state) */
+	FEnemyAction Action;
+
+	/** Deepest fully searched depth; 0 when not even one action could be evaluated in time */
+	int32 CompletedDepth = 0;
+
+	int32 NumNodes = 0;
+
+	double ElapsedSeconds = 0.0;
+};
+
+/**
+ * FEnemyLookahead
+ *
+ * Expectimax search over FCombatSnapshot copies for boss enemies:
+ * - max nodes: the searcher's own actions (default attack and every affordable skill and target)
+ * - chance nodes: the damage variance (both ends and the middle of the tunables' range) and random targets
+ * - the other combatants act on the cheap utility policy (FEnemyUtilityAI) with their own profile, so they are not branched on
+ * Turns follow the live rules: the rest of the round acts by decreasing Speed, stunned and broken combatants
+ * lose their turn, and modifiers, breaks and status effects tick at the end of each round.
+ *
+ * The search deepens iteratively and spreads the root actions over worker threads. It stops at the deadline
+ * and keeps the result of the last complete depth. Start never blocks, and TryGetResult never waits.
+ */
+class OCTOPATH_API FEnemyLookahead
+{
+public:
+	/** Runs a search on the calling thread (the root actions are spread over worker threads). */
+	static FLookaheadResult Search(const FLookaheadRequest& Request, double Deadline);
+
+	/** Starts a search on a background task, dropping any pending one. */
+	void Start(FLookaheadRequest&& Request);
+
+	/** Returns true and the result once the pending search is finished; never waits. */
+	bool TryGetResult(FLookaheadResult& OutResult) const;
+
+	bool IsRunning() const { return State.IsValid() && !State->bDone.load(std::memory_order_acquire); }
+
+	/** Forgets the pending search (a running task finishes in the background and its result is dropped). */
+	void Reset() { State.Reset(); }
+
+private:
+	struct FSharedState
+	{
+		FLookaheadRequest Request;
+		FLookaheadResult Result;
+		double Deadline = 0.0;
+		std::atomic<bool> bDone = false;
+
+		/** Request.Profiles, referenced until the task drops the state (their curves are read off the game thread) */
+		TArray<TStrongObjectPtr<const UObject>> ProfileReferences;
+	};
+
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> State;
+};
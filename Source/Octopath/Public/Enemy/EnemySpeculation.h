@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/CombatSnapshot.h"
+#include "Enemy/EnemyLookahead.h"
+#include "UObject/StrongObjectPtr.h"
+#include <atomic>
+
+class UEnemyAIProfile;
+
+/** One action the player may confirm on their turn */
+struct FSpeculatedPlayerAction
+{
+	enum class EType : uint8
+	{
+		DefaultAttack,
+		Skill,
+		Defend
+	};
+
+	EType Type = EType::Defend;
+
+	/** Index in the player's skill list (Skill only) */
+	int32 SkillIndex = INDEX_NONE;
+
+	/** Slot of the chosen target; INDEX_NONE for skills hitting every default target or a random one */
+	int32 TargetSlot = INDEX_NONE;
+};
+
+/** Inputs of a speculation, copied on the game thread when the player's turn begins (no UObject access on the workers) */
+struct FSpeculationRequest
+{
+	/** State of the combat when the player's turn begins */
+	FCombatSnapshot Root;
+
+	/** Slot of the player in Root */
+	int32 PlayerSlot = INDEX_NONE;
+
+	/** Damage type of the player's default attack (UStatComponent::BasicAttackDamageTypeMask) */
+	int32 PlayerBasicAttackDamageTypeMask = 0;
+
+	/** Skills of every slot, in the order of their ability component (see FLookaheadRequest::Skills) */
+	TArray<TArray<FUtilitySkill>> Skills;
+
+	/** Damage constants of every slot */
+	TArray<FDamageTunables> Tunables;
+
+	/** Profile of every enemy able to choose a skill, null for the other slots (kept alive by Start) */
+	TArray<const UEnemyAIProfile*> Profiles;
+};
+
+/** Decision of the enemy acting right after one player action */
+struct FSpeculatedDecision
+{
+	/** Predicted state when the enemy's turn begins, in the slot order CaptureSnapshot will produce then */
+	FCombatSnapshot State;
+
+	/** Slot in FSpeculationRequest::Root of each slot of State */
+	int8 RootSlots[FCombatSnapshot::MaxCombatants];
+
+	/** Slot of the enemy in State */
+	int32 EnemySlot = INDEX_NONE;
+
+	/** Utility choice (same FEnemyUtilityAI::Decide call as the live turn) */
+	FEnemyAction Action;
+
+	/** Lookahead of a boss over State (CompletedDepth is 0 for other enemies) */
+	FLookaheadResult Lookahead;
+};
+
+/**
+ * FEnemySpeculation
+ *
+ * Decides the next enemy's action while the player is still choosing theirs. Every action the player may
+ * confirm (default attack on each opponent, each affordable skill on each valid target, defense) is one
+ * branch on a background task: the action is applied to a copy of the combat with the live rules and rolls
+ * (FSkillProgram::Simulate, the combat random stream stored in the snapshot), the turn queue is advanced as
+ * NextTurn does, and the enemy acting next decides on the resulting state.
+ *
+ * When the enemy's turn begins, the live capture is compared with the predicted states. A decision is only
+ * used when its state is bit-identical to the live one, so it is the decision the enemy would have made:
+ * speculation changes when the work is done, never its outcome. Unfinished or mismatching branches are ignored.
+ *
+ * Only the first enemy after the player is speculated: past it, every branch would fork again on that enemy's
+ * own rolls. A player action that ends the round is not speculated either (EndRound also spawns and removes actors).
+ */
+class OCTOPATH_API FEnemySpeculation
+{
+public:
+	/** Lists the actions the player may confirm from the request's root state. */
+	static void EnumeratePlayerActions(const FSpeculationRequest& Request, TArray<FSpeculatedPlayerAction>& OutActions);
+
+	/**
+	 * Applies a player action to a copy of the root state and advances the turn queue.
+	 * @return false when the next combatant to act is not an enemy able to choose, or when the round ends first.
+	 */
+	static bool PredictEnemyTurn(const FSpeculationRequest& Request, const FSpeculatedPlayerAction& Action, FSpeculatedDecision& OutDecision);
+
+	/** Predicts the enemy's turn and decides its action on the calling thread. */
+	static bool Speculate(const FSpeculationRequest& Request, const FSpeculatedPlayerAction& Action, FSpeculatedDecision& OutDecision);
+
+	/** Launches one background task per player action, dropping any pending speculation. */
+	void Start(FSpeculationRequest&& Request);
+
+	/**
+	 * Returns the finished branch whose predicted state is identical to the live one; never waits.
+	 * @param LiveState - Capture at the start of the enemy's turn.
+	 * @param LiveRootSlots - Slot in the request's root of each slot of LiveState (INDEX_NONE when unknown to it).
+	 */
+	bool TryGetDecision(const FCombatSnapshot& LiveState, TConstArrayView<int32> LiveRootSlots, FSpeculatedDecision& OutDecision) const;
+
+	bool IsActive() const { return State.IsValid(); }
+
+	/** Forgets the pending speculation (branches not started yet are skipped, running ones finish in the background). */
+	void Reset();
+
+private:
+	struct FBranch
+	{
+		FSpeculatedPlayerAction Action;
+		FSpeculatedDecision Decision;
+		bool bHasDecision = false;
+		std::atomic<bool> bDone = false;
+	};
+
+	struct FSharedState
+	{
+		FSpeculationRequest Request;
+		TArray<TUniquePtr<FBranch>> Branches;
+		std::atomic<bool> bCancelled = false;
+
+		/** Request.Profiles, referenced until the last branch drops the state (their curves are read off the game thread) */
+		TArray<TStrongObjectPtr<const UObject>> ProfileReferences;
+	};
+
+	TSharedPtr<FSharedState, ESPMode::ThreadSafe> State;
+};
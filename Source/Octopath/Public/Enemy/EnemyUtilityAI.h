@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/DamagePipeline.h"
+#include "Manager/SkillData.h"
+
+struct FCombatSnapshot;
+struct FCombatantSnapshot;
+class UEnemyAIProfile;
+
+/** One action chosen by the enemy AI */
+struct FEnemyAction
+{
+	/** Index in the caster's skill list, INDEX_NONE for the default attack */
+	int32 SkillIndex = INDEX_NONE;
+
+	/** Snapshot slot of the target; INDEX_NONE when the skill hits every valid target or a random one */
+	int32 TargetSlot = INDEX_NONE;
+
+	/** Utility of the action (see UEnemyAIProfile) */
+	float Score = 0.f;
+
+	bool IsDefaultAttack() const { return SkillIndex == INDEX_NONE; }
+};
+
+/** Copy of the skill fields the AI reads, for searches running off the game thread (no UObject access) */
+struct FUtilitySkill
+{
+	FUtilitySkill() = default;
+
+	explicit FUtilitySkill(const USkillData& Skill)
+		: Program(Skill.GetProgram())
+		, TechniqueCost(Skill.TechniqueCost)
+		, TargetType(Skill.TargetType)
+		, AbilityCategory(Skill.AbilityCategory)
+		, TargetMode(Skill.TargetMode)
+	{
+	}
+
+	const FSkillProgram& GetProgram() const { return Program; }
+
+	FSkillProgram Program;
+	float TechniqueCost = 0.f;
+	ETargetType TargetType = ETargetType::Enemy;
+	EAbilityCategory AbilityCategory = EAbilityCategory::Offensive;
+	ETargetMode TargetMode = ETargetMode::Single;
+};
+
+/**
+ * FEnemyUtilityAI
+ *
+ * Utility scoring of enemy actions. Every affordable (skill, target) pair and the default attack on every
+ * opponent are scored from an FCombatSnapshot with the profile's response curves, and the best one wins.
+ * Scoring reads only snapshot data (one flat struct per combatant, no component lookups) and previews damage
+ * and healing with FSkillProgram::Preview, so it is safe to run on copies (lookahead, speculation).
+ *
+ * Sides follow the snapshot: combatants with bIsPlayer are the player's team, everything else is hostile.
+ */
+struct OCTOPATH_API FEnemyUtilityAI
+{
+	using FMask = uint64;
+
+	/**
+	 * Returns the best action of the combatant in CasterSlot.
+	 * @param Skills - The caster's skill list (UEnemyAbilityComponent::Skills).
+	 * @param Profile - Response curves; the class defaults are used when null.
+	 */
+	static FEnemyAction Decide(const FCombatSnapshot& Snapshot, int32 CasterSlot, TConstArrayView<USkillData*> Skills, const UEnemyAIProfile* Profile, const FDamageTunables& Tunables);
+
+	/** Same as above on copied skills (safe on worker threads as long as Profile outlives the call). */
+	static FEnemyAction Decide(const FCombatSnapshot& Snapshot, int32 CasterSlot, TConstArrayView<FUtilitySkill> Skills, const UEnemyAIProfile* Profile, const FDamageTunables& Tunables);
+
+	/** Returns the slots a skill of the given kind may target from CasterSlot (same rules as FCombatTargetCache). */
+	static FMask GetValidTargets(const FCombatSnapshot& Snapshot, int32 CasterSlot, ETargetType TargetType, EAbilityCategory Category);
+
+	/** Returns the living opponents of CasterSlot. */
+	static FMask GetOpponents(const FCombatSnapshot& Snapshot, int32 CasterSlot);
+
+	/** Scores one skill on one target. */
+	static float ScoreSkill(const FSkillProgram& Program, const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const UEnemyAIProfile& Profile, const FDamageTunables& Tunables);
+
+	/** Scores the default attack on one target. */
+	static float ScoreDefaultAttack(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const UEnemyAIProfile& Profile, const FDamageTunables& Tunables);
+
+	/** Damage of the default attack before the target's defending and break multipliers (FCombatantSnapshot::ApplyDamage applies them). */
+	static float DefaultAttackDamage(const FCombatantSnapshot& Caster, const FCombatantSnapshot& Target, const FDamageTunables& Tunables);
+};
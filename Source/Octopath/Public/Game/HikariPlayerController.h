@@ -8,6 +8,9 @@
 class UInputMappingContext;
 class UInputAction;
 
+/** Direction of a target cycling step: +1 for the next target on screen, -1 for the previous one */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCombatTargetCycle, int32 /*Direction*/);
+
 /**
  * AHikariPlayerController
  *
@@ -15,6 +18,8 @@ class UInputAction;
  * - In the base level, it uses GameOnly mode (no mouse cursor).
  * - During combat, calling EnableCombatInputMode() switches to GameAndUI mode,
  *   shows the mouse cursor, and enables UI interaction.
+ * - The combat mapping context's menu, confirm and cancel actions are forwarded to C++ listeners
+ *   (UTurnBasedCombatComponent uses them for keyboard and gamepad target selection).
  */
 UCLASS()
 class OCTOPATH_API AHikariPlayerController : public APlayerController
@@ -32,10 +37,14 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
 	UInputMappingContext* DefaultMappingContext;
 
-	/** Enhanced Input mapping context for combat (assign in editor). */
+	/** Enhanced Input mapping context for combat (defaults to IMC_Combat). */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
 	UInputMappingContext* CombatMappingContext;
 
+	/** Keyboard bindings of the combat actions, built at runtime and active alongside CombatMappingContext. */
+	UPROPERTY(Transient)
+	UInputMappingContext* CombatKeyboardMappingContext;
+
 	/** Input action for moving (assign in editor). */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
 	UInputAction* MoveAction;
@@ -44,7 +53,22 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
 	UInputAction* LookAction;
 
+	/** Combat input action cycling through targets (defaults to IA_MoveMenu: right or up steps forward, left or down backward). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input|Combat")
+	UInputAction* MoveMenuAction;
+
+	/** Combat input action confirming the selected target (defaults to IA_Interact). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input|Combat")
+	UInputAction* ConfirmAction;
+
+	/** Combat input action leaving target selection (defaults to IA_Cancel). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input|Combat")
+	UInputAction* CancelAction;
+
 	// Protected functions
+	/** Builds CombatKeyboardMappingContext: arrows and WASD cycle, Enter and Space confirm, Escape and Backspace cancel. */
+	void BuildCombatKeyboardMappings();
+
 	/** Handles movement input. */
 	UFUNCTION()
 	void HandleMove(const struct FInputActionValue& Value);
@@ -53,6 +77,15 @@ protected:
 	UFUNCTION()
 	void HandleLook(const FInputActionValue& Value);
 
+	/** Broadcasts OnCycleTarget with the direction of the menu input. */
+	void HandleMoveMenu(const FInputActionValue& Value);
+
+	/** Broadcasts OnConfirmTarget. */
+	void HandleConfirm();
+
+	/** Broadcasts OnCancelTarget. */
+	void HandleCancel();
+
 public:
 	// Public functions
 	/**
@@ -66,4 +99,14 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Input")
 	void DisableCombatInputMode();
+
+	// --- Native delegates (C++ listeners) ---
+	/** Fired when the menu action is pressed with the direction of the step. */
+	FOnCombatTargetCycle OnCycleTarget;
+
+	/** Fired when the confirm action is pressed. */
+	FSimpleMulticastDelegate OnConfirmTarget;
+
+	/** Fired when the cancel action is pressed. */
+	FSimpleMulticastDelegate OnCancelTarget;
 };
\ No newline at end of file
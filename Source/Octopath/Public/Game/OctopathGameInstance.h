@@ -4,11 +4,17 @@
 #include "Engine/GameInstance.h"
 #include "OctopathGameInstance.generated.h"
 
+struct FStreamableHandle;
+
+/** Fired when every skill bundle requested by PreloadCombatSkills has finished loading */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSkillPreloadCompleted);
+
 /**
  * UOctopathGameInstance
  *
  * This custom Game Instance class for Octopath stores global game data.
  * For example, it holds the number of enemies to spawn during combat.
+ * It also owns the asynchronous preloads of the skills' "Cast" bundle, which survive the level transition into combat.
  */
 UCLASS()
 class OCTOPATH_API UOctopathGameInstance : public UGameInstance
@@ -27,9 +33,41 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game Data")
 	void ResetGameData();
 
+	/**
+	 * Starts loading, asynchronously, the "Cast" bundle of every skill of the given actors (ally and enemy ability components).
+	 * Can be called several times (party during the level transition, enemies once spawned): progress covers all requests.
+	 *
+	 * @param Combatants - Actors whose skills will be cast during the next combat.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Skills")
+	void PreloadCombatSkills(const TArray<AActor*>& Combatants);
+
+	/** Releases the preloaded bundles (they stay in memory only while something else references them). */
+	UFUNCTION(BlueprintCallable, Category = "Skills")
+	void ReleaseSkillPreloads();
+
+	/** Returns the progress of the pending skill preloads, from 0 to 1 (1 when nothing is pending). */
+	UFUNCTION(BlueprintPure, Category = "Skills")
+	float GetSkillPreloadProgress() const;
+
+	/** Returns true when every requested skill bundle is loaded. */
+	UFUNCTION(BlueprintPure, Category = "Skills")
+	bool IsSkillPreloadComplete() const;
+
 public:
 	// Public variables
 	/** Number of enemies to spawn in the combat phase (set by the EnemyTrigger) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Combat")
 	int32 NumberOfEnemies;
+
+	/** Fired when the pending skill preloads complete */
+	UPROPERTY(BlueprintAssignable, Category = "Skills")
+	FOnSkillPreloadCompleted OnSkillPreloadCompleted;
+
+private:
+	/** Called by each preload handle when it completes */
+	void HandleSkillPreloadLoaded();
+
+	/** One handle per PreloadCombatSkills call (keeps the bundles loaded) */
+	TArray<TSharedPtr<FStreamableHandle>> SkillPreloadHandles;
 };
@@ -27,6 +27,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat Setup")
 	void SetupCombat();
 
+	/**
+	 * Respawns an enemy spawned by SetupCombat at its original location if it has been destroyed (used when retrying a battle).
+	 *
+	 * @param EnemyIndex Index of the enemy in the spawn order.
+	 * @return The live enemy actor for this index, or nullptr if the index is invalid or the spawn failed.
+	 */
+	AActor* RespawnEnemy(int32 EnemyIndex);
+
+	/** Returns the enemies spawned by SetupCombat, in spawn order (destroyed enemies are left as stale entries until respawned) */
+	const TArray<AActor*>& GetSpawnedEnemies() const { return SpawnedEnemies; }
+
 public:
 	// Public variables
 
@@ -71,7 +82,29 @@ public:
 	FVector FixedFocusPoint;
 
 private:
+	// Private variables
+	/** Enemies spawned by SetupCombat, in spawn order */
+	UPROPERTY()
+	TArray<AActor*> SpawnedEnemies;
+
+	/** Spawn transform of each enemy, kept so defeated enemies can be respawned in place */
+	TArray<FTransform> EnemySpawnTransforms;
+
 	// Private functions
+	/**
+	 * Spawns the enemies along an arc in front of the player spawn.
+	 *
+	 * @param SpawnPositions The computed enemy spawn positions.
+	 */
+	void SpawnEnemies(const TArray<FVector>& SpawnPositions);
+
+	/**
+	 * Spawns the fixed combat camera and blends the player's view to it.
+	 *
+	 * @param SpawnPositions The enemy spawn positions, used for the dynamic focus point.
+	 */
+	void SetupCombatCamera(const TArray<FVector>& SpawnPositions);
+
 	/**
 	 * Helper function to compute enemy spawn positions along an arc in front of the player.
 	 *
@@ -2,8 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Combat/SkillProgram.h"
 #include "SkillData.generated.h"
 
+class UAnimMontage;
+class UNiagaraSystem;
+class UTexture2D;
+
 UENUM(BlueprintType)
 enum class EAttackType : uint8
 {
@@ -57,6 +62,46 @@ enum class EModifierType : uint8
     Flat          UMETA(DisplayName = "Flat")
 };
 
+/** Status effects acting every round (processed in batch by UStatusEffectSubsystem) */
+UENUM(BlueprintType)
+enum class EStatusEffectType : uint8
+{
+    None        UMETA(DisplayName = "None"),
+    Poison      UMETA(DisplayName = "Poison"),
+    Regen       UMETA(DisplayName = "Regen"),
+    Stun        UMETA(DisplayName = "Stun"),
+    Silence     UMETA(DisplayName = "Silence"),
+
+    Count       UMETA(Hidden)
+};
+
+/**
+ * Weapon and element types used by the weakness / shield break system.
+ * Values are bit indices: skills and combatants store sets of types as int32 masks (see MakeDamageTypeMask).
+ */
+UENUM(BlueprintType, meta = (Bitflags))
+enum class EDamageType : uint8
+{
+    Sword       UMETA(DisplayName = "Sword"),
+    Polearm     UMETA(DisplayName = "Polearm"),
+    Dagger      UMETA(DisplayName = "Dagger"),
+    Axe         UMETA(DisplayName = "Axe"),
+    Bow         UMETA(DisplayName = "Bow"),
+    Staff       UMETA(DisplayName = "Staff"),
+    Fire        UMETA(DisplayName = "Fire"),
+    Ice         UMETA(DisplayName = "Ice"),
+    Lightning   UMETA(DisplayName = "Lightning"),
+    Wind        UMETA(DisplayName = "Wind"),
+    Light       UMETA(DisplayName = "Light"),
+    Dark        UMETA(DisplayName = "Dark")
+};
+
+/** Returns the mask bit of a damage type */
+constexpr int32 MakeDamageTypeMask(EDamageType Type)
+{
+    return 1 << static_cast<int32>(Type);
+}
+
 /**
  * USkillData
  *
@@ -69,13 +114,53 @@ enum class EModifierType : uint8
  * - Targeting mode (Single, Multiple, Random)
  * - Allowed target type (Ally, Enemy, Self)
  * - Ability category (Offensive, Defensive, Buff, Debuff, Heal, etc.)
+ * - An optional status effect (Poison, Regen, Stun, Silence) applied to each target
+ * - The weapon / element types it deals, checked against each target's weaknesses
+ * - Optional damage and heal formulas written as expressions
+ *
+ * The properties are compiled into a flat FSkillProgram when the asset is loaded or edited.
+ *
+ * Skills are primary assets of type "Skill" (see DefaultGame.ini). Presentation assets are soft references
+ * grouped in bundles: "Menu" for what the abilities menu shows, "Cast" for what casting plays. Bundles are
+ * loaded asynchronously ahead of combat (see UOctopathGameInstance::PreloadCombatSkills).
  */
 UCLASS(BlueprintType)
-class OCTOPATH_API USkillData : public UDataAsset
+class OCTOPATH_API USkillData : public UPrimaryDataAsset
 {
     GENERATED_BODY()
 
 public:
+    /** Primary asset type of every skill */
+    static const FPrimaryAssetType PrimaryAssetType;
+
+    /** Bundle of the assets shown by the abilities menu */
+    static const FName MenuBundle;
+
+    /** Bundle of the assets played when the skill is cast */
+    static const FName CastBundle;
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    /** Rebuilds the compiled program (call after changing the properties at runtime). */
+    void CompileProgram();
+
+    /**
+     * Returns the operations executed when the skill is cast: the program compiled from the cooked skill table
+     * when it holds an up-to-date record of this skill (see USkillTableSubsystem), the asset's own program otherwise.
+     * Every consumer (casting, previews, the enemy AI) reads the program through here.
+     */
+    const FSkillProgram& GetProgram() const;
+
+    /** Returns the id of this skill in the cooked skill table (see FCookedSkillTable). */
+    uint32 GetSkillId() const;
+
+    /** Returns the hash of the fields stored in the cooked skill table (see FCookedSkillTable::MakeContentHash). */
+    uint32 GetContentHash() const { return ContentHash; }
+
     /** Name of the skill */
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill")
     FText SkillName;
@@ -125,4 +210,58 @@ public:
     // Duration in number of turns
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Modifier", meta = (ClampMin = "0"))
     int32 Duration;
+
+    // --- Status Effect ---
+    /** Status effect applied to each target (None for no effect) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Status Effect")
+    EStatusEffectType StatusEffect = EStatusEffectType::None;
+
+    /** Damage (Poison) or healing (Regen) per round; unused by Stun and Silence */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Status Effect", meta = (ClampMin = "0.0"))
+    float StatusEffectMagnitude = 0.f;
+
+    /** Duration of the status effect in rounds */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Status Effect", meta = (ClampMin = "0"))
+    int32 StatusEffectDuration = 0;
+
+    // --- Break ---
+    /** Weapon and element types dealt by the skill, checked against each target's weaknesses */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Break", meta = (Bitmask, BitmaskEnum = "/Script/Octopath.EDamageType"))
+    int32 DamageTypeMask = 0;
+
+    /** Shield points removed from each target hit on a weakness */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Break", meta = (ClampMin = "0"))
+    int32 ShieldDamage = 1;
+
+    // --- Presentation ---
+    /** Icon shown by the abilities menu (streamed in when the menu opens) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Presentation", meta = (AssetBundles = "Menu"))
+    TSoftObjectPtr<UTexture2D> Icon;
+
+    /** Montage played by the caster while casting (loaded with the "Cast" bundle, never synchronously) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Presentation", meta = (AssetBundles = "Cast"))
+    TSoftObjectPtr<UAnimMontage> CastMontage;
+
+    /** Effect spawned on the caster while casting (loaded with the "Cast" bundle, prefetched when the skill is hovered) */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Presentation", meta = (AssetBundles = "Cast"))
+    TSoftObjectPtr<UNiagaraSystem> CastEffect;
+
+    // --- Formula ---
+    /**
+     * Optional damage formula replacing the built-in one for Offensive skills, evaluated per target.
+     * e.g. "(Skill.Damage + Caster.MagicalAttack - Target.MagicalDefense * 0.5) * Variance" (see FCompiledFormula).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Formula")
+    FString DamageFormula;
+
+    /** Optional heal formula replacing Damage for Heal skills, evaluated per target (e.g. "Skill.Damage + Caster.MagicalAttack * 0.5") */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Skill|Formula")
+    FString HealFormula;
+
+private:
+    /** Operations compiled from the properties above */
+    FSkillProgram Program;
+
+    /** Content hash of the properties above, refreshed with the program */
+    uint32 ContentHash = 0;
 };
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Manager/StatComponent.h"
+#include "StatBroadcastBenchmark.generated.h"
+
+/**
+ * UStatBroadcastBenchmarkListener
+ *
+ * Listener used by the "Octopath.Bench.StatBroadcast" console command.
+ * It exposes the same handler as a UFUNCTION (dynamic delegate) and as a plain
+ * member function (native delegate) so both broadcast paths can be timed side by side.
+ */
+UCLASS(Transient)
+class OCTOPATH_API UStatBroadcastBenchmarkListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Bound to a dynamic delegate (goes through ProcessEvent). */
+	UFUNCTION()
+	void HandleStatChanged();
+
+	/** Bound to the native delegate. */
+	void HandleStatChangedNative(UStatComponent* StatComponent, EStatChannel Channel);
+
+	/** Number of notifications received (keeps the handlers from being optimized away). */
+	int64 CallCount = 0;
+};
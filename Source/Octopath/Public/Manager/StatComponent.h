@@ -3,21 +3,54 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Manager/SkillData.h"
+#include "Combat/DerivedCombatStats.h"
 #include "StatComponent.generated.h"
 
+struct FCombatantSnapshot;
+
+/**
+ * Identifies which stat changed when the native stat delegate fires.
+ * One entry per dynamic delegate declared below.
+ */
+UENUM(BlueprintType)
+enum class EStatChannel : uint8
+{
+	Health              UMETA(DisplayName = "Health"),
+	MaxHealth           UMETA(DisplayName = "Max Health"),
+	TechniquePoints     UMETA(DisplayName = "Technique Points"),
+	MaxTechniquePoints  UMETA(DisplayName = "Max Technique Points"),
+	PhysicalDefense     UMETA(DisplayName = "Physical Defense"),
+	MagicalDefense      UMETA(DisplayName = "Magical Defense"),
+	PhysicalAttack      UMETA(DisplayName = "Physical Attack"),
+	MagicalAttack       UMETA(DisplayName = "Magical Attack"),
+	Speed               UMETA(DisplayName = "Speed"),
+	ShieldPoints        UMETA(DisplayName = "Shield Points")
+};
+
 /**
  * UStatComponent
  *
  * This component manages various stats such as Health, Technique Points, Physical/Magical Defense,
  * Physical/Magical Attack, and Speed.
  *
- * - Health (MaxHealth and Health) is clamped between 0 and 10000 for non-boss characters.
- *   If bIsBoss is true, MaxHealth is not capped at 10000 and can be set to a higher value.
- * - Technique Points, Defense, Speed, and both Attack stats are clamped between 0 and 1000.
+ * - Health (MaxHealth and Health) is clamped between 0 and the balance's NonBossMaxHealth (10000) for non-boss
+ *   characters. If bIsBoss is true, MaxHealth is not capped and can be set to a higher value.
+ * - Technique Points, Defense, Speed, and both Attack stats are clamped between 0 and 1000; the effective
+ *   Defense, Attack and Speed (modifiers included) are capped by the balance's MaxStatValue.
+ * - The cap values and the defending reduction come from the combat balance settings (UCombatBalanceSettings)
+ *   and are picked up again whenever those are reloaded.
+ * - Shield points are removed by hits matching WeaknessMask; at 0 the actor is broken: it loses its turns
+ *   and takes more damage until it recovers its full shield BreakRecoveryRounds rounds later.
  *
  * Attach this component to any actor (player or enemy) to provide consistent stat management.
  */
 
+class UStatComponent;
+
+// Native delegate fired for every stat change, before the Blueprint delegates.
+// C++ listeners (turn queue, AI, telemetry) should bind here: no UFunction lookup or ProcessEvent.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnStatChangedNative, UStatComponent* /*StatComponent*/, EStatChannel /*Channel*/);
+
  // Delegate for when Health changes.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHealthChanged);
 // Delegate for when MaxHealth changes.
@@ -41,6 +74,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMagicalAttackChanged);
 // Delegate for when Speed changes.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSpeedChanged);
 
+// Delegate for when Shield Points change (including break and recovery).
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnShieldPointsChanged);
+
 /**
  * Structure to hold active stat modifiers (buffs or debuffs) applied to a stat.
  */
@@ -74,6 +110,7 @@ class OCTOPATH_API UStatComponent : public UActorComponent
 public:
 	UStatComponent();
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// --- Functions to Modify Stats ---
@@ -103,6 +140,71 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	void Heal(float Amount);
 
+	/**
+	 * Sets the current health, clamped between 0 and MaxHealth (and NonBossMaxHealth for non-boss characters).
+	 * Use this instead of writing Health directly so derived values and previews are refreshed.
+	 *
+	 * @param NewHealth - The new health value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Health")
+	void SetHealth(float NewHealth);
+
+	/**
+	 * Sets the maximum health (capped to NonBossMaxHealth for non-boss characters); Health is clamped to it.
+	 * Use this instead of writing MaxHealth directly so derived values and previews are refreshed.
+	 *
+	 * @param NewMaxHealth - The new maximum health value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Health")
+	void SetMaxHealth(float NewMaxHealth);
+
+	/**
+	 * Sets the current technique points, clamped between 0 and MaxTechniquePoints.
+	 * Use this instead of writing TechniquePoints directly so affordable skills and previews are refreshed.
+	 *
+	 * @param NewTechniquePoints - The new technique points value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Technique")
+	void SetTechniquePoints(float NewTechniquePoints);
+
+	/**
+	 * Sets the maximum technique points, clamped between 0 and 1000; TechniquePoints is clamped to it.
+	 * Use this instead of writing MaxTechniquePoints directly so affordable skills and previews are refreshed.
+	 *
+	 * @param NewMaxTechniquePoints - The new maximum technique points value.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Technique")
+	void SetMaxTechniquePoints(float NewMaxTechniquePoints);
+
+	/**
+	 * Sets the unmodified value of an attack, defense or speed stat and recalculates it with the active modifiers.
+	 * Use this instead of writing the stat directly so modifiers keep applying on top of it and previews are refreshed.
+	 *
+	 * @param CombatStatType - The stat to set (None is ignored).
+	 * @param NewBaseValue - The new base value, clamped between 0 and the balance's MaxStatValue.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+	void SetBaseStat(ECombatStatType CombatStatType, float NewBaseValue);
+
+	/**
+	 * Applies precomputed damage to several actors (e.g. a skill targeting all enemies).
+	 * Every health value is written in one pass, then each actor broadcasts its health change once.
+	 *
+	 * @param Targets - The stat components hit.
+	 * @param Damages - Damage of each target, before its own defending and break scale.
+	 * @param OutHealthLost - Receives the health each target actually lost (same size as Targets).
+	 */
+	static void ApplyDamageBatch(TArrayView<UStatComponent* const> Targets, TArrayView<const float> Damages, TArrayView<float> OutHealthLost);
+
+	/**
+	 * Heals several actors: every health value is written in one pass, then each actor broadcasts once.
+	 *
+	 * @param Targets - The stat components healed.
+	 * @param Amounts - Healing of each target.
+	 * @param OutHealed - Receives the health each target actually recovered (same size as Targets).
+	 */
+	static void HealBatch(TArrayView<UStatComponent* const> Targets, TArrayView<const float> Amounts, TArrayView<float> OutHealed);
+
 	// --- Functions for Buffs and Debuffs ---
 
 	/**
@@ -123,6 +225,122 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 	void DecrementStatModifiers();
 
+	/**
+	 * Applies every modifier carried by a skill: its stat modifier (if AffectedStat is set)
+	 * and its status effect (if StatusEffect is set).
+	 *
+	 * @param Skill - The skill whose modifiers are applied to this actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+	void ApplySkillModifiers(const USkillData* Skill);
+
+	// --- Status Effects ---
+
+	/**
+	 * Applies or refreshes a status effect (stored and processed by UStatusEffectSubsystem).
+	 *
+	 * @param EffectType - The effect to apply.
+	 * @param Magnitude - Damage (Poison) or healing (Regen) per round.
+	 * @param DurationTurns - Duration of the effect in rounds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Status Effects")
+	void ApplyStatusEffect(EStatusEffectType EffectType, float Magnitude, int32 DurationTurns);
+
+	/** Returns true if the given status effect is currently active on this actor. */
+	UFUNCTION(BlueprintPure, Category = "Stats|Status Effects")
+	bool HasStatusEffect(EStatusEffectType EffectType) const;
+
+	// --- Weakness and Break ---
+
+	/** Returns true if any of the given damage types is a weakness of this actor (a single AND of the masks). */
+	UFUNCTION(BlueprintPure, Category = "Stats|Break")
+	bool IsWeakTo(int32 DamageTypeMask) const { return (WeaknessMask & DamageTypeMask) != 0; }
+
+	/** Returns true while the shield is broken. */
+	UFUNCTION(BlueprintPure, Category = "Stats|Break")
+	bool IsBroken() const { return BreakRoundsRemaining > 0; }
+
+	/**
+	 * Removes shield points if the hit matches a weakness, breaking the actor when the shield reaches 0.
+	 *
+	 * @param DamageTypeMask - Weapon and element types of the hit.
+	 * @param ShieldDamage - Shield points removed on a weakness hit.
+	 * @return True if this hit broke the shield.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Break")
+	bool ApplyShieldHit(int32 DamageTypeMask, int32 ShieldDamage = 1);
+
+	/**
+	 * Applies one hit to the shields of several actors in a single pass (e.g. a skill targeting all enemies).
+	 *
+	 * @param Targets - The stat components hit.
+	 * @param DamageTypeMask - Weapon and element types of the hit.
+	 * @param ShieldDamage - Shield points removed on a weakness hit.
+	 * @return The number of actors broken by this hit.
+	 */
+	static int32 ApplyShieldHits(TArrayView<UStatComponent* const> Targets, int32 DamageTypeMask, int32 ShieldDamage);
+
+	/**
+	 * Counts down the break of a broken actor and restores its full shield when it recovers.
+	 * This function should be called at the end of each round.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Break")
+	void ProcessBreakRoundEnd();
+
+	/**
+	 * Sets the defending state and invalidates the derived values that depend on it.
+	 * Use this instead of writing bIsDefending directly.
+	 *
+	 * @param bNewDefending - Whether the actor is defending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Defense")
+	void SetDefending(bool bNewDefending);
+
+	/**
+	 * Overrides the defending damage reduction of this actor (balance reloads no longer change it)
+	 * and invalidates the derived values that depend on it.
+	 *
+	 * @param NewPercentage - Fraction of incoming damage removed while defending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stats|Defense")
+	void SetDefenseReductionPercentage(float NewPercentage);
+
+	// --- Derived Values ---
+
+	/**
+	 * Returns a derived combat value (lazily recomputed only when one of its inputs changed).
+	 *
+	 * @param Stat - The derived value to query.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Stats|Derived")
+	float GetDerivedStat(EDerivedStat Stat) const;
+
+	/** Direct access to the derived value cache, for C++ callers combining two combatants. */
+	const FDerivedCombatStats& GetDerivedStats() const { return DerivedStats; }
+
+	/**
+	 * Returns a counter bumped on every stat, modifier, defending or break change.
+	 * Caches built from this component's stats (e.g. skill previews) compare it to detect staleness.
+	 */
+	uint32 GetStatVersion() const { return StatVersion; }
+
+	/** Upper bound of Health: MaxHealth, capped by the balance's NonBossMaxHealth for non-boss characters. */
+	float GetHealthClampMax() const;
+
+	// --- Snapshots ---
+
+	/**
+	 * Writes the stats, modifiers, defending state and status flags into a flat snapshot.
+	 * Status effect magnitudes are filled by the caller (they live in UStatusEffectSubsystem).
+	 */
+	void CaptureSnapshot(FCombatantSnapshot& OutSnapshot) const;
+
+	/**
+	 * Restores the stats, modifiers and defending state from a snapshot, then broadcasts every stat once.
+	 * Status effects are restored by the caller through UStatusEffectSubsystem.
+	 */
+	void RestoreSnapshot(const FCombatantSnapshot& Snapshot);
+
 protected:
 	/**
 	 * Recalculates the effective value of a given stat based on its base value and active modifiers.
@@ -130,6 +348,15 @@ protected:
 	 */
 	void RecalculateStat(ECombatStatType CombatStatType);
 
+	/**
+	 * Single notify path for stat changes: broadcasts the native delegate, then the matching dynamic delegate.
+	 * @param Channel - The stat that changed.
+	 */
+	void NotifyStatChanged(EStatChannel Channel);
+
+	/** Copies the combat balance values held per component (keeping per-actor overrides) and invalidates everything derived from the old ones. */
+	void RefreshBalance();
+
 protected:
 	// --- Base Stats (for recalculation) ---
 	// These variables store the original stat values.
@@ -143,7 +370,28 @@ protected:
 	UPROPERTY()
 	TArray<FActiveStatModifier> ActiveModifiers;
 
+	// Lazily evaluated derived values (invalidated from NotifyStatChanged and SetDefending)
+	FDerivedCombatStats DerivedStats;
+
+	// One bit per active EStatusEffectType (maintained by UStatusEffectSubsystem)
+	uint8 StatusEffectFlags;
+
+	// Rounds left before a broken actor recovers its shield (0 when not broken)
+	int32 BreakRoundsRemaining;
+
+	// See GetStatVersion
+	uint32 StatVersion = 0;
+
+	// Subscription to FCombatBalance::OnReloaded while playing
+	FDelegateHandle BalanceReloadedHandle;
+
+	friend class UStatusEffectSubsystem;
+
 public:
+	// --- Native delegate (C++ listeners) ---
+	/** Fired for every stat change with the channel that changed. Not exposed to Blueprint. */
+	FOnStatChangedNative OnStatChangedNative;
+
 	// --- Delegates for each stat ---
 	UPROPERTY(BlueprintAssignable, Category = "Stats")
 	FOnHealthChanged OnHealthChanged;
@@ -172,6 +420,9 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Stats")
 	FOnSpeedChanged OnSpeedChanged;
 
+	UPROPERTY(BlueprintAssignable, Category = "Stats")
+	FOnShieldPointsChanged OnShieldPointsChanged;
+
 public:
 	// --- General Stat Properties ---
 	/** Name of the entity (used in the UI) */
@@ -179,55 +430,85 @@ public:
 	FText EntityName;
 
 	// --- Health Stats ---
-	/** Maximum Health Points (capped to 10000 for non-boss characters) */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Health")
+	/** Maximum Health Points (capped to NonBossMaxHealth for non-boss characters); written through SetMaxHealth */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Health")
 	float MaxHealth;
 
-	/** Current Health Points */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Health")
+	/** Current Health Points; written through SetHealth, ApplyDamage or Heal */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Health")
 	float Health;
 
 	// --- Technique Stats ---
-	/** Maximum Technique Points, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Technique", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Maximum Technique Points, clamped between 0 and 1000; written through SetMaxTechniquePoints */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Technique", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float MaxTechniquePoints;
 
-	/** Current Technique Points, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Technique", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Current Technique Points, clamped between 0 and 1000; written through SetTechniquePoints or UseTechniquePoints */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Technique", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float TechniquePoints;
 
 	// --- Defense Stats ---
-	/** Physical Defense, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Defense", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Physical Defense, clamped between 0 and 1000; written through SetBaseStat */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Defense", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float PhysicalDefense;
 
-	/** Magical Defense, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Defense", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Magical Defense, clamped between 0 and 1000; written through SetBaseStat */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Defense", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float MagicalDefense;
 
 	// --- Attack Stats ---
-	/** Physical Attack, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Attack", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Physical Attack, clamped between 0 and 1000; written through SetBaseStat */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Attack", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float PhysicalAttack;
 
-	/** Magical Attack, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Attack", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Magical Attack, clamped between 0 and 1000; written through SetBaseStat */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Attack", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float MagicalAttack;
 
 	// --- Other Stats ---
-	/** Speed, clamped between 0 and 1000 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Other", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
+	/** Speed, clamped between 0 and 1000; written through SetBaseStat */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Other", meta = (ClampMin = "0.0", ClampMax = "1000.0"))
 	float Speed;
 
 	// --- Boss Flag ---
-	/** If true, the actor is considered a boss and MaxHealth is not capped at 10000 */
+	/** If true, the actor is considered a boss and MaxHealth is not capped at NonBossMaxHealth */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
 	bool bIsBoss;
 
 	// --- Additional Defense Variables ---
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Defense")
+	/** Whether the actor is defending; written through SetDefending */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Defense")
 	bool bIsDefending;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Defense")
+	/** Fraction of incoming damage removed while defending; defaults to the combat balance settings and follows their reloads unless changed on this actor (written through SetDefenseReductionPercentage) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats|Defense", meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float DefenseReductionPercentage;
+
+	/** Balance value last copied into DefenseReductionPercentage; a different current value is a per-actor override */
+	float BalanceDefenseReductionPercentage;
+
+	// --- Break ---
+	/** Weapon and element types this actor is weak to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Break", meta = (Bitmask, BitmaskEnum = "/Script/Octopath.EDamageType"))
+	int32 WeaknessMask;
+
+	/** Weapon and element types dealt by this actor's default attack */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Break", meta = (Bitmask, BitmaskEnum = "/Script/Octopath.EDamageType"))
+	int32 BasicAttackDamageTypeMask;
+
+	/** Shield points restored on recovery (0 = this actor cannot be broken) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Break", meta = (ClampMin = "0"))
+	int32 MaxShieldPoints;
+
+	/** Current shield points */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats|Break")
+	int32 ShieldPoints;
+
+	/** Full rounds spent broken after the round of the break (the actor also loses its remaining turn in that round) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Break", meta = (ClampMin = "0"))
+	int32 BreakRecoveryRounds;
+
+	/** Multiplier applied to incoming damage while broken */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats|Break", meta = (ClampMin = "1.0"))
+	float BrokenDamageMultiplier;
 };
\ No newline at end of file
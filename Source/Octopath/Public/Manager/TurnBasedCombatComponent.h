@@ -3,6 +3,16 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Combat/CombatTurnInfo.h"
+#include "Combat/CombatSnapshot.h"
+#include "Combat/SkillHitResult.h"
+#include "Combat/CombatTargetCache.h"
+#include "Combat/ScreenTargetPicker.h"
+#include "Combat/TargetRing.h"
+#include "Widget/IndicatorWidgetPool.h"
+#include "Widget/IndicatorLayer.h"
+#include "Combat/SkillPreview.h"
+#include "Enemy/EnemyLookahead.h"
+#include "Enemy/EnemySpeculation.h"
 #include "TurnBasedCombatComponent.generated.h"
 
 // Forward declarations
@@ -16,6 +26,13 @@ class UUserWidget;
 class UCanvasPanel;
 class UCurveFloat;
 class UTimelineComponent;
+class UStatComponent;
+class UDefeatMenuWidget;
+class UCombatManagerComponent;
+class UEnemyAbilityComponent;
+class AHikariPlayerController;
+class APostProcessVolume;
+enum class EStatChannel : uint8;
 
 /**
  * UTurnBasedCombatComponent
@@ -37,6 +54,7 @@ class OCTOPATH_API UTurnBasedCombatComponent : public UActorComponent
 public:
 	UTurnBasedCombatComponent();
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// -----------------------------------------------------------
@@ -55,6 +73,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void EndRound();
 
+	/**
+	 * Restores the combat to its opening state (stats, enemies, turn order, widgets) from the snapshot taken by StartCombat,
+	 * without reloading the level. Falls back to reloading the original map if no snapshot is available.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void RetryCombat();
+
 	/** Updates the turn order UI */
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void UpdateTurnOrderHUD();
@@ -70,6 +95,17 @@ public:
 	UFUNCTION()
 	void OnAbilitySelected(USkillData* SelectedSkill);
 
+	// Called when an ability is hovered in the abilities menu: shows its preview on every valid target.
+	UFUNCTION()
+	void OnAbilityHovered(USkillData* HoveredSkill);
+
+	/**
+	 * Returns the expected damage / healing of a player skill on a target (cached until a relevant stat changes).
+	 * @return False if the player or the target has no stats.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Combat|Preview")
+	bool GetSkillPreview(USkillData* Skill, AActor* Target, FSkillPreview& OutPreview);
+
 	/** Called when the player presses Defense */
 	UFUNCTION()
 	void OnPlayerDefense();
@@ -86,7 +122,8 @@ public:
 	void SetEntityIndicator(AActor* NewTarget);
 
 	/**
-	 * Updates the enemy indicator widget position on the screen.
+	 * Moves every shown indicator widget above its target, in one batched projection.
+	 * Only the widgets that moved by more than IndicatorPixelThreshold are written.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Combat|Targeting")
 	void UpdateEnemyIndicatorPosition();
@@ -108,6 +145,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void ConfirmAbilityCast();
 
+	/**
+	 * Captures the whole combat (stats, modifiers, status effects, turn queue, defending flags, RNG state)
+	 * into a flat snapshot. Copies of the snapshot can be simulated without touching the live components.
+	 * @param OutSnapshot - Receives the snapshot.
+	 * @param OutActors - Receives the actor of each combatant slot of the snapshot.
+	 */
+	void CaptureSnapshot(FCombatSnapshot& OutSnapshot, TArray<AActor*>& OutActors) const;
+
+	/**
+	 * Writes a snapshot back into the live combat. Does not start a turn.
+	 * @param Snapshot - The snapshot to restore.
+	 * @param Actors - The actors returned by the CaptureSnapshot call that produced the snapshot.
+	 */
+	void RestoreSnapshot(const FCombatSnapshot& Snapshot, const TArray<AActor*>& Actors);
+
+	/**
+	 * Returns the valid targets and affordable skills of every combatant, rebuilt at most once per turn
+	 * (and when a combatant dies or joins).
+	 */
+	const FCombatTargetCache& GetTargetCache();
+
 	// -----------------------------------------------------------
 	// Public Variables
 	// -----------------------------------------------------------
@@ -120,9 +178,25 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Targeting")
 	FVector2D IndicatorScreenOffset = FVector2D(0.0f, 0.0f);
 
-	/** Material to apply as feedback on the selected enemy */
+	/** Indicator widgets are only moved when their projected position changed by more than this many pixels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Targeting", meta = (ClampMin = "0.0"))
+	float IndicatorPixelThreshold = 0.5f;
+
+	/**
+	 * Post-process material drawing the selection highlight: it reads the custom depth stencil and outlines the
+	 * pixels whose stencil is SelectionStencilValue. Added once to the view at BeginPlay.
+	 * When unset (or not a post-process material), DefaultSelectionHighlightMaterialPath is used. If that asset is
+	 * missing too, a surface material set here is swapped onto the selected meshes instead.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Feedback")
-	UMaterialInterface* EntityIndicatorLightFunctionMaterial;
+	UMaterialInterface* SelectionHighlightMaterial;
+
+	/** Outline material built by the SelectionOutline commandlet (scalar parameter StencilValue) */
+	static const TCHAR* DefaultSelectionHighlightMaterialPath;
+
+	/** Custom depth stencil value written by the meshes of the selected combatants */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Feedback", meta = (ClampMin = "1", ClampMax = "255"))
+	int32 SelectionStencilValue = 1;
 
 	// Editor-exposed curves for timeline-based delays.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Timelines")
@@ -135,20 +209,56 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|Timelines")
 	UCurveFloat* AbilityCastingCurve;
 
+	/** Fired once when a player skill resolves, with the outcome on every target (damage numbers, hit VFX) */
+	UPROPERTY(BlueprintAssignable, Category = "Combat|Events")
+	FOnMultiHitResolved OnMultiHitResolved;
+
 	// -----------------------------------------------------------
 	// Private Helper Functions
 	// -----------------------------------------------------------
 private:
-	/** Applies visual feedback (e.g. a flashing material) to the specified enemy */
+	/** Highlights the specified enemy and shows its indicator widget */
 	void ApplyFeedbackToEntity(AActor* Enemy);
 
 	/** Removes visual feedback from the specified enemy */
 	void RemoveFeedbackFromEntity(AActor* Enemy);
 
+	/** Toggles the custom depth stencil of a combatant's meshes; only a change dirties their render state */
+	void SetSelectionHighlight(AActor* Target, bool bHighlighted);
+
 	void UpdateIndicatorWidgetForTarget(AActor* Target, UEnemyIndicatorWidget* IndicatorWidget);
 
-	// Default attack formula : 0.8 * (BaseDamage - (TargetDefense * 0.5))
-	float CalculateDamage(float BaseDamage, float TargetDefense) const;
+	/** Takes a visible indicator widget from IndicatorPool */
+	UEnemyIndicatorWidget* AcquireIndicatorWidget();
+
+	/** Returns CurrentEnemyIndicatorWidget to the pool */
+	void ReleaseEnemyIndicatorWidget();
+
+	/** Returns every widget of MultiTargetIndicatorWidgets to the pool */
+	void ReleaseMultiTargetIndicatorWidgets();
+
+	/** Starts the turn of the combatant at CurrentTurnIndex (player menu, enemy action or skipped turn) */
+	void StartCurrentTurn();
+
+	/** Shows the defeat menu, or returns to the original map if no defeat menu is configured */
+	void OnPlayerDefeated();
+
+	/** Called when the player gives up from the defeat menu */
+	UFUNCTION()
+	void OnDefeatQuit();
+
+	/** Finds the combat manager that spawned the enemies of this battle */
+	UCombatManagerComponent* FindCombatManager() const;
+
+	/** Returns true if the combatant must lose its turn (e.g. stunned) */
+	bool ShouldSkipTurn(AActor* Combatant) const;
+
+	/** Called when a combatant loses its turn: a stunned combatant counts down its stun */
+	void ConsumeSkippedTurn(AActor* Combatant);
+
+	// Default attack formula : BasicAttackScale * (Attacker.PhysicalAttack - (Target.PhysicalDefense * BasicAttackDefenseFactor)),
+	// (DamagePipeline::FBasicAttackMitigation) read from the derived stat caches
+	float CalculateDamage(const UStatComponent& Attacker, const UStatComponent& Target) const;
 
 	// Timeline callback functions for player's default attack.
 	UFUNCTION()
@@ -173,7 +283,11 @@ private:
 
 	// Execution functions (called when timelines finish).
 	void ExecutePlayerDefaultAttack();
-	void ExecuteEnemyDefaultAttack();
+	/** Attacks Target, or the player if it is null (no target was scored) */
+	void ExecuteEnemyDefaultAttack(AActor* Target = nullptr);
+
+	/** Runs the action chosen for the current enemy by ChooseEnemyAction (the default attack when none was chosen) */
+	void ExecuteEnemyAction();
 
 	// -----------------------------------------------------------
 	// Private Variables
@@ -231,10 +345,27 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|UI", meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<UEnemyIndicatorWidget> EnemyIndicatorWidgetClass;
 
-	/** Instance of the enemy indicator widget */
+	/** Instance of the enemy indicator widget (owned by IndicatorPool) */
 	UPROPERTY(meta = (AllowPrivateAccess = "true"))
 	UEnemyIndicatorWidget* CurrentEnemyIndicatorWidget;
 
+	/** Indicator widgets reused by every selection, prewarmed when combat starts */
+	UPROPERTY()
+	FIndicatorWidgetPool IndicatorPool;
+
+	/** Anchors the shown indicator widgets above their targets */
+	FIndicatorLayer IndicatorLayer;
+
+	// --- Defeat Menu ---
+
+	/** Class of the defeat menu widget (derived from UDefeatMenuWidget). If unset, defeat returns to the original map. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat|UI", meta = (AllowPrivateAccess = "true"))
+	TSubclassOf<UDefeatMenuWidget> DefeatMenuWidgetClass;
+
+	/** Instance of the defeat menu widget */
+	UPROPERTY(meta = (AllowPrivateAccess = "true"))
+	UDefeatMenuWidget* DefeatMenuWidget;
+
 	/** Original map name (used for fleeing) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	FName OriginalMapName;
@@ -287,9 +418,17 @@ private:
 	UPROPERTY(meta = (AllowPrivateAccess = "true"))
 	bool bDefenseConsumed;
 
-	// --- Material Feedback ---
-	/** Map to store original materials for selected enemies */
-	UPROPERTY(meta = (AllowPrivateAccess = "true"))
+	// --- Selection Highlight ---
+	/** Unbound volume blending SelectionHighlightMaterial into the view, spawned at BeginPlay */
+	UPROPERTY()
+	APostProcessVolume* SelectionHighlightVolume;
+
+	/** Surface material swapped onto the selected meshes when no outline material could be loaded */
+	UPROPERTY()
+	UMaterialInterface* SelectionFallbackMaterial;
+
+	/** Materials replaced by SelectionFallbackMaterial, restored when the selection moves */
+	UPROPERTY()
 	TMap<AActor*, UMaterialInterface*> OriginalMaterials;
 
 	// --- Ability Target Selection (New) ---
@@ -309,7 +448,7 @@ private:
 	UPROPERTY()
 	TArray<AActor*> DefaultAbilityTargets;
 
-	/** Map storing indicator widgets for each target in multi-target abilities */
+	/** Map storing indicator widgets for each target in multi-target abilities (owned by IndicatorPool) */
 	UPROPERTY()
 	TMap<AActor*, UEnemyIndicatorWidget*> MultiTargetIndicatorWidgets;
 
@@ -323,4 +462,115 @@ private:
 	UTimelineComponent* AbilityCastingTimeline;
 
 	bool bTargetConfirmed = false;
+
+	// --- Retry ---
+	/** Opening state of the combat, captured by StartCombat and restored by RetryCombat */
+	FCombatSnapshot InitialSnapshot;
+
+	/** Actor of each slot of InitialSnapshot (stale for enemies defeated since, until they are respawned) */
+	TArray<TWeakObjectPtr<AActor>> InitialSnapshotActors;
+
+	/** Spawn index in the combat manager of each slot of InitialSnapshot (INDEX_NONE for actors it did not spawn) */
+	TArray<int32> InitialSnapshotEnemyIndices;
+
+	/** Whether InitialSnapshot holds a valid opening state */
+	bool bHasInitialSnapshot = false;
+
+	// --- Targeting ---
+	/** Marks the target cache stale (new turn, combatant list changed) */
+	void InvalidateTargetCache();
+
+	/** Keeps the target cache in sync with deaths and Technique Points spent mid-turn */
+	void HandleCombatantStatChanged(UStatComponent* StatComponent, EStatChannel Channel);
+
+	/** Valid targets per skill kind (see GetTargetCache) */
+	FCombatTargetCache TargetCache;
+
+	/** Stat components whose native stat delegate is bound to HandleCombatantStatChanged */
+	TArray<TWeakObjectPtr<UStatComponent>> TargetCacheBindings;
+
+	/** Combatant under the cursor in both selection modes, from screen rectangles instead of a trace per frame */
+	FScreenTargetPicker TargetPicker;
+
+	/** Targets of the current selection in screen order, for keyboard and gamepad cycling (built on the first step) */
+	FTargetRing TargetRing;
+
+	/** Moves a single-target selection to the next (+1) or previous (-1) valid target on screen */
+	void CycleTarget(int32 Direction);
+
+	/** Confirms the current selection, like clicking the selected target */
+	void ConfirmTargetSelection();
+
+	/** Leaves the current selection (the abilities menu's back button for skills) */
+	void CancelTargetSelection();
+
+	/** Returns true while the ability casting timeline of a confirmed skill is playing */
+	bool IsAbilityCastPlaying() const;
+
+	/** Controller whose combat input delegates are bound to the functions above */
+	TWeakObjectPtr<AHikariPlayerController> InputController;
+
+	FDelegateHandle CycleTargetHandle;
+	FDelegateHandle ConfirmTargetHandle;
+	FDelegateHandle CancelTargetHandle;
+
+	// --- Previews ---
+	/** Formatted preview of a player skill on a target (empty if it neither damages nor heals) */
+	FText GetSkillPreviewText(USkillData* Skill, AActor* Target);
+
+	/** Previews per (skill, caster, target), see GetSkillPreview */
+	FSkillPreviewCache SkillPreviewCache;
+
+	/** Drops the previews and speculated enemy decisions computed with the previous combat balance */
+	void HandleBalanceReloaded();
+
+	/** Subscription to FCombatBalance::OnReloaded while playing */
+	FDelegateHandle BalanceReloadedHandle;
+
+	// --- Enemy AI ---
+	/** Scores the enemy's options on a snapshot of the combat and stores the chosen skill and targets; starts the boss search */
+	void ChooseEnemyAction(AActor* EnemyActor);
+
+	/** Resolves an action chosen on EnemyDecisionSnapshot into PendingEnemySkill and PendingEnemyTargets (the default attack keeps its target) */
+	void SetPendingEnemyAction(const UEnemyAbilityComponent& AbilityComp, const FEnemyAction& Action);
+
+	/** Replaces the pending action with the boss search result if it finished in time */
+	void ApplyEnemyLookaheadResult();
+
+	/** State of the combat the current enemy decided on */
+	FCombatSnapshot EnemyDecisionSnapshot;
+
+	/** Actor of each slot of EnemyDecisionSnapshot */
+	UPROPERTY()
+	TArray<AActor*> EnemyDecisionActors;
+
+	/** Slot of the acting enemy in EnemyDecisionSnapshot */
+	int32 EnemyDecisionSlot = INDEX_NONE;
+
+	/** Background search of the acting boss */
+	FEnemyLookahead EnemyLookahead;
+
+	/** Copies the skills and damage constants of every actor for the background AI tasks (indices match their ability component) */
+	void CopyCombatantSkills(const TArray<AActor*>& Actors, TArray<TArray<FUtilitySkill>>& OutSkills, TArray<FDamageTunables>& OutTunables) const;
+
+	/** Starts deciding the next enemy's action for every action the player may confirm (see FEnemySpeculation) */
+	void StartEnemySpeculation();
+
+	/** Returns the speculated decision made on exactly EnemyDecisionSnapshot, if any, and drops the speculation */
+	bool TakeSpeculatedDecision(FSpeculatedDecision& OutDecision);
+
+	/** Decisions of the next enemy, computed during the player's turn */
+	FEnemySpeculation EnemySpeculation;
+
+	/** Actor of each slot of the speculation's root snapshot */
+	UPROPERTY()
+	TArray<AActor*> SpeculationActors;
+
+	/** Skill chosen for the current enemy turn (null for the default attack) */
+	UPROPERTY()
+	USkillData* PendingEnemySkill = nullptr;
+
+	/** Targets of PendingEnemySkill (every valid target for All and Random skills), or the target scored for the default attack */
+	UPROPERTY()
+	TArray<AActor*> PendingEnemyTargets;
 };
\ No newline at end of file
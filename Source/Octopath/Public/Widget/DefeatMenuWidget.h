@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CommonActivatableWidget.h"
+#include "Widget/MyCommonButton.h"
+#include "DefeatMenuWidget.generated.h"
+
+/**
+ * UDefeatMenuWidget
+ *
+ * A widget shown when the player is defeated, offering to retry the battle or to give up.
+ */
+UCLASS(Blueprintable)
+class OCTOPATH_API UDefeatMenuWidget : public UCommonActivatableWidget
+{
+	GENERATED_BODY()
+
+public:
+	// Public Events
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRetrySelected);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnQuitSelected);
+
+	UPROPERTY(BlueprintAssignable, Category = "Actions")
+	FOnRetrySelected OnRetrySelected;
+
+	UPROPERTY(BlueprintAssignable, Category = "Actions")
+	FOnQuitSelected OnQuitSelected;
+
+public:
+	// Public Variables
+	/** Bindable widget reference for the Retry button (set in UMG Designer) */
+	UPROPERTY(meta = (BindWidget))
+	UMyCommonButton* RetryButton;
+
+	/** Bindable widget reference for the Quit button (set in UMG Designer) */
+	UPROPERTY(meta = (BindWidget))
+	UMyCommonButton* QuitButton;
+
+protected:
+	// Protected Functions
+	/** Overrides the widget construction to bind button events */
+	virtual void NativeConstruct() override;
+
+	/** Handles the event when the Retry button is clicked */
+	UFUNCTION()
+	void HandleRetryClicked(UMyCommonButton* Button);
+
+	/** Handles the event when the Quit button is clicked */
+	UFUNCTION()
+	void HandleQuitClicked(UMyCommonButton* Button);
+};
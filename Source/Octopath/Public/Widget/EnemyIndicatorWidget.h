@@ -29,6 +29,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Enemy Indicator")
 	void SetEnemyName(const FText& NewName);
 
+	/**
+	 * Sets the expected damage / healing of the selected skill on this target.
+	 *
+	 * @param NewPreview - The preview text (empty to hide it).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Enemy Indicator")
+	void SetPreview(const FText& NewPreview);
+
 protected:
 	// Protected variables
 	/** The image representing the white dot indicator. */
@@ -38,4 +46,8 @@ protected:
 	/** The text block that displays the enemy's name. */
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* EnemyNameText;
+
+	/** Optional text block displaying the skill preview. */
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* PreviewText;
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class APlayerController;
+class UEnemyIndicatorWidget;
+
+/**
+ * FIndicatorLayer
+ *
+ * Keeps every shown indicator widget anchored above its target.
+ * Each update projects all anchors in one pass: the view-projection matrix is fetched once, and the anchors are
+ * transformed four at a time with SIMD (structure-of-arrays, relative to the view origin for float precision).
+ * A widget is only written when its position moved beyond a pixel threshold, and its name only when its target
+ * changes, so a still camera over still targets costs no widget or Slate invalidation at all.
+ *
+ * The widgets are owned by FIndicatorWidgetPool; the layer only references them.
+ */
+class OCTOPATH_API FIndicatorLayer
+{
+public:
+	/** Anchors a widget above a target (the target's name is set when it differs from the widget's last one). */
+	void Show(UEnemyIndicatorWidget* Widget, AActor* Target);
+
+	/** Stops updating a widget. */
+	void Hide(UEnemyIndicatorWidget* Widget);
+
+	void Reset() { Markers.Reset(); }
+
+	bool IsEmpty() const { return Markers.Num() == 0; }
+
+	/**
+	 * Projects every anchor and moves the widgets whose position changed.
+	 * @param WorldVerticalOffset - Height of the anchor above the target's location.
+	 * @param ScreenOffset - Offset added to the projected position, in viewport pixels.
+	 * @param PixelThreshold - Widgets closer than this to their last position are not written.
+	 * @return The number of widgets moved.
+	 */
+	int32 Update(const APlayerController& PC, float WorldVerticalOffset, const FVector2D& ScreenOffset, float PixelThreshold);
+
+	/**
+	 * Projects the anchor of a single shown widget and moves it there, leaving the other markers to the next Update.
+	 * Used when a widget starts following a new target, so it never shows at its previous position for a frame.
+	 * @return True if the widget was placed (false if it is not shown or its anchor is behind the camera).
+	 */
+	bool Place(const APlayerController& PC, const UEnemyIndicatorWidget* Widget, float WorldVerticalOffset, const FVector2D& ScreenOffset);
+
+	/**
+	 * Projects view-relative points to viewport pixels, four per iteration.
+	 * The arrays hold NumPadded entries (a multiple of 4); OutW <= 0 marks points behind the camera.
+	 */
+	static void ProjectAnchors(const FMatrix44f& RelativeViewProjection, const FIntRect& ViewRect, int32 NumPadded,
+		const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutW);
+
+private:
+	struct FMarker
+	{
+		TWeakObjectPtr<UEnemyIndicatorWidget> Widget;
+		TWeakObjectPtr<AActor> Target;
+
+		/** Position last written to the widget */
+		FVector2D Position = FVector2D::ZeroVector;
+
+		bool bPlaced = false;
+	};
+
+	TArray<FMarker, TInlineAllocator<8>> Markers;
+
+	/** Anchors and projections of one update, six arrays of NumPadded floats */
+	TArray<float> Scratch;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IndicatorWidgetPool.generated.h"
+
+class APlayerController;
+class UEnemyIndicatorWidget;
+
+/**
+ * FIndicatorWidgetPool
+ *
+ * Enemy indicator widgets created once per combat and reused for every selection.
+ * Every widget stays in the viewport: acquiring one makes it visible, releasing it collapses it, so selecting
+ * targets creates no widget (no UObject garbage) and adds or removes nothing from the Slate tree.
+ * The pool only grows when more indicators are shown at once than it was prewarmed for.
+ */
+USTRUCT()
+struct OCTOPATH_API FIndicatorWidgetPool
+{
+	GENERATED_BODY()
+
+	/**
+	 * Creates collapsed widgets in the viewport until the pool holds Count of them.
+	 * @param InOwningPlayer - Player owning the widgets.
+	 * @param InWidgetClass - Class of the widgets (derived from UEnemyIndicatorWidget).
+	 */
+	void Prewarm(APlayerController* InOwningPlayer, TSubclassOf<UEnemyIndicatorWidget> InWidgetClass, int32 Count);
+
+	/** Returns a free widget made visible, or nullptr if the pool was never prewarmed. */
+	UEnemyIndicatorWidget* Acquire();
+
+	/** Collapses a widget returned by Acquire and makes it available again. */
+	void Release(UEnemyIndicatorWidget* Widget);
+
+	/** Removes every widget from the viewport (end of play). */
+	void Empty();
+
+private:
+	UEnemyIndicatorWidget* CreatePooledWidget();
+
+	/** Every widget of the pool */
+	UPROPERTY()
+	TArray<UEnemyIndicatorWidget*> Widgets;
+
+	/** Collapsed widgets ready to be acquired */
+	UPROPERTY()
+	TArray<UEnemyIndicatorWidget*> FreeWidgets;
+
+	TWeakObjectPtr<APlayerController> OwningPlayer;
+
+	UPROPERTY()
+	TSubclassOf<UEnemyIndicatorWidget> WidgetClass;
+};
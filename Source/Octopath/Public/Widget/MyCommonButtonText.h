@@ -5,6 +5,9 @@
 #include "Components/TextBlock.h"
 #include "MyCommonButtonText.generated.h"
 
+class UImage;
+class UTexture2D;
+
 // Declare a dynamic multicast delegate that passes the clicked button as a parameter
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMyCommonButtonTextClicked, UMyCommonButtonText*, Button);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnButtonHovered, UMyCommonButtonText*, Button);
@@ -28,6 +31,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Button")
     void SetButtonText(const FText& InText);
 
+    /** Sets the button's icon (ignored if the button has no ButtonIcon image) */
+    UFUNCTION(BlueprintCallable, Category = "Button")
+    void SetButtonIcon(UTexture2D* InIcon);
+
 public:
     // Dynamic delegate that can be bound via AddDynamic in other classes (such as your menu widget)
     UPROPERTY(BlueprintAssignable, Category = "Common Button")
@@ -42,4 +49,8 @@ public:
 public:
     UPROPERTY(meta = (BindWidget))
     UTextBlock* ButtonTextBlock;
+
+    /** Optional icon shown next to the text */
+    UPROPERTY(meta = (BindWidgetOptional))
+    UImage* ButtonIcon;
 };
@@ -9,6 +9,8 @@
 class UScrollBox;
 class UMyCommonButton;
 class UMyCommonButtonText;
+class UTexture2D;
+struct FStreamableHandle;
 
 /**
  * UPlayerAbilitiesMenuWidget
@@ -23,10 +25,23 @@ class OCTOPATH_API UPlayerAbilitiesMenuWidget : public UCommonActivatableWidget
 
 public:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
 	/** Populates the abilities menu by creating a button for each ability */
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	void PopulateAbilitiesMenu();
 
+	/**
+	 * Requests the icons of the listed skills asynchronously. Buttons show PlaceholderIcon until their icon arrives;
+	 * the icons stay loaded while the menu exists. Does nothing if the icons are already requested.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Abilities")
+	void StreamSkillIcons();
+
+	/** Releases the streamed icons and the prefetched cast assets */
+	UFUNCTION(BlueprintCallable, Category = "Abilities")
+	void ReleaseStreamedAssets();
+
 	/** Handler for when an ability button is clicked */
 	UFUNCTION()
 	void OnAbilityButtonClicked(UMyCommonButtonText* ClickedButton);
@@ -41,6 +56,10 @@ public:
 	UFUNCTION()
 	void OnAbilityButtonUnhovered(UMyCommonButtonText* UnhoveredButton);
 
+	/** Shows the expected damage / healing of the hovered skill in the description widget */
+	UFUNCTION(BlueprintCallable, Category = "Abilities")
+	void SetSkillPreview(const FText& PreviewText);
+
 public:
 
 	/** Delegate to broadcast when an ability is selected */
@@ -48,6 +67,11 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Abilities")
 	FOnAbilitySelected OnAbilitySelected;
 
+	/** Delegate to broadcast when an ability is hovered (after its description is shown) */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAbilityHovered, USkillData*, HoveredSkill);
+	UPROPERTY(BlueprintAssignable, Category = "Abilities")
+	FOnAbilityHovered OnAbilityHovered;
+
 	/** Delegate to broadcast when the Back button is pressed */
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBackPressed);
 	UPROPERTY(BlueprintAssignable, Category = "Abilities")
@@ -59,6 +83,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities")
 	TSubclassOf<UMyCommonButtonText> AbilityButtonClass;
 
+	/** Icon shown by the ability buttons until the skill icon is streamed in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities")
+	UTexture2D* PlaceholderIcon;
+
 	/** Bindable widget reference for the ScrollBox holding ability buttons (set in UMG Designer) */
 	UPROPERTY(meta = (BindWidget))
 	UScrollBox* AbilitiesScrollBox;
@@ -95,4 +123,17 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities|Description Positioning")
 	FVector2D DescriptionAlignment = FVector2D(0.5f, 1.f);
+
+private:
+	/** Starts loading the cast montage and effect of a hovered skill so they are ready if it gets selected */
+	void PrefetchCastAssets(USkillData* Skill);
+
+	/** Handles keeping the streamed icons loaded (one per skill with an icon) */
+	TArray<TSharedPtr<FStreamableHandle>> IconHandles;
+
+	/** Handle keeping the cast assets of the last hovered skill loaded */
+	TSharedPtr<FStreamableHandle> CastPrefetchHandle;
+
+	/** Skill whose cast assets CastPrefetchHandle holds */
+	TWeakObjectPtr<USkillData> PrefetchedSkill;
 };
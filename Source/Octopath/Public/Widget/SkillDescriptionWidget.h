@@ -22,9 +22,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Skill Description")
 	void SetDescription(const FText& InDescription);
 
+	/** Sets the expected damage / healing text (ignored if the widget has no PreviewText). */
+	UFUNCTION(BlueprintCallable, Category = "Skill Description")
+	void SetPreview(const FText& InPreview);
+
 protected:
 	/** Bindable widget reference for the text block displaying the skill description.
 		Make sure this variable is bound to a TextBlock in your UMG designer. */
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* DescriptionText;
+
+	/** Optional text block listing the expected damage / healing on each valid target */
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* PreviewText;
 };
@@ -11,5 +11,6 @@ public class OctopathEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("Octopath");
+		ExtraModuleNames.Add("OctopathEditor");
 	}
 }
@@ -0,0 +1,15 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class OctopathEditor : ModuleRules
+{
+	public OctopathEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "Octopath" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "AssetRegistry", "Json", "RHI", "UnrealEd" });
+	}
+}
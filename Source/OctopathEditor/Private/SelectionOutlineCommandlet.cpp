@@ -0,0 +1,159 @@
+#include "SelectionOutlineCommandlet.h"
+#include "Manager/TurnBasedCombatComponent.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionCustom.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionSceneTexture.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "MaterialShared.h"
+#include "Misc/PackageName.h"
+#include "RHI.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSelectionOutlineCommandlet, Log, All);
+
+namespace SelectionOutline
+{
+	/**
+	 * Outline pass: a pixel outside the selection takes the outline color when one of its eight neighbours,
+	 * Thickness pixels away, carries the selection stencil. 14 is PPI_PostProcessInput0, 25 PPI_CustomStencil.
+	 * Stencil is the float4 color output of the SceneTexture node: the stencil value is in its red channel.
+	 */
+	const TCHAR* OutlineCode = TEXT(R"(
+float2 UV = GetDefaultSceneTextureUV(Parameters, 14);
+float3 SceneColor = SceneTextureLookup(UV, 14, false).rgb;
+if (abs(Stencil.r - StencilValue) < 0.5)
+{
+	return SceneColor;
+}
+float2 Texel = View.BufferSizeAndInvSize.zw * Thickness;
+float Edge = 0;
+for (int X = -1; X <= 1; X++)
+{
+	for (int Y = -1; Y <= 1; Y++)
+	{
+		float Neighbour = SceneTextureLookup(UV + float2(X, Y) * Texel, 25, false).r;
+		Edge = max(Edge, (float)(abs(Neighbour - StencilValue) < 0.5));
+	}
+}
+return lerp(SceneColor, OutlineColor.rgb, Edge);
+)");
+
+	template<typename ExpressionType>
+	ExpressionType* AddExpression(UMaterial& Material, int32 PositionX, int32 PositionY)
+	{
+		ExpressionType* Expression = NewObject<ExpressionType>(&Material);
+		Expression->MaterialExpressionEditorX = PositionX;
+		Expression->MaterialExpressionEditorY = PositionY;
+		Material.GetExpressionCollection().AddExpression(Expression);
+		return Expression;
+	}
+
+	void AddInput(UMaterialExpressionCustom& Custom, const TCHAR* Name, UMaterialExpression* Expression)
+	{
+		FCustomInput& Input = Custom.Inputs.AddDefaulted_GetRef();
+		Input.InputName = Name;
+		Input.Input.Connect(0, Expression);
+	}
+
+	/** Compiles the material's shaders for the running shader platform and logs every error. */
+	bool CompileShaders(UMaterial& Material)
+	{
+		TArray<FMaterialResource*> Resources;
+		Material.CacheResourceShadersForCooking(GMaxRHIShaderPlatform, Resources);
+		bool bCompiled = Resources.Num() > 0;
+		for (FMaterialResource* Resource : Resources)
+		{
+			Resource->FinishCompilation();
+			for (const FString& Error : Resource->GetCompileErrors())
+			{
+				UE_LOG(LogSelectionOutlineCommandlet, Error, TEXT("CompileShaders - %s"), *Error);
+				bCompiled = false;
+			}
+			delete Resource;
+		}
+		return bCompiled;
+	}
+}
+
+USelectionOutlineCommandlet::USelectionOutlineCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USelectionOutlineCommandlet::Main(const FString& Params)
+{
+	using namespace SelectionOutline;
+
+	const FString ObjectPath = UTurnBasedCombatComponent::DefaultSelectionHighlightMaterialPath;
+	const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+	const FString AssetName = FPackageName::ObjectPathToObjectName(ObjectPath);
+
+	UMaterial* Material = LoadObject<UMaterial>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn);
+	if (!Material)
+	{
+		Material = NewObject<UMaterial>(CreatePackage(*PackageName), *AssetName, RF_Public | RF_Standalone);
+		FAssetRegistryModule::AssetCreated(Material);
+	}
+	UPackage* Package = Material->GetPackage();
+
+	// Rebuilt from scratch so the asset always matches this code.
+	Material->PreEditChange(nullptr);
+	Material->GetExpressionCollection().Empty();
+	Material->MaterialDomain = MD_PostProcess;
+	Material->BlendableLocation = BL_SceneColorAfterTonemapping;
+
+	UMaterialExpressionSceneTexture* StencilTexture = AddExpression<UMaterialExpressionSceneTexture>(*Material, -700, -100);
+	StencilTexture->SceneTextureId = PPI_CustomStencil;
+
+	UMaterialExpressionScalarParameter* StencilValue = AddExpression<UMaterialExpressionScalarParameter>(*Material, -700, 50);
+	StencilValue->ParameterName = TEXT("StencilValue");
+	StencilValue->DefaultValue = 1.f;
+
+	UMaterialExpressionScalarParameter* Thickness = AddExpression<UMaterialExpressionScalarParameter>(*Material, -700, 150);
+	Thickness->ParameterName = TEXT("Thickness");
+	Thickness->DefaultValue = 2.f;
+
+	UMaterialExpressionVectorParameter* OutlineColor = AddExpression<UMaterialExpressionVectorParameter>(*Material, -700, 250);
+	OutlineColor->ParameterName = TEXT("OutlineColor");
+	OutlineColor->DefaultValue = FLinearColor(1.f, 0.8f, 0.2f, 1.f);
+
+	UMaterialExpressionCustom* Outline = AddExpression<UMaterialExpressionCustom>(*Material, -300, 0);
+	Outline->Description = TEXT("SelectionOutline");
+	Outline->OutputType = CMOT_Float3;
+	Outline->Code = OutlineCode;
+	Outline->Inputs.Reset();
+	// The center stencil comes from a SceneTexture node, which also makes the custom stencil available to the lookups.
+	AddInput(*Outline, TEXT("Stencil"), StencilTexture);
+	AddInput(*Outline, TEXT("StencilValue"), StencilValue);
+	AddInput(*Outline, TEXT("Thickness"), Thickness);
+	AddInput(*Outline, TEXT("OutlineColor"), OutlineColor);
+
+	Material->GetEditorOnlyData()->EmissiveColor.Connect(0, Outline);
+	Material->PostEditChange();
+
+	// The combat component relies on this asset at runtime, so a material that does not compile is never saved.
+	if (!CompileShaders(*Material))
+	{
+		UE_LOG(LogSelectionOutlineCommandlet, Error, TEXT("Main - %s does not compile, not saved"), *ObjectPath);
+		return 1;
+	}
+	Material->MarkPackageDirty();
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Package, Material, *Filename, SaveArgs))
+	{
+		UE_LOG(LogSelectionOutlineCommandlet, Error, TEXT("Main - Could not save %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogSelectionOutlineCommandlet, Display, TEXT("Main - Saved %s"), *Filename);
+	return 0;
+}
@@ -0,0 +1,585 @@
+#include "SkillSheet.h"
+#include "Manager/SkillData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSkillSheet, Log, All);
+
+const TCHAR* FSkillSheet::DefaultAssetPath = TEXT("/Game/Blueprints/DA");
+
+namespace SkillSheet
+{
+	const TCHAR* NameColumn = TEXT("Name");
+
+	bool IsJson(const FString& Filename)
+	{
+		return FPaths::GetExtension(Filename).Equals(TEXT("json"), ESearchCase::IgnoreCase);
+	}
+
+	/** Editable properties of USkillData in declaration order: the sheet columns after Name. */
+	TArray<FProperty*> GetColumns()
+	{
+		TArray<FProperty*> Columns;
+		for (TFieldIterator<FProperty> It(USkillData::StaticClass(), EFieldIterationFlags::None); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_Edit) && !It->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+			{
+				Columns.Add(*It);
+			}
+		}
+		return Columns;
+	}
+
+	/** Every skill asset of the project, sorted by name. */
+	TArray<FAssetData> FindSkillAssets()
+	{
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+		AssetRegistry.SearchAllAssets(true);
+
+		TArray<FAssetData> SkillAssets;
+		AssetRegistry.GetAssetsByClass(USkillData::StaticClass()->GetClassPathName(), SkillAssets, true);
+		SkillAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.AssetName.LexicalLess(B.AssetName); });
+		return SkillAssets;
+	}
+
+	/** Text of one cell (texts are written as their source string, everything else with its editor text). */
+	FString GetCell(const FProperty* Property, const USkillData& Skill)
+	{
+		if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			return TextProperty->GetPropertyValue_InContainer(&Skill).ToString();
+		}
+		FString Value;
+		Property->ExportText_InContainer(0, Value, &Skill, nullptr, nullptr, PPF_None);
+		return Value;
+	}
+
+	/**
+	 * Writes a cell into a skill if its value differs (compared after parsing, so "120" matches 120.0).
+	 * @return False if the cell could not be parsed.
+	 */
+	bool ApplyCell(FProperty* Property, USkillData& Skill, const FString& Cell, bool& bOutChanged)
+	{
+		if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			if (!TextProperty->GetPropertyValue_InContainer(&Skill).ToString().Equals(Cell, ESearchCase::CaseSensitive))
+			{
+				// Stable key per asset and property, so the text stays gatherable for localization.
+				const FString Key = FString::Printf(TEXT("%s_%s"), *Skill.GetName(), *Property->GetName());
+				TextProperty->SetPropertyValue_InContainer(&Skill, FText::ChangeKey(TEXT("SkillData"), Key, FText::FromString(Cell)));
+				bOutChanged = true;
+			}
+			return true;
+		}
+
+		// An empty cell keeps the current value, except for strings where it means empty.
+		if (Cell.IsEmpty() && !Property->IsA<FStrProperty>())
+		{
+			return true;
+		}
+
+		void* Current = Property->ContainerPtrToValuePtr<void>(&Skill);
+		void* Parsed = Property->AllocateAndInitializeValue();
+		const bool bParsed = Property->ImportText_Direct(*Cell, Parsed, &Skill, PPF_None) != nullptr;
+		if (bParsed && !Property->Identical(Current, Parsed, PPF_None))
+		{
+			Property->CopyCompleteValue(Current, Parsed);
+			bOutChanged = true;
+		}
+		Property->DestroyAndFreeValue(Parsed);
+		return bParsed;
+	}
+
+	/** Applies rows to assets and collects the packages to save. */
+	class FImporter
+	{
+	public:
+		FImporter(const FString& InAssetPath, FSkillSheetImportStats& InStats)
+			: Columns(GetColumns()), AssetPath(InAssetPath), Stats(InStats)
+		{
+			for (const FAssetData& AssetData : FindSkillAssets())
+			{
+				ExistingAssets.Add(AssetData.AssetName, AssetData);
+			}
+			for (int32 i = 0; i < Columns.Num(); i++)
+			{
+				ColumnIndices.Add(Columns[i]->GetName(), i);
+			}
+		}
+
+		/** Column index of a header name (case insensitive), or INDEX_NONE. */
+		int32 FindColumn(const FString& Header) const
+		{
+			const int32* Index = ColumnIndices.Find(Header);
+			return Index ? *Index : INDEX_NONE;
+		}
+
+		int32 NumColumns() const { return Columns.Num(); }
+
+		/**
+		 * Creates or updates one skill.
+		 * @param Cells - One entry per column, nullptr for the columns absent from the row.
+		 */
+		void ImportRow(const FString& Name, TConstArrayView<const FString*> Cells)
+		{
+			Stats.Rows++;
+
+			FText Reason;
+			if (Name.IsEmpty() || !FName::IsValidXName(Name, INVALID_OBJECTNAME_CHARACTERS INVALID_LONGPACKAGE_CHARACTERS, &Reason))
+			{
+				UE_LOG(LogSkillSheet, Warning, TEXT("ImportRow - Row %d: invalid skill name '%s'"), Stats.Rows, *Name);
+				Stats.Errors++;
+				return;
+			}
+
+			USkillData* Skill = nullptr;
+			bool bCreated = false;
+			if (const FAssetData* Existing = ExistingAssets.Find(FName(*Name)))
+			{
+				Skill = Cast<USkillData>(Existing->GetAsset());
+			}
+			else
+			{
+				UPackage* Package = CreatePackage(*(AssetPath / Name));
+				Skill = NewObject<USkillData>(Package, FName(*Name), RF_Public | RF_Standalone | RF_Transactional);
+				IAssetRegistry::GetChecked().AssetCreated(Skill);
+				ExistingAssets.Add(Skill->GetFName(), FAssetData(Skill));
+				bCreated = true;
+			}
+			if (!Skill)
+			{
+				UE_LOG(LogSkillSheet, Warning, TEXT("ImportRow - Row %d: could not load or create %s"), Stats.Rows, *Name);
+				Stats.Errors++;
+				return;
+			}
+
+			bool bChanged = false;
+			bool bRowError = false;
+			for (int32 i = 0; i < Columns.Num(); i++)
+			{
+				if (Cells[i] && !ApplyCell(Columns[i], *Skill, *Cells[i], bChanged))
+				{
+					UE_LOG(LogSkillSheet, Warning, TEXT("ImportRow - Row %d (%s): invalid %s '%s'"), Stats.Rows, *Name, *Columns[i]->GetName(), **Cells[i]);
+					bRowError = true;
+				}
+			}
+			Stats.Errors += bRowError ? 1 : 0;
+
+			if (!bCreated && !bChanged)
+			{
+				Stats.Unchanged++;
+				return;
+			}
+
+			Skill->CompileProgram();
+			Skill->MarkPackageDirty();
+			PackagesToSave.Add(Skill->GetPackage());
+			(bCreated ? Stats.Created : Stats.Updated)++;
+		}
+
+		/** Saves every created or changed package in one pass. */
+		bool SavePackages(FString& OutError)
+		{
+			for (UPackage* Package : PackagesToSave)
+			{
+				const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+				FSavePackageArgs SaveArgs;
+				SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+				SaveArgs.SaveFlags = SAVE_NoError;
+				if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+				{
+					OutError = FString::Printf(TEXT("Could not save %s"), *Filename);
+					return false;
+				}
+			}
+			return true;
+		}
+
+	private:
+		TArray<FProperty*> Columns;
+		TMap<FString, int32> ColumnIndices;
+		TMap<FName, FAssetData> ExistingAssets;
+		TSet<UPackage*> PackagesToSave;
+		FString AssetPath;
+		FSkillSheetImportStats& Stats;
+	};
+
+	/** RFC 4180 reader returning one row at a time (quoted cells may hold commas, quotes and line breaks). */
+	class FCsvRowReader
+	{
+	public:
+		explicit FCsvRowReader(const FString& InText) : Text(InText) {}
+
+		bool ReadRow(TArray<FString>& OutCells)
+		{
+			OutCells.Reset();
+			if (Position >= Text.Len())
+			{
+				return false;
+			}
+
+			FString Cell;
+			bool bQuoted = false;
+			while (Position < Text.Len())
+			{
+				const TCHAR Character = Text[Position++];
+				if (bQuoted)
+				{
+					if (Character != TEXT('"'))
+					{
+						Cell.AppendChar(Character);
+					}
+					else if (Position < Text.Len() && Text[Position] == TEXT('"'))
+					{
+						Cell.AppendChar(TEXT('"'));
+						Position++;
+					}
+					else
+					{
+						bQuoted = false;
+					}
+				}
+				else if (Character == TEXT('"'))
+				{
+					bQuoted = true;
+				}
+				else if (Character == TEXT(','))
+				{
+					OutCells.Add(MoveTemp(Cell));
+					Cell.Reset();
+				}
+				else if (Character == TEXT('\n'))
+				{
+					break;
+				}
+				else if (Character != TEXT('\r'))
+				{
+					Cell.AppendChar(Character);
+				}
+			}
+			OutCells.Add(MoveTemp(Cell));
+			return true;
+		}
+
+	private:
+		const FString& Text;
+		int32 Position = 0;
+	};
+
+	void AppendCsvCell(FString& Output, const FString& Cell)
+	{
+		if (Cell.Contains(TEXT(",")) || Cell.Contains(TEXT("\"")) || Cell.Contains(TEXT("\n")) || Cell.Contains(TEXT("\r")))
+		{
+			Output += TEXT("\"") + Cell.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+		}
+		else
+		{
+			Output += Cell;
+		}
+	}
+
+	bool ImportCsv(const FString& Text, FImporter& Importer, FString& OutError)
+	{
+		FCsvRowReader Reader(Text);
+		TArray<FString> Cells;
+		if (!Reader.ReadRow(Cells))
+		{
+			OutError = TEXT("Empty file");
+			return false;
+		}
+
+		// Map the file's columns to the skill columns once.
+		int32 NameIndex = INDEX_NONE;
+		TArray<int32> FileToColumn;
+		for (int32 FileColumn = 0; FileColumn < Cells.Num(); FileColumn++)
+		{
+			const FString Header = Cells[FileColumn].TrimStartAndEnd();
+			if (Header.Equals(NameColumn, ESearchCase::IgnoreCase))
+			{
+				NameIndex = FileColumn;
+			}
+			const int32 Column = Importer.FindColumn(Header);
+			if (Column == INDEX_NONE && NameIndex != FileColumn)
+			{
+				UE_LOG(LogSkillSheet, Warning, TEXT("ImportCsv - Unknown column '%s' ignored"), *Header);
+			}
+			FileToColumn.Add(Column);
+		}
+		if (NameIndex == INDEX_NONE)
+		{
+			OutError = TEXT("Missing Name column");
+			return false;
+		}
+
+		TArray<const FString*> RowCells;
+		while (Reader.ReadRow(Cells))
+		{
+			if (Cells.Num() == 1 && Cells[0].IsEmpty())
+			{
+				continue;
+			}
+			RowCells.Init(nullptr, Importer.NumColumns());
+			for (int32 FileColumn = 0; FileColumn < FMath::Min(Cells.Num(), FileToColumn.Num()); FileColumn++)
+			{
+				if (FileToColumn[FileColumn] != INDEX_NONE)
+				{
+					RowCells[FileToColumn[FileColumn]] = &Cells[FileColumn];
+				}
+			}
+			Importer.ImportRow(Cells.IsValidIndex(NameIndex) ? Cells[NameIndex].TrimStartAndEnd() : FString(), RowCells);
+		}
+		return true;
+	}
+
+	/** Reads the array of skill objects token by token (no DOM of the whole file). */
+	bool ImportJson(const FString& Text, FImporter& Importer, FString& OutError)
+	{
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(Text);
+
+		TArray<FString> Values;
+		TArray<const FString*> RowCells;
+		FString Name;
+		int32 Depth = 0;
+
+		EJsonNotation Notation;
+		while (Reader->ReadNext(Notation))
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ArrayStart:
+			case EJsonNotation::ObjectStart:
+				Depth++;
+				if (Depth > 2 || (Depth == 2) != (Notation == EJsonNotation::ObjectStart))
+				{
+					OutError = TEXT("Expected an array of flat skill objects");
+					return false;
+				}
+				if (Depth == 2)
+				{
+					Name.Reset();
+					Values.SetNum(Importer.NumColumns());
+					RowCells.Init(nullptr, Importer.NumColumns());
+				}
+				break;
+
+			case EJsonNotation::ObjectEnd:
+				Importer.ImportRow(Name, RowCells);
+				Depth--;
+				break;
+
+			case EJsonNotation::ArrayEnd:
+				Depth--;
+				break;
+
+			case EJsonNotation::String:
+			case EJsonNotation::Number:
+			case EJsonNotation::Boolean:
+			{
+				FString Value;
+				if (Notation == EJsonNotation::String)
+				{
+					Value = Reader->GetValueAsString();
+				}
+				else if (Notation == EJsonNotation::Boolean)
+				{
+					Value = Reader->GetValueAsBoolean() ? TEXT("True") : TEXT("False");
+				}
+				else
+				{
+					const double Number = Reader->GetValueAsNumber();
+					Value = (FMath::Frac(Number) == 0.0) ? FString::Printf(TEXT("%lld"), static_cast<int64>(Number)) : FString::SanitizeFloat(Number);
+				}
+
+				const FString& Identifier = Reader->GetIdentifier();
+				if (Identifier.Equals(NameColumn, ESearchCase::IgnoreCase))
+				{
+					Name = Value.TrimStartAndEnd();
+				}
+				else
+				{
+					const int32 Column = Importer.FindColumn(Identifier);
+					if (Column != INDEX_NONE)
+					{
+						Values[Column] = MoveTemp(Value);
+						RowCells[Column] = &Values[Column];
+					}
+				}
+				break;
+			}
+
+			default:
+				break;
+			}
+		}
+
+		if (!Reader->GetErrorMessage().IsEmpty())
+		{
+			OutError = Reader->GetErrorMessage();
+			return false;
+		}
+		return true;
+	}
+}
+
+int32 FSkillSheet::Export(const FString& Filename, FString& OutError)
+{
+	using namespace SkillSheet;
+
+	const TArray<FProperty*> Columns = GetColumns();
+	const TArray<FAssetData> SkillAssets = FindSkillAssets();
+
+	TArray<const USkillData*> Skills;
+	Skills.Reserve(SkillAssets.Num());
+	for (const FAssetData& AssetData : SkillAssets)
+	{
+		if (const USkillData* Skill = Cast<USkillData>(AssetData.GetAsset()))
+		{
+			Skills.Add(Skill);
+		}
+	}
+
+	FString Output;
+	if (IsJson(Filename))
+	{
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		Writer->WriteArrayStart();
+		for (const USkillData* Skill : Skills)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(NameColumn, Skill->GetName());
+			for (const FProperty* Property : Columns)
+			{
+				const void* Value = Property->ContainerPtrToValuePtr<void>(Skill);
+				const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+				if (NumericProperty && !NumericProperty->IsEnum())
+				{
+					if (NumericProperty->IsFloatingPoint())
+					{
+						Writer->WriteValue(Property->GetName(), NumericProperty->GetFloatingPointPropertyValue(Value));
+					}
+					else
+					{
+						Writer->WriteValue(Property->GetName(), NumericProperty->GetSignedIntPropertyValue(Value));
+					}
+				}
+				else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+				{
+					Writer->WriteValue(Property->GetName(), BoolProperty->GetPropertyValue(Value));
+				}
+				else
+				{
+					Writer->WriteValue(Property->GetName(), GetCell(Property, *Skill));
+				}
+			}
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->Close();
+	}
+	else
+	{
+		Output += NameColumn;
+		for (const FProperty* Property : Columns)
+		{
+			Output += TEXT(",");
+			Output += Property->GetName();
+		}
+		Output += LINE_TERMINATOR;
+
+		for (const USkillData* Skill : Skills)
+		{
+			AppendCsvCell(Output, Skill->GetName());
+			for (const FProperty* Property : Columns)
+			{
+				Output += TEXT(",");
+				AppendCsvCell(Output, GetCell(Property, *Skill));
+			}
+			Output += LINE_TERMINATOR;
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Output, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		OutError = FString::Printf(TEXT("Could not write %s"), *Filename);
+		return INDEX_NONE;
+	}
+	return Skills.Num();
+}
+
+bool FSkillSheet::Import(const FString& Filename, const FString& AssetPath, FSkillSheetImportStats& OutStats, FString& OutError)
+{
+	using namespace SkillSheet;
+
+	OutStats = FSkillSheetImportStats();
+
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Filename))
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *Filename);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FImporter Importer(AssetPath.IsEmpty() ? FString(DefaultAssetPath) : AssetPath, OutStats);
+	const bool bParsed = IsJson(Filename) ? ImportJson(Text, Importer, OutError) : ImportCsv(Text, Importer, OutError);
+
+	// Whatever was applied before a parse error is still saved, so the assets match their dirty state.
+	FString SaveError;
+	const bool bSaved = Importer.SavePackages(SaveError);
+	if (!bSaved && bParsed)
+	{
+		OutError = SaveError;
+	}
+
+	UE_LOG(LogSkillSheet, Display, TEXT("Import - %s: %d rows, %d created, %d updated, %d unchanged, %d errors in %.2f s"),
+		*Filename, OutStats.Rows, OutStats.Created, OutStats.Updated, OutStats.Unchanged, OutStats.Errors, FPlatformTime::Seconds() - StartTime);
+	return bParsed && bSaved;
+}
+
+/** Octopath.Skills.Export <File.csv|File.json> */
+static FAutoConsoleCommand GSkillSheetExportCommand(
+	TEXT("Octopath.Skills.Export"),
+	TEXT("Writes every USkillData asset to a CSV or JSON file. Usage: Octopath.Skills.Export <File.csv|File.json>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() < 1)
+			{
+				UE_LOG(LogSkillSheet, Warning, TEXT("Usage: Octopath.Skills.Export <File.csv|File.json>"));
+				return;
+			}
+			FString Error;
+			const int32 NumSkills = FSkillSheet::Export(Args[0], Error);
+			if (NumSkills == INDEX_NONE)
+			{
+				UE_LOG(LogSkillSheet, Error, TEXT("Export failed: %s"), *Error);
+				return;
+			}
+			UE_LOG(LogSkillSheet, Display, TEXT("Exported %d skills to %s"), NumSkills, *Args[0]);
+		}));
+
+/** Octopath.Skills.Import <File.csv|File.json> [AssetPath] */
+static FAutoConsoleCommand GSkillSheetImportCommand(
+	TEXT("Octopath.Skills.Import"),
+	TEXT("Creates or updates USkillData assets from a CSV or JSON file. Usage: Octopath.Skills.Import <File.csv|File.json> [/Game/Path]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() < 1)
+			{
+				UE_LOG(LogSkillSheet, Warning, TEXT("Usage: Octopath.Skills.Import <File.csv|File.json> [/Game/Path]"));
+				return;
+			}
+			FSkillSheetImportStats Stats;
+			FString Error;
+			if (!FSkillSheet::Import(Args[0], Args.Num() > 1 ? Args[1] : FString(), Stats, Error))
+			{
+				UE_LOG(LogSkillSheet, Error, TEXT("Import failed: %s"), *Error);
+			}
+		}));
@@ -0,0 +1,46 @@
+#include "SkillSheetCommandlet.h"
+#include "SkillSheet.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSkillSheetCommandlet, Log, All);
+
+USkillSheetCommandlet::USkillSheetCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USkillSheetCommandlet::Main(const FString& Params)
+{
+	FString Filename;
+	FString Error;
+	if (FParse::Value(*Params, TEXT("Export="), Filename))
+	{
+		const int32 NumSkills = FSkillSheet::Export(Filename, Error);
+		if (NumSkills == INDEX_NONE)
+		{
+			UE_LOG(LogSkillSheetCommandlet, Error, TEXT("Main - Export failed: %s"), *Error);
+			return 1;
+		}
+		UE_LOG(LogSkillSheetCommandlet, Display, TEXT("Main - Exported %d skills to %s"), NumSkills, *Filename);
+		return 0;
+	}
+
+	if (FParse::Value(*Params, TEXT("Import="), Filename))
+	{
+		FString AssetPath;
+		FParse::Value(*Params, TEXT("Path="), AssetPath);
+
+		FSkillSheetImportStats Stats;
+		if (!FSkillSheet::Import(Filename, AssetPath, Stats, Error))
+		{
+			UE_LOG(LogSkillSheetCommandlet, Error, TEXT("Main - Import failed: %s"), *Error);
+			return 1;
+		}
+		return Stats.Errors > 0 ? 1 : 0;
+	}
+
+	UE_LOG(LogSkillSheetCommandlet, Error, TEXT("Main - Usage: -run=SkillSheet -Import=<File> [-Path=/Game/...] | -Export=<File>"));
+	return 1;
+}
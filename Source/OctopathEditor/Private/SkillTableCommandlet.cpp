@@ -0,0 +1,79 @@
+#include "SkillTableCommandlet.h"
+#include "Manager/SkillData.h"
+#include "Combat/CookedSkillTable.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/FileHelper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSkillTableCommandlet, Log, All);
+
+USkillTableCommandlet::USkillTableCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 USkillTableCommandlet::Main(const FString& Params)
+{
+	FString OutputFilename = FCookedSkillTable::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Output="), OutputFilename);
+
+	// Find every skill asset, then load them (the table is built from the loaded properties).
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> SkillAssets;
+	AssetRegistry.GetAssetsByClass(USkillData::StaticClass()->GetClassPathName(), SkillAssets, true);
+
+	// Sorted by name so the output is byte-identical between runs.
+	SkillAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.AssetName.LexicalLess(B.AssetName); });
+
+	TArray<const USkillData*> Skills;
+	Skills.Reserve(SkillAssets.Num());
+	for (const FAssetData& AssetData : SkillAssets)
+	{
+		if (const USkillData* Skill = Cast<USkillData>(AssetData.GetAsset()))
+		{
+			Skills.Add(Skill);
+		}
+		else
+		{
+			UE_LOG(LogSkillTableCommandlet, Warning, TEXT("Main - Could not load %s"), *AssetData.GetObjectPathString());
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FString Error;
+	if (!FCookedSkillTable::Build(Skills, Bytes, Error))
+	{
+		UE_LOG(LogSkillTableCommandlet, Error, TEXT("Main - Could not build the skill table: %s"), *Error);
+		return 1;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *OutputFilename))
+	{
+		UE_LOG(LogSkillTableCommandlet, Error, TEXT("Main - Could not write %s"), *OutputFilename);
+		return 1;
+	}
+
+	// Read the file back and check that every skill is found at its id.
+	FCookedSkillTable Table;
+	if (!Table.LoadFromFile(OutputFilename))
+	{
+		UE_LOG(LogSkillTableCommandlet, Error, TEXT("Main - %s does not load back"), *OutputFilename);
+		return 1;
+	}
+	for (const USkillData* Skill : Skills)
+	{
+		const FCookedSkillRecord* Record = Table.Find(Skill->GetFName());
+		if (!Record || Table.GetString(Record->AssetName) != Skill->GetName())
+		{
+			UE_LOG(LogSkillTableCommandlet, Error, TEXT("Main - %s is missing from the table"), *Skill->GetName());
+			return 1;
+		}
+	}
+
+	UE_LOG(LogSkillTableCommandlet, Display, TEXT("Main - Packed %d skills into %s (%d bytes)"), Skills.Num(), *OutputFilename, Bytes.Num());
+	return 0;
+}
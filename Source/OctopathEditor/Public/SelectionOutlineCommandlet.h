@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SelectionOutlineCommandlet.generated.h"
+
+/**
+ * USelectionOutlineCommandlet
+ *
+ * Builds the post-process material outlining the selected combatants (see UTurnBasedCombatComponent::SelectionHighlightMaterial):
+ * pixels next to a custom depth stencil equal to the StencilValue parameter are drawn in OutlineColor, Thickness pixels wide.
+ * The shaders are compiled for the running shader platform first, and the asset is only saved when they compile.
+ * Run it once, then check in the asset:
+ *   UnrealEditor-Cmd Octopath.uproject -run=SelectionOutline
+ * The output is UTurnBasedCombatComponent::DefaultSelectionHighlightMaterialPath, which the combat component loads when
+ * no material is set on BP_CombatManager.
+ */
+UCLASS()
+class OCTOPATHEDITOR_API USelectionOutlineCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USelectionOutlineCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
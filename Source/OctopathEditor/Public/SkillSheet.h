@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkillData;
+
+/** Counters reported by an import */
+struct FSkillSheetImportStats
+{
+	int32 Rows = 0;
+	int32 Created = 0;
+	int32 Updated = 0;
+	int32 Unchanged = 0;
+	int32 Errors = 0;
+};
+
+/**
+ * FSkillSheet
+ *
+ * Bulk import and export of USkillData assets as CSV or JSON (picked from the file extension), so skills can be
+ * authored in spreadsheets. One row per skill: the "Name" column is the asset name, the other columns are the
+ * editable USkillData properties, written with their editor text (e.g. enums by name).
+ *
+ * Imports parse the file row by row and diff every cell against the existing asset: unchanged assets are neither
+ * dirtied nor saved, new rows create assets in the destination folder, and changed packages are saved in one batch.
+ */
+class OCTOPATHEDITOR_API FSkillSheet
+{
+public:
+	/** Folder receiving the assets created by an import when none is given */
+	static const TCHAR* DefaultAssetPath;
+
+	/**
+	 * Writes every USkillData asset of the project to a file.
+	 * @param Filename - Destination .csv or .json file.
+	 * @param OutError - Receives the reason of a failure.
+	 * @return The number of skills written, or INDEX_NONE on failure.
+	 */
+	static int32 Export(const FString& Filename, FString& OutError);
+
+	/**
+	 * Creates or updates USkillData assets from a file.
+	 * @param Filename - Source .csv or .json file.
+	 * @param AssetPath - Long package path receiving new assets (e.g. /Game/Blueprints/DA).
+	 * @param OutStats - Receives the row, creation and update counters.
+	 * @param OutError - Receives the reason of a failure.
+	 * @return False if the file could not be read or parsed (rows with bad values only count as errors).
+	 */
+	static bool Import(const FString& Filename, const FString& AssetPath, FSkillSheetImportStats& OutStats, FString& OutError);
+};
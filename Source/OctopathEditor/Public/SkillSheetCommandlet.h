@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkillSheetCommandlet.generated.h"
+
+/**
+ * USkillSheetCommandlet
+ *
+ * Command line front end of FSkillSheet (bulk CSV / JSON import and export of USkillData assets):
+ *   UnrealEditor-Cmd Octopath.uproject -run=SkillSheet -Import=<File.csv|File.json> [-Path=/Game/Blueprints/DA]
+ *   UnrealEditor-Cmd Octopath.uproject -run=SkillSheet -Export=<File.csv|File.json>
+ */
+UCLASS()
+class OCTOPATHEDITOR_API USkillSheetCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USkillSheetCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SkillTableCommandlet.generated.h"
+
+/**
+ * USkillTableCommandlet
+ *
+ * Packs every USkillData asset of the project into the cooked skill table (see FCookedSkillTable).
+ * Run it before cooking:
+ *   UnrealEditor-Cmd Octopath.uproject -run=SkillTable [-Output=<file>]
+ * The output defaults to Content/SkillTable/Skills.bin, staged as a loose file (DefaultGame.ini) so it can be mapped.
+ */
+UCLASS()
+class OCTOPATHEDITOR_API USkillTableCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USkillTableCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};